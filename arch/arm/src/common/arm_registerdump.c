@@ -51,6 +51,16 @@ uintptr_t up_getusrsp(void *regs)
   return ptr[REG_SP];
 }
 
+/****************************************************************************
+ * Name: up_getusrpc
+ ****************************************************************************/
+
+uintptr_t up_getusrpc(void *regs)
+{
+  uint32_t *ptr = regs;
+  return ptr[REG_PC];
+}
+
 /****************************************************************************
  * Name: up_dump_register
  ****************************************************************************/
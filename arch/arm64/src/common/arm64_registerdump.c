@@ -53,6 +53,16 @@ uintptr_t up_getusrsp(void *regs)
   return ptr->regs[REG_X13];
 }
 
+/****************************************************************************
+ * Name: up_getusrpc
+ ****************************************************************************/
+
+uintptr_t up_getusrpc(void *regs)
+{
+  struct regs_context *ptr = regs;
+  return ptr->elr;
+}
+
 /****************************************************************************
  * Name: up_dump_register
  ****************************************************************************/
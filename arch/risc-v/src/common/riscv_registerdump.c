@@ -47,6 +47,16 @@ uintptr_t up_getusrsp(void *regs)
   return ptr[REG_SP];
 }
 
+/****************************************************************************
+ * Name: up_getusrpc
+ ****************************************************************************/
+
+uintptr_t up_getusrpc(void *regs)
+{
+  uintptr_t *ptr = regs;
+  return ptr[REG_EPC];
+}
+
 /****************************************************************************
  * Name: up_dump_register
  ****************************************************************************/
@@ -0,0 +1,290 @@
+/****************************************************************************
+ * arch/sim/src/sim/posix/sim_hostpmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "sim_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The events in the order of enum pmu_event_e of include/nuttx/pmu.h,
+ * which cannot be included here.
+ */
+
+#define SIM_PMU_CYCLES    0
+#define SIM_PMU_NEVENTS   6
+
+#if defined(__x86_64__) || defined(__i386__)
+#  define SIM_PMU_X86
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Each simulated CPU is a host thread, so the events of the host thread
+ * are those of the CPU.  They are counted by a perf event group opened by
+ * the thread the first time it reads them.
+ */
+
+struct sim_pmu_s
+{
+  bool     opened;                /* The group was opened */
+  bool     tsc;                   /* Cycles are read from the TSC */
+  uint32_t events;                /* Events counted */
+#ifdef __linux__
+  int      leader;                /* File of the group leader, or -1 */
+  uint8_t  nr;                    /* Number of events in the group */
+  uint8_t  index[SIM_PMU_NEVENTS];
+
+  /* The pages of the events, used to read them with rdpmc */
+
+  struct perf_event_mmap_page *page[SIM_PMU_NEVENTS];
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef __linux__
+static const uint64_t g_sim_pmu_config[SIM_PMU_NEVENTS] =
+{
+  PERF_COUNT_HW_CPU_CYCLES,
+  PERF_COUNT_HW_INSTRUCTIONS,
+  PERF_COUNT_HW_CACHE_REFERENCES,
+  PERF_COUNT_HW_CACHE_MISSES,
+  PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+  PERF_COUNT_HW_BRANCH_MISSES
+};
+#endif
+
+static __thread struct sim_pmu_s g_sim_pmu;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_pmu_open
+ *
+ * Description:
+ *   Open the events of the calling host thread.  The events that the host
+ *   does not allow are left out, cycles are then taken from the TSC.
+ *
+ ****************************************************************************/
+
+static void sim_pmu_open(struct sim_pmu_s *pmu)
+{
+#ifdef __linux__
+  struct perf_event_attr attr;
+  void *page;
+  int fd;
+  int i;
+
+  pmu->leader = -1;
+
+  for (i = 0; i < SIM_PMU_NEVENTS; i++)
+    {
+      memset(&attr, 0, sizeof(attr));
+      attr.size           = sizeof(attr);
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.config         = g_sim_pmu_config[i];
+      attr.read_format    = PERF_FORMAT_GROUP;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+
+      fd = syscall(SYS_perf_event_open, &attr, 0, -1, pmu->leader, 0);
+      if (fd < 0)
+        {
+          continue;
+        }
+
+      if (pmu->leader < 0)
+        {
+          pmu->leader = fd;
+        }
+
+      page = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED,
+                  fd, 0);
+      if (page != MAP_FAILED)
+        {
+          pmu->page[i] = page;
+        }
+
+      pmu->index[i] = pmu->nr++;
+      pmu->events  |= 1 << i;
+    }
+#endif
+
+#ifdef SIM_PMU_X86
+  if ((pmu->events & (1 << SIM_PMU_CYCLES)) == 0)
+    {
+      pmu->events |= 1 << SIM_PMU_CYCLES;
+      pmu->tsc     = true;
+    }
+#endif
+
+  pmu->opened = true;
+}
+
+/****************************************************************************
+ * Name: sim_pmu_rdpmc
+ *
+ * Description:
+ *   Read an event without a system call, as described in
+ *   linux/perf_event.h.
+ *
+ ****************************************************************************/
+
+#if defined(__linux__) && defined(SIM_PMU_X86)
+static bool sim_pmu_rdpmc(struct perf_event_mmap_page *page,
+                          uint64_t *count)
+{
+  uint32_t seq;
+  uint32_t idx;
+  uint64_t value;
+  int64_t pmc;
+
+  do
+    {
+      seq = page->lock;
+      __sync_synchronize();
+
+      idx = page->index;
+      if (!page->cap_user_rdpmc || idx == 0)
+        {
+          return false;
+        }
+
+      pmc   = __builtin_ia32_rdpmc(idx - 1);
+      pmc <<= 64 - page->pmc_width;
+      pmc >>= 64 - page->pmc_width;
+      value = page->offset + pmc;
+
+      __sync_synchronize();
+    }
+  while (page->lock != seq);
+
+  *count = value;
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_pmu_events
+ ****************************************************************************/
+
+uint32_t up_pmu_events(void)
+{
+  struct sim_pmu_s *pmu = &g_sim_pmu;
+
+  if (!pmu->opened)
+    {
+      sim_pmu_open(pmu);
+    }
+
+  return pmu->events;
+}
+
+/****************************************************************************
+ * Name: up_pmu_read
+ ****************************************************************************/
+
+void up_pmu_read(uint64_t *counts)
+{
+  struct sim_pmu_s *pmu = &g_sim_pmu;
+#ifdef __linux__
+  uint64_t values[1 + SIM_PMU_NEVENTS];
+  bool group = false;
+  int i;
+#endif
+
+  if (!pmu->opened)
+    {
+      sim_pmu_open(pmu);
+    }
+
+  memset(counts, 0, SIM_PMU_NEVENTS * sizeof(uint64_t));
+
+#ifdef __linux__
+  for (i = 0; i < SIM_PMU_NEVENTS; i++)
+    {
+      if ((pmu->events & (1 << i)) == 0 || pmu->leader < 0 ||
+          (i == SIM_PMU_CYCLES && pmu->tsc))
+        {
+          continue;
+        }
+
+#  ifdef SIM_PMU_X86
+      if (pmu->page[i] != NULL && sim_pmu_rdpmc(pmu->page[i], &counts[i]))
+        {
+          continue;
+        }
+#  endif
+
+      /* Read the whole group once for the events rdpmc cannot read */
+
+      if (!group)
+        {
+          values[0] = 0;
+          if (read(pmu->leader, values, sizeof(values)) < 0)
+            {
+              values[0] = 0;
+            }
+
+          group = true;
+        }
+
+      if (pmu->index[i] < values[0])
+        {
+          counts[i] = values[1 + pmu->index[i]];
+        }
+    }
+#endif
+
+#ifdef SIM_PMU_X86
+  /* Reference cycles when the host does not count core cycles */
+
+  if (pmu->tsc)
+    {
+      counts[SIM_PMU_CYCLES] = __builtin_ia32_rdtsc();
+    }
+#endif
+}
@@ -42,6 +42,16 @@ uintptr_t up_getusrsp(void *regs)
   return ptr[JB_SP];
 }
 
+/****************************************************************************
+ * Name: up_getusrpc
+ ****************************************************************************/
+
+uintptr_t up_getusrpc(void *regs)
+{
+  xcpt_reg_t *ptr = regs;
+  return ptr[JB_PC];
+}
+
 /****************************************************************************
  * Name: up_dump_register
  ****************************************************************************/
@@ -0,0 +1,196 @@
+/****************************************************************************
+ * drivers/i2c/i2c_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/bus_async.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_ASYNC
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct i2c_async_s
+{
+  struct bus_async_s async;      /* The shared request queue */
+  FAR struct i2c_master_s *dev;  /* The bus the requests go to */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int i2c_async_transfer(FAR struct bus_async_s *async,
+                              FAR struct bus_async_req_s *req);
+static void i2c_async_complete(FAR struct bus_async_req_s *req, int result);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct bus_async_ops_s g_i2c_async_ops =
+{
+  i2c_async_transfer,  /* transfer */
+  i2c_async_complete,  /* complete */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_async_transfer
+ *
+ * Description:
+ *   Perform one request on the bus thread.
+ *
+ ****************************************************************************/
+
+static int i2c_async_transfer(FAR struct bus_async_s *async,
+                              FAR struct bus_async_req_s *req)
+{
+  FAR struct i2c_async_s *priv = (FAR struct i2c_async_s *)async;
+  FAR struct i2c_async_req_s *i2creq = (FAR struct i2c_async_req_s *)req;
+
+  return I2C_TRANSFER(priv->dev, i2creq->msgv, i2creq->msgc);
+}
+
+/****************************************************************************
+ * Name: i2c_async_complete
+ *
+ * Description:
+ *   Report the result of a request to its submitter.
+ *
+ ****************************************************************************/
+
+static void i2c_async_complete(FAR struct bus_async_req_s *req, int result)
+{
+  FAR struct i2c_async_req_s *i2creq = (FAR struct i2c_async_req_s *)req;
+
+  i2creq->callback(i2creq, result);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_async_initialize
+ *
+ * Description:
+ *   Create an asynchronous request queue for an I2C bus and start the
+ *   thread that serves it.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_async_s *i2c_async_initialize(FAR struct i2c_master_s *dev,
+                                             int bus)
+{
+  FAR struct i2c_async_s *priv;
+  char name[16];
+  int ret;
+
+  DEBUGASSERT(dev != NULL);
+
+  priv = kmm_zalloc(sizeof(struct i2c_async_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->dev = dev;
+
+  snprintf(name, sizeof(name), "i2c%d", bus);
+  ret = bus_async_initialize(&priv->async, &g_i2c_async_ops, name,
+                             CONFIG_I2C_ASYNC_PRIORITY,
+                             CONFIG_I2C_ASYNC_STACKSIZE);
+  if (ret < 0)
+    {
+      i2cerr("ERROR: Failed to start the bus thread: %d\n", ret);
+      kmm_free(priv);
+      return NULL;
+    }
+
+  return priv;
+}
+
+/****************************************************************************
+ * Name: i2c_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue and free it.  Requests that are
+ *   still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void i2c_async_uninitialize(FAR struct i2c_async_s *async)
+{
+  DEBUGASSERT(async != NULL);
+
+  bus_async_uninitialize(&async->async);
+  kmm_free(async);
+}
+
+/****************************************************************************
+ * Name: i2c_async_submit
+ *
+ * Description:
+ *   Queue a transfer in priority order.
+ *
+ ****************************************************************************/
+
+int i2c_async_submit(FAR struct i2c_async_s *async,
+                     FAR struct i2c_async_req_s *req)
+{
+  DEBUGASSERT(async != NULL && req != NULL && req->msgv != NULL &&
+              req->callback != NULL);
+
+  return bus_async_submit(&async->async, &req->base);
+}
+
+/****************************************************************************
+ * Name: i2c_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.
+ *
+ ****************************************************************************/
+
+int i2c_async_cancel(FAR struct i2c_async_s *async,
+                     FAR struct i2c_async_req_s *req)
+{
+  DEBUGASSERT(async != NULL && req != NULL);
+
+  return bus_async_cancel(&async->async, &req->base);
+}
+
+#endif /* CONFIG_I2C_ASYNC */
@@ -0,0 +1,217 @@
+/****************************************************************************
+ * drivers/i2c/i2c_loopback.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/signal.h>
+#include <nuttx/i2c/i2c_master.h>
+#include <nuttx/i2c/i2c_loopback.h>
+
+#ifdef CONFIG_I2C_LOOPBACK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_I2C_LOOPBACK_ADDR
+#  define CONFIG_I2C_LOOPBACK_ADDR 0x50
+#endif
+
+#ifndef CONFIG_I2C_LOOPBACK_LATENCY
+#  define CONFIG_I2C_LOOPBACK_LATENCY 0
+#endif
+
+/* Used when a message does not give a frequency */
+
+#define I2C_LOOPBACK_FREQUENCY 100000
+
+/* Each byte, including the address byte, takes 8 bits and an ACK */
+
+#define I2C_LOOPBACK_BITS(n)   ((n) * 9)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct i2c_loopback_dev_s
+{
+  struct i2c_master_s dev;  /* Generic I2C device */
+  mutex_t lock;             /* Only one transfer at a time */
+  uint8_t reg;              /* Current register of the target */
+  uint8_t regs[256];        /* Register file of the target */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int i2c_loopback_transfer(FAR struct i2c_master_s *dev,
+                                 FAR struct i2c_msg_s *msgs, int count);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct i2c_ops_s g_i2c_ops =
+{
+  i2c_loopback_transfer,    /* transfer */
+#ifdef CONFIG_I2C_RESET
+  NULL,                     /* reset */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_loopback_busy
+ *
+ * Description:
+ *   Spend the time a message would take on the bus.  Waits shorter than a
+ *   tick are busy waits, like polled transfers; longer ones sleep, like
+ *   transfers waiting for an interrupt.
+ *
+ ****************************************************************************/
+
+static void i2c_loopback_busy(FAR struct i2c_msg_s *msg, size_t nbits)
+{
+  uint32_t frequency = msg->frequency;
+  uint64_t usec;
+
+  if (frequency == 0)
+    {
+      frequency = I2C_LOOPBACK_FREQUENCY;
+    }
+
+  usec = (uint64_t)nbits * USEC_PER_SEC / frequency +
+         CONFIG_I2C_LOOPBACK_LATENCY;
+
+  if (usec >= USEC_PER_TICK)
+    {
+      nxsig_usleep(usec);
+    }
+  else if (usec > 0)
+    {
+      up_udelay(usec);
+    }
+}
+
+/****************************************************************************
+ * Name: i2c_loopback_transfer
+ *
+ * Description:
+ *   Perform a sequence of messages against the simulated target.  Messages
+ *   to any other address are not acknowledged.
+ *
+ ****************************************************************************/
+
+static int i2c_loopback_transfer(FAR struct i2c_master_s *dev,
+                                 FAR struct i2c_msg_s *msgs, int count)
+{
+  FAR struct i2c_loopback_dev_s *priv =
+    (FAR struct i2c_loopback_dev_s *)dev;
+  FAR struct i2c_msg_s *msg;
+  bool start;
+  ssize_t i;
+  int ret;
+
+  ret = nxmutex_lock(&priv->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (msg = msgs; msg < msgs + count; msg++)
+    {
+      start = (msg->flags & I2C_M_NOSTART) == 0;
+
+      if (start && msg->addr != CONFIG_I2C_LOOPBACK_ADDR)
+        {
+          i2c_loopback_busy(msg, I2C_LOOPBACK_BITS(1));
+          ret = -ENXIO;
+          break;
+        }
+
+      for (i = 0; i < msg->length; i++)
+        {
+          if ((msg->flags & I2C_M_READ) != 0)
+            {
+              msg->buffer[i] = priv->regs[priv->reg++];
+            }
+          else if (start && i == 0)
+            {
+              /* The first byte written after a START is the register */
+
+              priv->reg = msg->buffer[0];
+            }
+          else
+            {
+              priv->regs[priv->reg++] = msg->buffer[i];
+            }
+        }
+
+      i2c_loopback_busy(msg, I2C_LOOPBACK_BITS(msg->length + start));
+    }
+
+  nxmutex_unlock(&priv->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  i2c_loopback_initialize
+ *
+ * Description:
+ *   Create an instance of the simulated loopback I2C bus.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_master_s *i2c_loopback_initialize(void)
+{
+  FAR struct i2c_loopback_dev_s *priv;
+
+  priv = kmm_zalloc(sizeof(struct i2c_loopback_dev_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->dev.ops = &g_i2c_ops;
+  nxmutex_init(&priv->lock);
+
+  return &priv->dev;
+}
+
+#endif /* CONFIG_I2C_LOOPBACK */
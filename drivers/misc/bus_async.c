@@ -0,0 +1,272 @@
+/****************************************************************************
+ * drivers/misc/bus_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/bus_async.h>
+#include <nuttx/kthread.h>
+#include <nuttx/queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_BUS_ASYNC
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bus_async_thread
+ *
+ * Description:
+ *   Perform the queued requests one at a time.
+ *
+ ****************************************************************************/
+
+static int bus_async_thread(int argc, FAR char *argv[])
+{
+  FAR struct bus_async_s *async =
+    (FAR struct bus_async_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
+  FAR struct bus_async_req_s *req;
+  irqstate_t flags;
+  int ret;
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&async->sem);
+
+      flags = spin_lock_irqsave(&async->lock);
+
+      if (async->exiting)
+        {
+          spin_unlock_irqrestore(&async->lock, flags);
+          break;
+        }
+
+      /* The semaphore count may be ahead of the queue after a cancel */
+
+      req = (FAR struct bus_async_req_s *)sq_remfirst(&async->queue);
+      async->active = req;
+
+      spin_unlock_irqrestore(&async->lock, flags);
+
+      if (req != NULL)
+        {
+          ret = async->ops->transfer(async, req);
+
+          flags = spin_lock_irqsave(&async->lock);
+          async->active = NULL;
+          spin_unlock_irqrestore(&async->lock, flags);
+
+          async->ops->complete(req, ret);
+        }
+    }
+
+  nxsem_post(&async->exitsem);
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bus_async_initialize
+ *
+ * Description:
+ *   Initialize a request queue and start the thread that serves it.
+ *
+ ****************************************************************************/
+
+int bus_async_initialize(FAR struct bus_async_s *async,
+                         FAR const struct bus_async_ops_s *ops,
+                         FAR const char *name, int priority,
+                         int stacksize)
+{
+  FAR char *argv[2];
+  char arg1[32];
+  int ret;
+
+  DEBUGASSERT(async != NULL && ops != NULL && ops->transfer != NULL &&
+              ops->complete != NULL);
+
+  async->ops     = ops;
+  async->active  = NULL;
+  async->exiting = false;
+  sq_init(&async->queue);
+  spin_lock_init(&async->lock);
+  nxsem_init(&async->sem, 0, 0);
+  nxsem_init(&async->exitsem, 0, 0);
+
+  snprintf(arg1, sizeof(arg1), "%p", async);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create(name, priority, stacksize, bus_async_thread, argv);
+  if (ret < 0)
+    {
+      nxsem_destroy(&async->sem);
+      nxsem_destroy(&async->exitsem);
+      return ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bus_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue, after the request in progress is
+ *   done.  Requests that are still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void bus_async_uninitialize(FAR struct bus_async_s *async)
+{
+  FAR struct bus_async_req_s *req;
+  sq_queue_t pending;
+  irqstate_t flags;
+
+  DEBUGASSERT(async != NULL);
+
+  flags = spin_lock_irqsave(&async->lock);
+  async->exiting = true;
+  sq_move(&async->queue, &pending);
+  spin_unlock_irqrestore(&async->lock, flags);
+
+  /* Let a request in progress finish and wait for the thread to end */
+
+  nxsem_post(&async->sem);
+  nxsem_wait_uninterruptible(&async->exitsem);
+
+  while ((req = (FAR struct bus_async_req_s *)sq_remfirst(&pending))
+         != NULL)
+    {
+      async->ops->complete(req, -ECANCELED);
+    }
+
+  nxsem_destroy(&async->sem);
+  nxsem_destroy(&async->exitsem);
+}
+
+/****************************************************************************
+ * Name: bus_async_submit
+ *
+ * Description:
+ *   Queue a request in priority order.
+ *
+ ****************************************************************************/
+
+int bus_async_submit(FAR struct bus_async_s *async,
+                     FAR struct bus_async_req_s *req)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+
+  DEBUGASSERT(async != NULL && req != NULL);
+
+  flags = spin_lock_irqsave(&async->lock);
+
+  if (async->exiting)
+    {
+      spin_unlock_irqrestore(&async->lock, flags);
+      return -ESHUTDOWN;
+    }
+
+  /* Go behind every request of the same or a higher priority */
+
+  for (entry = sq_peek(&async->queue); entry != NULL; entry = sq_next(entry))
+    {
+      if (((FAR struct bus_async_req_s *)entry)->priority < req->priority)
+        {
+          break;
+        }
+
+      prev = entry;
+    }
+
+  if (prev == NULL)
+    {
+      sq_addfirst(&req->node, &async->queue);
+    }
+  else
+    {
+      sq_addafter(prev, &req->node, &async->queue);
+    }
+
+  spin_unlock_irqrestore(&async->lock, flags);
+
+  nxsem_post(&async->sem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bus_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.
+ *
+ ****************************************************************************/
+
+int bus_async_cancel(FAR struct bus_async_s *async,
+                     FAR struct bus_async_req_s *req)
+{
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(async != NULL && req != NULL);
+
+  flags = spin_lock_irqsave(&async->lock);
+
+  if (async->active == req)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      for (entry = sq_peek(&async->queue); entry != NULL;
+           entry = sq_next(entry))
+        {
+          if (entry == &req->node)
+            {
+              sq_rem(entry, &async->queue);
+              ret = OK;
+              break;
+            }
+        }
+    }
+
+  spin_unlock_irqrestore(&async->lock, flags);
+  return ret;
+}
+
+#endif /* CONFIG_BUS_ASYNC */
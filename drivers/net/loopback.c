@@ -93,6 +93,9 @@ static int lo_ifup(FAR struct net_driver_s *dev);
 static int lo_ifdown(FAR struct net_driver_s *dev);
 static void lo_txavail_work(FAR void *arg);
 static int lo_txavail(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_BUSY_POLL
+static int lo_busypoll(FAR struct net_driver_s *dev);
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
 static int lo_addmac(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
 static int lo_rmmac(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
@@ -243,6 +246,42 @@ static int lo_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: lo_busypoll
+ *
+ * Description:
+ *   Loop back the pending TX data in the context of a SO_BUSY_POLL reader
+ *   instead of waiting for the work queue.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   The number of packets looped back.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+static int lo_busypoll(FAR struct net_driver_s *dev)
+{
+  FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
+  int npackets = 0;
+
+  if (priv->lo_bifup)
+    {
+      while (devif_poll(&priv->lo_dev, NULL))
+        {
+          npackets++;
+        }
+    }
+
+  return npackets;
+}
+#endif
+
 /****************************************************************************
  * Name: lo_addmac
  *
@@ -329,6 +368,9 @@ int localhost_initialize(void)
   priv->lo_dev.d_ifup    = lo_ifup;      /* I/F up (new IP address) callback */
   priv->lo_dev.d_ifdown  = lo_ifdown;    /* I/F down callback */
   priv->lo_dev.d_txavail = lo_txavail;   /* New TX data callback */
+#ifdef CONFIG_NET_BUSY_POLL
+  priv->lo_dev.d_busypoll = lo_busypoll; /* Busy poll callback */
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
   priv->lo_dev.d_addmac  = lo_addmac;    /* Add multicast MAC address */
   priv->lo_dev.d_rmmac   = lo_rmmac;     /* Remove multicast MAC address */
@@ -406,22 +406,27 @@ static void eth_input(FAR struct net_driver_s *dev)
  * Input Parameters:
  *   upper - Reference to the upper half driver structure
  *
+ * Returned Value:
+ *   The number of packets received.
+ *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static int netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
 {
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
   FAR netpkt_t                  *pkt;
+  int                            npackets = 0;
 
   /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
   while ((pkt = lower->ops->receive(lower)) != NULL)
     {
       NETDEV_RXPACKETS(dev);
+      npackets++;
 
       if (!IFF_IS_UP(dev->d_flags))
         {
@@ -467,6 +472,8 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           break;
         }
     }
+
+  return npackets;
 }
 
 /****************************************************************************
@@ -565,6 +572,40 @@ static int netdev_upper_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_busypoll
+ *
+ * Description:
+ *   Run the RX and TX work in the context of a SO_BUSY_POLL reader instead
+ *   of waiting for the work queue or the dedicated thread.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   The number of packets received.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+static int netdev_upper_busypoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  int npackets;
+
+  /* RX may release quota and driver buffer, so do RX first.  The TX pass
+   * sends any ACK or reply that the received packets triggered.
+   */
+
+  npackets = netdev_upper_rxpoll_work(upper);
+  netdev_upper_txavail_work(upper);
+  return npackets;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wireless_ioctl
  *
@@ -975,6 +1016,9 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
 #ifdef CONFIG_NETDEV_IOCTL
   dev->netdev.d_ioctl   = netdev_upper_ioctl;
+#endif
+#ifdef CONFIG_NET_BUSY_POLL
+  dev->netdev.d_busypoll = netdev_upper_busypoll;
 #endif
   dev->netdev.d_private = upper;
 
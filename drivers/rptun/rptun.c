@@ -32,6 +32,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
 #include <nuttx/mutex.h>
@@ -54,6 +55,10 @@
 
 #define RPTUNIOC_NONE               0
 
+#ifdef CONFIG_RPTUN_KICK_COALESCE
+#  define RPTUN_KICK_DELAY          MAX(USEC2TICK(CONFIG_RPTUN_KICK_DELAY), 1)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -80,6 +85,12 @@ struct rptun_priv_s
 #ifdef CONFIG_RPTUN_PING
   struct rpmsg_endpoint        ping;
 #endif
+#ifdef CONFIG_RPTUN_KICK_COALESCE
+  struct work_s                kickwork;  /* Flushes the deferred kicks */
+  uint32_t                     kickid[2]; /* Notify ids with deferred kicks */
+  uint8_t                      nkickid;
+  uint16_t                     nkick;     /* Kicks deferred since flush */
+#endif
 };
 
 struct rptun_bind_s
@@ -232,11 +243,111 @@ static void rptun_start_worker(FAR void *arg)
     }
 }
 
+#ifdef CONFIG_RPTUN_KICK_COALESCE
+static void rptun_kick_flush(FAR struct rptun_priv_s *priv)
+{
+  uint32_t kickid[nitems(priv->kickid)];
+  irqstate_t flags;
+  int nkickid;
+  int i;
+
+  flags = enter_critical_section();
+
+  nkickid = priv->nkickid;
+  for (i = 0; i < nkickid; i++)
+    {
+      kickid[i] = priv->kickid[i];
+    }
+
+  priv->nkickid = 0;
+  priv->nkick   = 0;
+
+  leave_critical_section(flags);
+
+  for (i = 0; i < nkickid; i++)
+    {
+      RPTUN_NOTIFY(priv->dev, kickid[i]);
+    }
+}
+
+static void rptun_kick_worker(FAR void *arg)
+{
+  rptun_kick_flush(arg);
+}
+
+static bool rptun_kick_defer(FAR struct rptun_priv_s *priv, uint32_t id)
+{
+  irqstate_t flags;
+  bool flush;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < priv->nkickid; i++)
+    {
+      if (priv->kickid[i] == id)
+        {
+          break;
+        }
+    }
+
+  if (i == priv->nkickid)
+    {
+      if (i == nitems(priv->kickid))
+        {
+          /* No room to remember another id, kick it right away */
+
+          leave_critical_section(flags);
+          return false;
+        }
+
+      priv->kickid[priv->nkickid++] = id;
+    }
+
+  flush = ++priv->nkick >= CONFIG_RPTUN_KICK_THRESHOLD;
+
+  leave_critical_section(flags);
+
+  if (flush)
+    {
+      rptun_kick_flush(priv);
+    }
+  else if (work_available(&priv->kickwork))
+    {
+      /* Bound the latency of the first deferred kick */
+
+      work_queue(HPWORK, &priv->kickwork, rptun_kick_worker, priv,
+                 RPTUN_KICK_DELAY);
+    }
+
+  return true;
+}
+
+static void rptun_kick_cancel(FAR struct rptun_priv_s *priv)
+{
+  irqstate_t flags;
+
+  work_cancel(HPWORK, &priv->kickwork);
+
+  flags = enter_critical_section();
+  priv->nkickid = 0;
+  priv->nkick   = 0;
+  leave_critical_section(flags);
+}
+#else
+#  define rptun_kick_flush(priv)
+#  define rptun_kick_cancel(priv)
+#endif
+
 static void rptun_worker(FAR void *arg)
 {
   FAR struct rptun_priv_s *priv = arg;
 
   remoteproc_get_notification(&priv->rproc, RPTUN_NOTIFY_ALL);
+
+  /* Send the kicks of the whole batch (returned RX buffers, replies) */
+
+  rptun_kick_flush(priv);
 }
 
 #ifdef CONFIG_RPTUN_WORKQUEUE
@@ -397,6 +508,13 @@ static int rptun_notify(FAR struct remoteproc *rproc, uint32_t id)
       rptun_pm_action(priv, true);
     }
 
+#ifdef CONFIG_RPTUN_KICK_COALESCE
+  if (rptun_kick_defer(priv, id))
+    {
+      return 0;
+    }
+#endif
+
   RPTUN_NOTIFY(priv->dev, id);
   return 0;
 }
@@ -449,6 +567,10 @@ static int rptun_notify_wait(FAR struct remoteproc *rproc, uint32_t id)
       return -EAGAIN;
     }
 
+  /* The peer can't free buffers for messages it hasn't been told of */
+
+  rptun_kick_flush(priv);
+
   /* Wait to wakeup */
 
   nxsem_wait(&priv->semtx);
@@ -779,6 +901,10 @@ static int rptun_dev_stop(FAR struct remoteproc *rproc, bool stop_ns)
 
   RPTUN_UNREGISTER_CALLBACK(priv->dev);
 
+  /* Forget the kicks still deferred */
+
+  rptun_kick_cancel(priv);
+
   /* Remove priv from list */
 
   nxrmutex_lock(&g_rptun_lockcb);
@@ -1014,6 +1140,13 @@ int rpmsg_wait(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem)
     }
 
   priv = rptun_get_priv_by_rdev(ept->rdev);
+  if (priv)
+    {
+      /* Whatever we wait for, the peer must see our messages first */
+
+      rptun_kick_flush(priv);
+    }
+
   if (!priv || !rptun_is_recursive(priv))
     {
       return nxsem_wait_uninterruptible(sem);
@@ -1057,6 +1190,26 @@ int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem)
   return ret;
 }
 
+int rpmsg_flush(FAR struct rpmsg_endpoint *ept)
+{
+#ifdef CONFIG_RPTUN_KICK_COALESCE
+  FAR struct rptun_priv_s *priv;
+
+  if (!ept)
+    {
+      return -EINVAL;
+    }
+
+  priv = rptun_get_priv_by_rdev(ept->rdev);
+  if (priv)
+    {
+      rptun_kick_flush(priv);
+    }
+#endif
+
+  return 0;
+}
+
 FAR const char *rpmsg_get_cpuname(FAR struct rpmsg_device *rdev)
 {
   FAR struct rptun_priv_s *priv = rptun_get_priv_by_rdev(rdev);
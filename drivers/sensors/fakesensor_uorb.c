@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <fcntl.h>
 #include <math.h>
 #include <stdio.h>
@@ -56,6 +57,9 @@ struct fakesensor_s
   struct file data;
   unsigned long interval;
   unsigned long batch;
+  size_t esize;
+  FAR uint8_t *events;
+  unsigned long maxevents;
   int raw_start;
   FAR const char *file_path;
   sem_t wakeup;
@@ -80,7 +84,7 @@ static int fakegps_set_interval(FAR struct gps_lowerhalf_s *lower,
                                 FAR struct file *filep,
                                 FAR unsigned long *period_us);
 static void fakesensor_push_event(FAR struct fakesensor_s *sensor,
-                                  uint64_t event_timestamp);
+                                  unsigned long nevents);
 static int fakesensor_thread(int argc, char** argv);
 
 /****************************************************************************
@@ -153,45 +157,33 @@ static int fakesensor_read_csv_header(FAR struct fakesensor_s *sensor)
 }
 
 static inline void fakesensor_read_accel(FAR struct fakesensor_s *sensor,
-                                         uint64_t event_timestamp)
+                                         FAR struct sensor_accel *accel)
 {
-  struct sensor_accel accel;
   char raw[50];
   fakesensor_read_csv_line(
           &sensor->data, raw, sizeof(raw), sensor->raw_start);
-  sscanf(raw, "%f,%f,%f\n", &accel.x, &accel.y, &accel.z);
-  accel.temperature = NAN;
-  accel.timestamp = event_timestamp;
-  sensor->lower.push_event(sensor->lower.priv, &accel,
-                    sizeof(struct sensor_accel));
+  sscanf(raw, "%f,%f,%f\n", &accel->x, &accel->y, &accel->z);
+  accel->temperature = NAN;
 }
 
 static inline void fakesensor_read_mag(FAR struct fakesensor_s *sensor,
-                                       uint64_t event_timestamp)
+                                       FAR struct sensor_mag *mag)
 {
-  struct sensor_mag mag;
   char raw[50];
   fakesensor_read_csv_line(
           &sensor->data, raw, sizeof(raw), sensor->raw_start);
-  sscanf(raw, "%f,%f,%f\n", &mag.x, &mag.y, &mag.z);
-  mag.temperature = NAN;
-  mag.timestamp = event_timestamp;
-  sensor->lower.push_event(sensor->lower.priv, &mag,
-                           sizeof(struct sensor_mag));
+  sscanf(raw, "%f,%f,%f\n", &mag->x, &mag->y, &mag->z);
+  mag->temperature = NAN;
 }
 
 static inline void fakesensor_read_gyro(FAR struct fakesensor_s *sensor,
-                                        uint64_t event_timestamp)
+                                        FAR struct sensor_gyro *gyro)
 {
-  struct sensor_gyro gyro;
   char raw[50];
   fakesensor_read_csv_line(
           &sensor->data, raw, sizeof(raw), sensor->raw_start);
-  sscanf(raw, "%f,%f,%f\n", &gyro.x, &gyro.y, &gyro.z);
-  gyro.temperature = NAN;
-  gyro.timestamp = event_timestamp;
-  sensor->lower.push_event(sensor->lower.priv, &gyro,
-                    sizeof(struct sensor_gyro));
+  sscanf(raw, "%f,%f,%f\n", &gyro->x, &gyro->y, &gyro->z);
+  gyro->temperature = NAN;
 }
 
 static inline void fakesensor_read_gps(FAR struct fakesensor_s *sensor)
@@ -261,46 +253,57 @@ static int fakesensor_batch(FAR struct sensor_lowerhalf_s *lower,
 {
   FAR struct fakesensor_s *sensor = container_of(lower,
                                                  struct fakesensor_s, lower);
-  unsigned long max_latency = sensor->lower.nbuffer * sensor->interval;
-  if (*latency_us > max_latency)
-    {
-      *latency_us = max_latency;
-    }
-  else if (*latency_us < sensor->interval && *latency_us > 0)
-    {
-      *latency_us = sensor->interval;
-    }
 
+  sensor_batch_watermark(sensor->interval, latency_us,
+                         sensor->lower.nbuffer);
   sensor->batch = *latency_us;
   return OK;
 }
 
 void fakesensor_push_event(FAR struct fakesensor_s *sensor,
-                           uint64_t event_timestamp)
+                           unsigned long nevents)
 {
-  switch (sensor->type)
-  {
-    case SENSOR_TYPE_ACCELEROMETER:
-      fakesensor_read_accel(sensor, event_timestamp);
-      break;
-
-    case SENSOR_TYPE_MAGNETIC_FIELD:
-      fakesensor_read_mag(sensor, event_timestamp);
-      break;
-
-    case SENSOR_TYPE_GYROSCOPE:
-      fakesensor_read_gyro(sensor, event_timestamp);
-      break;
-
-    case SENSOR_TYPE_GPS:
-    case SENSOR_TYPE_GPS_SATELLITE:
+  FAR uint8_t *event = sensor->events;
+  uint64_t now = sensor_get_timestamp();
+  unsigned long i;
+
+  if (sensor->type == SENSOR_TYPE_GPS ||
+      sensor->type == SENSOR_TYPE_GPS_SATELLITE)
+    {
       fakesensor_read_gps(sensor);
-      break;
+      return;
+    }
+
+  /* Read the whole batch, like a FIFO read at the watermark interrupt.
+   * nbuffer may have grown past the events allocated at registration.
+   */
 
-    default:
-      snerr("fakesensor: unsupported type sensor type\n");
-      break;
-  }
+  nevents = MIN(nevents, sensor->maxevents);
+
+  for (i = 0; i < nevents; i++, event += sensor->esize)
+    {
+      switch (sensor->type)
+      {
+        case SENSOR_TYPE_ACCELEROMETER:
+          fakesensor_read_accel(sensor, (FAR struct sensor_accel *)event);
+          break;
+
+        case SENSOR_TYPE_MAGNETIC_FIELD:
+          fakesensor_read_mag(sensor, (FAR struct sensor_mag *)event);
+          break;
+
+        case SENSOR_TYPE_GYROSCOPE:
+          fakesensor_read_gyro(sensor, (FAR struct sensor_gyro *)event);
+          break;
+
+        default:
+          snerr("fakesensor: unsupported type sensor type\n");
+          return;
+      }
+    }
+
+  sensor_push_batch(&sensor->lower, sensor->events, sensor->esize, nevents,
+                    now - (nevents - 1) * sensor->interval, now);
 }
 
 static int fakesensor_thread(int argc, char** argv)
@@ -335,23 +338,9 @@ static int fakesensor_thread(int argc, char** argv)
 
           /* Notify upper */
 
-          if (sensor->batch)
-            {
-              uint32_t batch_num = sensor->batch / sensor->interval;
-              uint64_t event_timestamp =
-                  sensor_get_timestamp() - sensor->interval * batch_num;
-              int i;
-
-              for (i = 0; i < batch_num; i++)
-                {
-                  fakesensor_push_event(sensor, event_timestamp);
-                  event_timestamp += sensor->interval;
-                }
-            }
-          else
-            {
-              fakesensor_push_event(sensor, sensor_get_timestamp());
-            }
+          fakesensor_push_event(sensor, sensor->batch ?
+                                MIN(sensor->batch / sensor->interval,
+                                    MAX(sensor->lower.nbuffer, 1)) : 1);
         }
 
       /* Close csv file handle when running change true to false */
@@ -412,6 +401,34 @@ int fakesensor_init(int type, FAR const char *file_name,
   sensor->file_path = file_name;
   sensor->type = type;
 
+  /* Alloc the buffer a batch is read into */
+
+  if (type != SENSOR_TYPE_GPS && type != SENSOR_TYPE_GPS_SATELLITE)
+    {
+      switch (type)
+        {
+          case SENSOR_TYPE_ACCELEROMETER:
+            sensor->esize = sizeof(struct sensor_accel);
+            break;
+
+          case SENSOR_TYPE_MAGNETIC_FIELD:
+            sensor->esize = sizeof(struct sensor_mag);
+            break;
+
+          default:
+            sensor->esize = sizeof(struct sensor_gyro);
+            break;
+        }
+
+      sensor->maxevents = MAX(batch_number, 1);
+      sensor->events = kmm_malloc(sensor->esize * sensor->maxevents);
+      if (sensor->events == NULL)
+        {
+          kmm_free(sensor);
+          return -ENOMEM;
+        }
+    }
+
   nxsem_init(&sensor->wakeup, 0, 0);
 
   /* Create thread for sensor */
@@ -424,6 +441,7 @@ int fakesensor_init(int type, FAR const char *file_name,
                        fakesensor_thread, argv);
   if (ret < 0)
     {
+      kmm_free(sensor->events);
       kmm_free(sensor);
       return ERROR;
     }
@@ -1063,6 +1063,110 @@ void sensor_remap_vector_raw16(FAR const int16_t *in, FAR int16_t *out,
   memcpy(out, tmp, sizeof(tmp));
 }
 
+/****************************************************************************
+ * Name: sensor_push_batch
+ *
+ * Description:
+ *   Push a batch of events read from a hardware FIFO in one call, spreading
+ *   their timestamps evenly between first and last.
+ *
+ * Input Parameters:
+ *   lower   - The lower half sensor driver pushing the events.
+ *   data    - The events, oldest first.  Their timestamps are rewritten.
+ *   esize   - The size of one event.
+ *   nevents - The number of events in data.
+ *   first   - The timestamp of the oldest event, in us.
+ *   last    - The timestamp of the newest event, in us.
+ *
+ * Returned Value:
+ *   The bytes of push is returned when success;
+ *   A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t sensor_push_batch(FAR struct sensor_lowerhalf_s *lower,
+                          FAR void *data, size_t esize,
+                          unsigned long nevents,
+                          uint64_t first, uint64_t last)
+{
+  FAR uint8_t *event = data;
+  uint64_t timestamp;
+  uint64_t span;
+  unsigned long i;
+
+  DEBUGASSERT(lower != NULL && lower->push_event != NULL &&
+              data != NULL && esize >= sizeof(uint64_t));
+
+  if (nevents == 0)
+    {
+      return 0;
+    }
+
+  if (last < first)
+    {
+      return -EINVAL;
+    }
+
+  span = last - first;
+  for (i = 0; i < nevents; i++, event += esize)
+    {
+      timestamp = nevents > 1 ? first + span * i / (nevents - 1) : last;
+
+      /* The events may not be aligned for a 64-bit store */
+
+      memcpy(event, &timestamp, sizeof(timestamp));
+    }
+
+  return lower->push_event(lower->priv, data, nevents * esize);
+}
+
+/****************************************************************************
+ * Name: sensor_batch_watermark
+ *
+ * Description:
+ *   Convert the latency requested through SNIOC_BATCH into a FIFO
+ *   watermark.
+ *
+ * Input Parameters:
+ *   interval   - The sampling interval, in us.
+ *   latency_us - The requested latency, in us.  Updated with the latency
+ *                that will be used; 0 disables batching.
+ *   fifo_size  - The number of samples the hardware FIFO holds.
+ *
+ * Returned Value:
+ *   The number of samples to collect before interrupting, at least one.
+ *
+ ****************************************************************************/
+
+unsigned long sensor_batch_watermark(unsigned long interval,
+                                     FAR unsigned long *latency_us,
+                                     unsigned long fifo_size)
+{
+  unsigned long watermark;
+
+  DEBUGASSERT(latency_us != NULL);
+
+  if (*latency_us == 0 || interval == 0 || interval == ULONG_MAX ||
+      fifo_size <= 1)
+    {
+      *latency_us = 0;
+      return 1;
+    }
+
+  watermark = *latency_us / interval;
+  if (watermark < 1)
+    {
+      watermark = 1;
+    }
+  else if (watermark > fifo_size)
+    {
+      watermark = fifo_size;
+    }
+
+  *latency_us = watermark * interval;
+  return watermark;
+}
+
 /****************************************************************************
  * Name: sensor_register
  *
@@ -0,0 +1,197 @@
+/****************************************************************************
+ * drivers/spi/spi_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/bus_async.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/spi/spi.h>
+#include <nuttx/spi/spi_transfer.h>
+
+#ifdef CONFIG_SPI_ASYNC
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct spi_async_s
+{
+  struct bus_async_s async;      /* The shared request queue */
+  FAR struct spi_dev_s *spi;     /* The bus the requests go to */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int spi_async_transfer(FAR struct bus_async_s *async,
+                              FAR struct bus_async_req_s *req);
+static void spi_async_complete(FAR struct bus_async_req_s *req, int result);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct bus_async_ops_s g_spi_async_ops =
+{
+  spi_async_transfer,  /* transfer */
+  spi_async_complete,  /* complete */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_async_transfer
+ *
+ * Description:
+ *   Perform one request on the bus thread.
+ *
+ ****************************************************************************/
+
+static int spi_async_transfer(FAR struct bus_async_s *async,
+                              FAR struct bus_async_req_s *req)
+{
+  FAR struct spi_async_s *priv = (FAR struct spi_async_s *)async;
+  FAR struct spi_async_req_s *spireq = (FAR struct spi_async_req_s *)req;
+
+  return spi_transfer(priv->spi, spireq->seq);
+}
+
+/****************************************************************************
+ * Name: spi_async_complete
+ *
+ * Description:
+ *   Report the result of a request to its submitter.
+ *
+ ****************************************************************************/
+
+static void spi_async_complete(FAR struct bus_async_req_s *req, int result)
+{
+  FAR struct spi_async_req_s *spireq = (FAR struct spi_async_req_s *)req;
+
+  spireq->callback(spireq, result);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_async_initialize
+ *
+ * Description:
+ *   Create an asynchronous request queue for an SPI bus and start the
+ *   thread that serves it.
+ *
+ ****************************************************************************/
+
+FAR struct spi_async_s *spi_async_initialize(FAR struct spi_dev_s *spi,
+                                             int bus)
+{
+  FAR struct spi_async_s *priv;
+  char name[16];
+  int ret;
+
+  DEBUGASSERT(spi != NULL);
+
+  priv = kmm_zalloc(sizeof(struct spi_async_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->spi = spi;
+
+  snprintf(name, sizeof(name), "spi%d", bus);
+  ret = bus_async_initialize(&priv->async, &g_spi_async_ops, name,
+                             CONFIG_SPI_ASYNC_PRIORITY,
+                             CONFIG_SPI_ASYNC_STACKSIZE);
+  if (ret < 0)
+    {
+      spierr("ERROR: Failed to start the bus thread: %d\n", ret);
+      kmm_free(priv);
+      return NULL;
+    }
+
+  return priv;
+}
+
+/****************************************************************************
+ * Name: spi_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue and free it.  Requests that are
+ *   still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void spi_async_uninitialize(FAR struct spi_async_s *async)
+{
+  DEBUGASSERT(async != NULL);
+
+  bus_async_uninitialize(&async->async);
+  kmm_free(async);
+}
+
+/****************************************************************************
+ * Name: spi_async_submit
+ *
+ * Description:
+ *   Queue a sequence of transfers in priority order.
+ *
+ ****************************************************************************/
+
+int spi_async_submit(FAR struct spi_async_s *async,
+                     FAR struct spi_async_req_s *req)
+{
+  DEBUGASSERT(async != NULL && req != NULL && req->seq != NULL &&
+              req->callback != NULL);
+
+  return bus_async_submit(&async->async, &req->base);
+}
+
+/****************************************************************************
+ * Name: spi_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.
+ *
+ ****************************************************************************/
+
+int spi_async_cancel(FAR struct spi_async_s *async,
+                     FAR struct spi_async_req_s *req)
+{
+  DEBUGASSERT(async != NULL && req != NULL);
+
+  return bus_async_cancel(&async->async, &req->base);
+}
+
+#endif /* CONFIG_SPI_ASYNC */
@@ -0,0 +1,286 @@
+/****************************************************************************
+ * drivers/spi/spi_loopback.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/signal.h>
+#include <nuttx/spi/spi.h>
+#include <nuttx/spi/spi_loopback.h>
+
+#ifdef CONFIG_SPI_LOOPBACK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SPI_LOOPBACK_FREQUENCY
+#  define CONFIG_SPI_LOOPBACK_FREQUENCY 1000000
+#endif
+
+#ifndef CONFIG_SPI_LOOPBACK_LATENCY
+#  define CONFIG_SPI_LOOPBACK_LATENCY 0
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct spi_loopback_dev_s
+{
+  struct spi_dev_s spidev;  /* Externally visible part of the SPI interface */
+  mutex_t lock;             /* Bus lock */
+  uint32_t frequency;       /* Simulated SCK frequency */
+  uint8_t nbits;            /* Bits per word */
+  uint8_t mode;             /* SPI mode */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int spi_loopback_lock(FAR struct spi_dev_s *dev, bool lock);
+static void spi_loopback_select(FAR struct spi_dev_s *dev, uint32_t devid,
+                                bool selected);
+static uint32_t spi_loopback_setfrequency(FAR struct spi_dev_s *dev,
+                                          uint32_t frequency);
+static void spi_loopback_setmode(FAR struct spi_dev_s *dev,
+                                 enum spi_mode_e mode);
+static void spi_loopback_setbits(FAR struct spi_dev_s *dev, int nbits);
+static uint8_t spi_loopback_status(FAR struct spi_dev_s *dev,
+                                   uint32_t devid);
+#ifdef CONFIG_SPI_CMDDATA
+static int spi_loopback_cmddata(FAR struct spi_dev_s *dev, uint32_t devid,
+                                bool cmd);
+#endif
+static uint32_t spi_loopback_send(FAR struct spi_dev_s *dev, uint32_t wd);
+static void spi_loopback_exchange(FAR struct spi_dev_s *dev,
+                                  FAR const void *txbuffer,
+                                  FAR void *rxbuffer, size_t nwords);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct spi_ops_s g_spiops =
+{
+  spi_loopback_lock,            /* lock */
+  spi_loopback_select,          /* select */
+  spi_loopback_setfrequency,    /* setfrequency */
+#ifdef CONFIG_SPI_DELAY_CONTROL
+  NULL,                         /* setdelay */
+#endif
+  spi_loopback_setmode,         /* setmode */
+  spi_loopback_setbits,         /* setbits */
+#ifdef CONFIG_SPI_HWFEATURES
+  NULL,                         /* hwfeatures */
+#endif
+  spi_loopback_status,          /* status */
+#ifdef CONFIG_SPI_CMDDATA
+  spi_loopback_cmddata,         /* cmddata */
+#endif
+  spi_loopback_send,            /* send */
+  spi_loopback_exchange,        /* exchange */
+#ifdef CONFIG_SPI_TRIGGER
+  NULL,                         /* trigger */
+#endif
+  NULL                          /* registercallback */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_loopback_busy
+ *
+ * Description:
+ *   Spend the time a transfer of nwords would take on the bus.  Waits
+ *   shorter than a tick are busy waits, like polled transfers; longer ones
+ *   sleep, like transfers waiting for a DMA interrupt.
+ *
+ ****************************************************************************/
+
+static void spi_loopback_busy(FAR struct spi_loopback_dev_s *priv,
+                              size_t nwords)
+{
+  uint64_t usec;
+
+  usec = (uint64_t)nwords * priv->nbits * USEC_PER_SEC / priv->frequency +
+         CONFIG_SPI_LOOPBACK_LATENCY;
+
+  if (usec >= USEC_PER_TICK)
+    {
+      nxsig_usleep(usec);
+    }
+  else if (usec > 0)
+    {
+      up_udelay(usec);
+    }
+}
+
+static int spi_loopback_lock(FAR struct spi_dev_s *dev, bool lock)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+
+  if (lock)
+    {
+      return nxmutex_lock(&priv->lock);
+    }
+  else
+    {
+      return nxmutex_unlock(&priv->lock);
+    }
+}
+
+static void spi_loopback_select(FAR struct spi_dev_s *dev, uint32_t devid,
+                                bool selected)
+{
+}
+
+static uint32_t spi_loopback_setfrequency(FAR struct spi_dev_s *dev,
+                                          uint32_t frequency)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+
+  if (frequency > 0)
+    {
+      priv->frequency = frequency;
+    }
+
+  return priv->frequency;
+}
+
+static void spi_loopback_setmode(FAR struct spi_dev_s *dev,
+                                 enum spi_mode_e mode)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+
+  priv->mode = mode;
+}
+
+static void spi_loopback_setbits(FAR struct spi_dev_s *dev, int nbits)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+
+  if (nbits > 0 && nbits <= 16)
+    {
+      priv->nbits = nbits;
+    }
+}
+
+static uint8_t spi_loopback_status(FAR struct spi_dev_s *dev,
+                                   uint32_t devid)
+{
+  return 0;
+}
+
+#ifdef CONFIG_SPI_CMDDATA
+static int spi_loopback_cmddata(FAR struct spi_dev_s *dev, uint32_t devid,
+                                bool cmd)
+{
+  return OK;
+}
+#endif
+
+static uint32_t spi_loopback_send(FAR struct spi_dev_s *dev, uint32_t wd)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+
+  spi_loopback_busy(priv, 1);
+  return wd;
+}
+
+/****************************************************************************
+ * Name: spi_loopback_exchange
+ *
+ * Description:
+ *   Receive what is sent.  Words wider than 8 bits take two bytes.  With
+ *   no TX buffer the bus reads 0xff, as with an idle MOSI line.
+ *
+ ****************************************************************************/
+
+static void spi_loopback_exchange(FAR struct spi_dev_s *dev,
+                                  FAR const void *txbuffer,
+                                  FAR void *rxbuffer, size_t nwords)
+{
+  FAR struct spi_loopback_dev_s *priv = (FAR struct spi_loopback_dev_s *)dev;
+  size_t nbytes = priv->nbits > 8 ? nwords << 1 : nwords;
+
+  spiinfo("txbuffer=%p rxbuffer=%p nwords=%zu\n",
+          txbuffer, rxbuffer, nwords);
+
+  if (rxbuffer != NULL)
+    {
+      if (txbuffer != NULL)
+        {
+          memmove(rxbuffer, txbuffer, nbytes);
+        }
+      else
+        {
+          memset(rxbuffer, 0xff, nbytes);
+        }
+    }
+
+  spi_loopback_busy(priv, nwords);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  spi_loopback_initialize
+ *
+ * Description:
+ *   Create an instance of the simulated loopback SPI bus.
+ *
+ ****************************************************************************/
+
+FAR struct spi_dev_s *spi_loopback_initialize(void)
+{
+  FAR struct spi_loopback_dev_s *priv;
+
+  priv = kmm_zalloc(sizeof(struct spi_loopback_dev_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->spidev.ops = &g_spiops;
+  priv->frequency  = CONFIG_SPI_LOOPBACK_FREQUENCY;
+  priv->nbits      = 8;
+  nxmutex_init(&priv->lock);
+
+  return &priv->spidev;
+}
+
+#endif /* CONFIG_SPI_LOOPBACK */
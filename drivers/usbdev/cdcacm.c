@@ -65,6 +65,14 @@
 
 #define CDCACM_RXDELAY   (CLK_TCK / 5)
 
+/* Length of a read request, a whole number of packets so that one request
+ * can take several packets of a transfer.
+ */
+
+#define CDCACM_RDREQLEN(ep) \
+  MAX(CONFIG_CDCACM_BULKOUT_REQLEN / (ep)->maxpacket * (ep)->maxpacket, \
+      (ep)->maxpacket)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -303,26 +311,32 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
   FAR struct uart_buffer_s *xmit = &serdev->xmit;
   irqstate_t flags;
   uint16_t nbytes = 0;
+  int tail;
+  int n;
 
   /* Disable interrupts */
 
   flags = enter_critical_section();
 
   /* Transfer bytes while we have bytes available and there is room in the
-   * request.
+   * request.  The circular buffer holds at most two contiguous runs of
+   * data, copy each one at a time.
    */
 
   while (xmit->head != xmit->tail && nbytes < reqlen)
     {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
+      tail = xmit->tail;
+      n    = xmit->head > tail ? xmit->head - tail : xmit->size - tail;
+      n    = MIN(n, reqlen - nbytes);
 
-      /* Increment the tail pointer */
+      memcpy(reqbuf, &xmit->buffer[tail], n);
+      reqbuf += n;
+      nbytes += n;
 
-      if (++(xmit->tail) >= xmit->size)
-        {
-          xmit->tail = 0;
-        }
+      /* Advance the tail pointer */
+
+      tail += n;
+      xmit->tail = tail >= xmit->size ? 0 : tail;
     }
 
   /* When all of the characters have been sent from the buffer disable the
@@ -457,10 +471,13 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   FAR uint8_t *reqbuf;
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   unsigned int watermark;
+  unsigned int nbuffered;
 #endif
   uint16_t reqlen;
   uint16_t nexthead;
   uint16_t nbytes = 0;
+  int head;
+  int n;
 
   DEBUGASSERT(priv != NULL && rdcontainer != NULL);
 
@@ -518,10 +535,24 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
 
   while (nexthead != recv->tail && nbytes < reqlen)
     {
+      /* The free space runs up to the tail or the end of the buffer, one
+       * slot is always kept empty.
+       */
+
+      head = recv->head;
+      if (recv->tail > head)
+        {
+          n = recv->tail - head - 1;
+        }
+      else
+        {
+          n = recv->size - head - (recv->tail == 0);
+        }
+
+      n = MIN(n, reqlen - nbytes);
+
 #if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
     defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
-      unsigned int nbuffered;
-
       /* How many bytes are buffered */
 
       if (recv->head >= recv->tail)
@@ -548,17 +579,27 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
               break;
             }
         }
+      else
+        {
+          /* Stop the copy where the watermark is reached to check again */
+
+          n = MIN(n, watermark - nbuffered);
+        }
 #endif
 
-      /* Copy one byte to the head of the circular RX buffer */
+      /* Copy the run to the head of the circular RX buffer */
 
-      recv->buffer[recv->head] = *reqbuf++;
-      nbytes++;
+      memcpy(&recv->buffer[head], reqbuf, n);
+      reqbuf += n;
+      nbytes += n;
 
-      /* Increment the head index and check for wrap around */
+      /* Advance the head index and check for wrap around */
 
-      recv->head = nexthead;
-      if (++nexthead >= recv->size)
+      head += n;
+      recv->head = head >= recv->size ? 0 : head;
+
+      nexthead = recv->head + 1;
+      if (nexthead >= recv->size)
         {
           nexthead = 0;
         }
@@ -624,7 +665,7 @@ static int cdcacm_requeue_rdrequest(FAR struct cdcacm_dev_s *priv,
   /* Requeue the read request */
 
   ep       = priv->epbulkout;
-  req->len = ep->maxpacket;
+  req->len = CDCACM_RDREQLEN(ep);
   ret      = EP_SUBMIT(ep, req);
   if (ret != OK)
     {
@@ -1037,6 +1078,7 @@ static int cdcacm_setconfig(FAR struct cdcacm_dev_s *priv, uint8_t config)
     {
       req           = priv->rdreqs[i].req;
       req->callback = cdcacm_rdcomplete;
+      req->len      = CDCACM_RDREQLEN(priv->epbulkout);
       ret           = EP_SUBMIT(priv->epbulkout, req);
       if (ret != OK)
         {
@@ -1331,6 +1373,8 @@ static int cdcacm_bind(FAR struct usbdevclass_driver_s *driver,
   reqlen = CONFIG_CDCACM_EPBULKOUT_FSSIZE;
 #endif
 
+  reqlen = MAX(CONFIG_CDCACM_BULKOUT_REQLEN, reqlen);
+
   for (i = 0; i < CONFIG_CDCACM_NRDREQS; i++)
     {
       rdcontainer      = &priv->rdreqs[i];
@@ -42,6 +42,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/irq.h>
+#include <nuttx/queue.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
@@ -88,6 +89,20 @@
 #  define CONFIG_CDCECM_NINTERFACES 1
 #endif
 
+/* Number of USB read and write requests kept in flight */
+
+#ifndef CONFIG_CDCECM_NRDREQS
+#  define CONFIG_CDCECM_NRDREQS 4
+#endif
+
+#ifndef CONFIG_CDCECM_NWRREQS
+#  define CONFIG_CDCECM_NWRREQS 4
+#endif
+
+/* Size of the buffer of each request: one full Ethernet frame */
+
+#define CDCECM_REQLEN (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE)
+
 /* TX timeout = 1 minute */
 
 #define CDCECM_TXTIMEOUT (60*CLK_TCK)
@@ -100,6 +115,14 @@
  * Private Types
  ****************************************************************************/
 
+/* A USB request together with the link used to queue it in the driver */
+
+struct cdcecm_req_s
+{
+  sq_entry_t                   node;        /* Link in rxpending or wrfree */
+  FAR struct usbdev_req_s     *req;         /* The USB request */
+};
+
 /* The cdcecm_driver_s encapsulates all state information for a single
  * hardware interface
  */
@@ -119,11 +142,12 @@ struct cdcecm_driver_s
   uint16_t                     pktbuf[(CONFIG_NET_ETH_PKTSIZE +
                                        CONFIG_NET_GUARDSIZE + 1) / 2];
 
-  struct usbdev_req_s         *rdreq;       /* Single read request */
-  bool                         rxpending;   /* Packet available in rdreq */
+  struct cdcecm_req_s          rdreqs[CONFIG_CDCECM_NRDREQS];
+  sq_queue_t                   rxpending;   /* Completed read requests */
 
-  struct usbdev_req_s         *wrreq;       /* Single write request */
-  sem_t                        wrreq_idle;  /* Is the wrreq available? */
+  struct cdcecm_req_s          wrreqs[CONFIG_CDCECM_NWRREQS];
+  sq_queue_t                   wrfree;      /* Idle write requests */
+  sem_t                        wrreq_idle;  /* Counts the idle write requests */
   bool                         txdone;      /* Did a write request complete? */
 
   /* Network device */
@@ -155,7 +179,10 @@ static int  cdcecm_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void cdcecm_reply(struct cdcecm_driver_s *priv);
-static void cdcecm_receive(FAR struct cdcecm_driver_s *priv);
+static bool cdcecm_txbuffer(FAR struct cdcecm_driver_s *priv);
+static void cdcecm_poll(FAR struct cdcecm_driver_s *priv);
+static void cdcecm_receive(FAR struct cdcecm_driver_s *priv,
+                           FAR struct usbdev_req_s *req);
 static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv);
 
 static void cdcecm_interrupt_work(FAR void *arg);
@@ -286,7 +313,11 @@ static const struct usb_devdesc_s g_devdesc =
 
 static int cdcecm_transmit(FAR struct cdcecm_driver_s *self)
 {
-  /* Wait until the USB device request for Ethernet frame transmissions
+  FAR struct cdcecm_req_s *wrcontainer;
+  FAR struct usbdev_req_s *req;
+  irqstate_t flags;
+
+  /* Wait until a USB device request for Ethernet frame transmissions
    * becomes available.
    */
 
@@ -294,16 +325,31 @@ static int cdcecm_transmit(FAR struct cdcecm_driver_s *self)
     {
     }
 
+  flags = enter_critical_section();
+  wrcontainer = (FAR struct cdcecm_req_s *)sq_remfirst(&self->wrfree);
+  leave_critical_section(flags);
+
+  DEBUGASSERT(wrcontainer != NULL);
+  req = wrcontainer->req;
+
   /* Increment statistics */
 
   NETDEV_TXPACKETS(self->dev);
 
-  /* Send the packet: address=priv->dev.d_buf, length=priv->dev.d_len */
+  /* Send the packet: address=priv->dev.d_buf, length=priv->dev.d_len.
+   * Frames produced by devif_poll() were already built in the request
+   * buffer by cdcecm_txbuffer(); only replies to received frames have to
+   * be copied.
+   */
+
+  if (self->dev.d_buf != req->buf)
+    {
+      memcpy(req->buf, self->dev.d_buf, self->dev.d_len);
+    }
 
-  memcpy(self->wrreq->buf, self->dev.d_buf, self->dev.d_len);
-  self->wrreq->len = self->dev.d_len;
+  req->len = self->dev.d_len;
 
-  return EP_SUBMIT(self->epbulkin, self->wrreq);
+  return EP_SUBMIT(self->epbulkin, req);
 }
 
 /****************************************************************************
@@ -343,7 +389,80 @@ static int cdcecm_txpoll(FAR struct net_driver_s *dev)
    * not, return a non-zero value to terminate the poll.
    */
 
-  return 1;
+  return cdcecm_txbuffer(priv) ? 0 : 1;
+}
+
+/****************************************************************************
+ * Name: cdcecm_txbuffer
+ *
+ * Description:
+ *   Point d_buf at the buffer of the next idle write request so that the
+ *   network builds the next outgoing frame directly in it.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   true if a write request is available; false if all of them are in
+ *   flight, in which case d_buf is set back to the driver frame buffer.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static bool cdcecm_txbuffer(FAR struct cdcecm_driver_s *priv)
+{
+  FAR struct cdcecm_req_s *wrcontainer;
+  irqstate_t flags;
+
+  /* Write requests are only taken from wrfree by cdcecm_transmit() with
+   * the network locked, so the head stays the same until it is used.
+   */
+
+  flags = enter_critical_section();
+  wrcontainer = (FAR struct cdcecm_req_s *)sq_peek(&priv->wrfree);
+  leave_critical_section(flags);
+
+  if (wrcontainer == NULL)
+    {
+      priv->dev.d_buf = (FAR uint8_t *)priv->pktbuf;
+      return false;
+    }
+
+  priv->dev.d_buf = wrcontainer->req->buf;
+  return true;
+}
+
+/****************************************************************************
+ * Name: cdcecm_poll
+ *
+ * Description:
+ *   Poll the network for new TX data while there are idle write requests.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void cdcecm_poll(FAR struct cdcecm_driver_s *priv)
+{
+  /* If all write requests are in flight, the poll is retried when one of
+   * them completes.
+   */
+
+  if (cdcecm_txbuffer(priv))
+    {
+      devif_poll(&priv->dev, cdcecm_txpoll);
+    }
+
+  priv->dev.d_buf = (FAR uint8_t *)priv->pktbuf;
 }
 
 /****************************************************************************
@@ -387,6 +506,7 @@ static void cdcecm_reply(struct cdcecm_driver_s *priv)
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
+ *   req  - The completed read request holding the packet
  *
  * Returned Value:
  *   None
@@ -396,7 +516,8 @@ static void cdcecm_reply(struct cdcecm_driver_s *priv)
  *
  ****************************************************************************/
 
-static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
+static void cdcecm_receive(FAR struct cdcecm_driver_s *self,
+                           FAR struct usbdev_req_s *req)
 {
   /* Check for errors and update statistics */
 
@@ -404,12 +525,12 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
    * configuration.
    */
 
-  /* Copy the data data from the hardware to self->dev.d_buf.  Set
-   * amount of data in self->dev.d_len
+  /* Hand the request buffer to the network as it is instead of copying
+   * the frame into self->pktbuf.  Set amount of data in self->dev.d_len
    */
 
-  memcpy(self->dev.d_buf, self->rdreq->buf, self->rdreq->xfrd);
-  self->dev.d_len = self->rdreq->xfrd;
+  self->dev.d_buf = req->buf;
+  self->dev.d_len = req->xfrd;
 
 #ifdef CONFIG_NET_PKT
   /* When packet sockets are enabled, feed the frame into the tap */
@@ -473,6 +594,10 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
     {
       NETDEV_RXDROPPED(&self->dev);
     }
+
+  /* The request buffer goes back to the hardware */
+
+  self->dev.d_buf = (FAR uint8_t *)self->pktbuf;
 }
 
 /****************************************************************************
@@ -500,7 +625,7 @@ static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv)
 
   /* In any event, poll the network for new TX data */
 
-  devif_poll(&priv->dev, cdcecm_txpoll);
+  cdcecm_poll(priv);
 }
 
 /****************************************************************************
@@ -523,6 +648,7 @@ static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv)
 static void cdcecm_interrupt_work(FAR void *arg)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)arg;
+  FAR struct cdcecm_req_s *rdcontainer;
   irqstate_t flags;
 
   /* Lock the network and serialize driver operations if necessary.
@@ -533,15 +659,29 @@ static void cdcecm_interrupt_work(FAR void *arg)
 
   net_lock();
 
-  /* Check if we received an incoming packet, if so, call cdcecm_receive() */
+  /* Pass every received packet to cdcecm_receive() and give its read
+   * request back to the hardware.
+   */
 
-  if (self->rxpending)
+  for (; ; )
     {
-      cdcecm_receive(self);
+      flags = enter_critical_section();
+      rdcontainer = (FAR struct cdcecm_req_s *)sq_remfirst(&self->rxpending);
+      leave_critical_section(flags);
+
+      if (rdcontainer == NULL)
+        {
+          break;
+        }
+
+      cdcecm_receive(self, rdcontainer->req);
 
       flags = enter_critical_section();
-      self->rxpending = false;
-      EP_SUBMIT(self->epbulkout, self->rdreq);
+      if (self->config != CDCECM_CONFIGID_NONE)
+        {
+          EP_SUBMIT(self->epbulkout, rdcontainer->req);
+        }
+
       leave_critical_section(flags);
     }
 
@@ -683,7 +823,7 @@ static void cdcecm_txavail_work(FAR void *arg)
 
   if (self->bifup)
     {
-      devif_poll(&self->dev, cdcecm_txpoll);
+      cdcecm_poll(self);
     }
 
   net_unlock();
@@ -930,6 +1070,9 @@ static void cdcecm_rdcomplete(FAR struct usbdev_ep_s *ep,
                               FAR struct usbdev_req_s *req)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)ep->priv;
+  FAR struct cdcecm_req_s *rdcontainer =
+    (FAR struct cdcecm_req_s *)req->priv;
+  irqstate_t flags;
 
   uinfo("buf: %p, flags 0x%hhx, len %hu, xfrd %hu, result %hd\n",
         req->buf, req->flags, req->len, req->xfrd, req->result);
@@ -938,8 +1081,14 @@ static void cdcecm_rdcomplete(FAR struct usbdev_ep_s *ep,
     {
       case 0:  /* Normal completion */
         {
-          DEBUGASSERT(!self->rxpending);
-          self->rxpending = true;
+          /* The other read requests stay queued in the hardware while
+           * this one waits for the worker.
+           */
+
+          flags = enter_critical_section();
+          sq_addlast(&rdcontainer->node, &self->rxpending);
+          leave_critical_section(flags);
+
           work_queue(ETHWORK, &self->irqwork,
                      cdcecm_interrupt_work, self, 0);
         }
@@ -951,7 +1100,7 @@ static void cdcecm_rdcomplete(FAR struct usbdev_ep_s *ep,
       default: /* Some other error occurred */
         {
           uerr("req->result: %hd\n", req->result);
-          EP_SUBMIT(self->epbulkout, self->rdreq);
+          EP_SUBMIT(self->epbulkout, req);
         }
         break;
     }
@@ -970,15 +1119,22 @@ static void cdcecm_wrcomplete(FAR struct usbdev_ep_s *ep,
                               FAR struct usbdev_req_s *req)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)ep->priv;
+  FAR struct cdcecm_req_s *wrcontainer =
+    (FAR struct cdcecm_req_s *)req->priv;
+  irqstate_t flags;
   int rc;
 
   uinfo("buf: %p, flags 0x%hhx, len %hu, xfrd %hu, result %hd\n",
         req->buf, req->flags, req->len, req->xfrd, req->result);
 
-  /* The single USB device write request is available for upcoming
-   * transmissions again.
+  /* The USB device write request is available for upcoming transmissions
+   * again.
    */
 
+  flags = enter_critical_section();
+  sq_addlast(&wrcontainer->node, &self->wrfree);
+  leave_critical_section(flags);
+
   rc = nxsem_post(&self->wrreq_idle);
 
   if (rc != OK)
@@ -1021,6 +1177,10 @@ static void cdcecm_resetconfig(FAR struct cdcecm_driver_s *self)
       EP_DISABLE(self->epint);
       EP_DISABLE(self->epbulkin);
       EP_DISABLE(self->epbulkout);
+
+      /* Drop the received packets not processed yet */
+
+      sq_init(&self->rxpending);
     }
 }
 
@@ -1036,6 +1196,7 @@ static int cdcecm_setconfig(FAR struct cdcecm_driver_s *self, uint8_t config)
 {
   struct usb_epdesc_s epdesc;
   int ret = OK;
+  int i;
 
   if (config == self->config)
     {
@@ -1089,14 +1250,16 @@ static int cdcecm_setconfig(FAR struct cdcecm_driver_s *self, uint8_t config)
 
   /* Queue read requests in the bulk OUT endpoint */
 
-  DEBUGASSERT(!self->rxpending);
+  DEBUGASSERT(sq_empty(&self->rxpending));
 
-  self->rdreq->callback = cdcecm_rdcomplete,
-  ret = EP_SUBMIT(self->epbulkout, self->rdreq);
-  if (ret != OK)
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      uerr("EP_SUBMIT failed. ret %d\n", ret);
-      goto error;
+      ret = EP_SUBMIT(self->epbulkout, self->rdreqs[i].req);
+      if (ret != OK)
+        {
+          uerr("EP_SUBMIT failed. ret %d\n", ret);
+          goto error;
+        }
     }
 
   /* We are successfully configured */
@@ -1598,7 +1761,9 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
                        FAR struct usbdev_s *dev)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
+  FAR struct usbdev_req_s *req;
   int ret = OK;
+  int i;
 
   uinfo("\n");
 
@@ -1644,33 +1809,46 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
 
   /* Pre-allocate read requests.  The buffer size is one full packet. */
 
-  self->rdreq = usbdev_allocreq(self->epbulkout,
-                  CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
-  if (self->rdreq == NULL)
+  sq_init(&self->rxpending);
+
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
+      req = usbdev_allocreq(self->epbulkout, CDCECM_REQLEN);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
+
+      req->priv           = &self->rdreqs[i];
+      req->callback       = cdcecm_rdcomplete;
+      self->rdreqs[i].req = req;
     }
 
-  self->rdreq->callback = cdcecm_rdcomplete;
+  /* Pre-allocate write requests.  Buffer size is one full packet. */
 
-  /* Pre-allocate a single write request.  Buffer size is one full packet. */
+  sq_init(&self->wrfree);
 
-  self->wrreq = usbdev_allocreq(self->epbulkin,
-                  CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
-  if (self->wrreq == NULL)
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
-    }
+      req = usbdev_allocreq(self->epbulkin, CDCECM_REQLEN);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
 
-  self->wrreq->callback = cdcecm_wrcomplete;
+      req->priv           = &self->wrreqs[i];
+      req->callback       = cdcecm_wrcomplete;
+      self->wrreqs[i].req = req;
+      sq_addlast(&self->wrreqs[i].node, &self->wrfree);
+    }
 
-  /* The single write request just allocated is available now. */
+  /* All the write requests just allocated are available now. */
 
-  ret = nxsem_init(&self->wrreq_idle, 0, 1);
+  ret = nxsem_init(&self->wrreq_idle, 0, CONFIG_CDCECM_NWRREQS);
 
   if (ret != OK)
     {
@@ -1704,6 +1882,7 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
                           FAR struct usbdev_s *dev)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
+  int i;
 
 #ifdef CONFIG_DEBUG_FEATURES
   if (!driver || !dev)
@@ -1743,12 +1922,17 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
    * been returned to the free list at this time -- we don't check)
    */
 
-  if (self->rdreq != NULL)
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      usbdev_freereq(self->epbulkout, self->rdreq);
-      self->rdreq = NULL;
+      if (self->rdreqs[i].req != NULL)
+        {
+          usbdev_freereq(self->epbulkout, self->rdreqs[i].req);
+          self->rdreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->rxpending);
+
   /* Free the bulk OUT endpoint */
 
   if (self->epbulkout)
@@ -1761,12 +1945,17 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
    * of them)
    */
 
-  if (self->wrreq != NULL)
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      usbdev_freereq(self->epbulkin, self->wrreq);
-      self->wrreq = NULL;
+      if (self->wrreqs[i].req != NULL)
+        {
+          usbdev_freereq(self->epbulkin, self->wrreqs[i].req);
+          self->wrreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->wrfree);
+
   /* Free the bulk IN endpoint */
 
   if (self->epbulkin)
@@ -1577,6 +1577,52 @@ int usbmsc_unbindlun(FAR void *handle, unsigned int lunno)
   return ret;
 }
 
+/****************************************************************************
+ * Name: usbmsc_getstats
+ *
+ * Description:
+ *   Return the read/write statistics of the USB storage device, optionally
+ *   resetting them.
+ *
+ * Input Parameters:
+ *   handle - The handle returned by a previous call to usbmsc_configure().
+ *   stats  - Location to return the statistics
+ *   reset  - True: Clear the statistics after reading them
+ *
+ * Returned Value:
+ *   0 on success; a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_USBMSC_STATISTICS
+int usbmsc_getstats(FAR void *handle, FAR struct usbmsc_stats_s *stats,
+                    bool reset)
+{
+  FAR struct usbmsc_alloc_s *alloc = (FAR struct usbmsc_alloc_s *)handle;
+  FAR struct usbmsc_dev_s *priv;
+  irqstate_t flags;
+
+  if (alloc == NULL || stats == NULL)
+    {
+      return -EINVAL;
+    }
+
+  priv = &alloc->dev;
+
+  /* The SCSI worker thread updates the statistics in a critical section */
+
+  flags = enter_critical_section();
+  memcpy(stats, &priv->stats, sizeof(struct usbmsc_stats_s));
+  if (reset)
+    {
+      memset(&priv->stats, 0, sizeof(struct usbmsc_stats_s));
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: usbmsc_exportluns
  *
@@ -40,6 +40,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/usb/storage.h>
 #include <nuttx/usb/usbdev.h>
+#include <nuttx/usb/usbmsc.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -153,6 +154,14 @@
 #  endif
 #endif
 
+/* The part of a bulk IN request buffer used for data transfers: the
+ * request buffer rounded down to whole packets, so that only the final
+ * request of a transfer may end with a short packet.
+ */
+
+#define USBMSC_BULKINREQLEN(ep) \
+  (CONFIG_USBMSC_BULKINREQLEN / (ep)->maxpacket * (ep)->maxpacket)
+
 /* Vendor and product IDs and strings */
 
 #ifndef CONFIG_USBMSC_COMPOSITE
@@ -422,6 +431,11 @@ struct usbmsc_dev_s
   uint32_t          residue;          /* Untransferred amount reported in the CSW */
   uint8_t          *iobuffer;         /* Buffer for data transfers */
 
+#ifdef CONFIG_USBMSC_STATISTICS
+  clock_t           xfrstart;         /* Start of the current data phase */
+  struct usbmsc_stats_s stats;        /* Read/write throughput statistics */
+#endif
+
   /* Write request list */
 
   struct sq_queue_s wrreqlist;        /* List of empty write request containers */
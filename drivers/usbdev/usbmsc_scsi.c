@@ -56,6 +56,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/kthread.h>
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/queue.h>
 #include <nuttx/signal.h>
 #include <nuttx/scsi.h>
@@ -164,6 +165,8 @@ static inline int usbmsc_setupcmd(FAR struct usbmsc_dev_s *priv,
 
 static int    usbmsc_idlestate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv);
+static int    usbmsc_cmdreaddirect(FAR struct usbmsc_dev_s *priv,
+                                   FAR struct usbdev_req_s *req);
 static int    usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdfinishstate(FAR struct usbmsc_dev_s *priv);
@@ -2134,6 +2137,16 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
 
   nxmutex_unlock(&priv->thlock);
 
+#ifdef CONFIG_USBMSC_STATISTICS
+  /* Start timing the data phase of read6/10/12 and write6/10/12 */
+
+  if (priv->thstate == USBMSC_STATE_CMDREAD ||
+      priv->thstate == USBMSC_STATE_CMDWRITE)
+    {
+      priv->xfrstart = clock_systime_ticks();
+    }
+#endif
+
   /* Is a response required?  (Not for read6/10/12 and write6/10/12). */
 
   if (priv->thstate == USBMSC_STATE_CMDPARSE)
@@ -2202,6 +2215,110 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
   return ret;
 }
 
+/****************************************************************************
+ * Name: usbmsc_xfrstats
+ *
+ * Description:
+ *   Account the data phase of a read or write command that just finished
+ *   in the driver statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_USBMSC_STATISTICS
+static void usbmsc_xfrstats(FAR struct usbmsc_dev_s *priv, bool write)
+{
+  uint32_t nbytes = priv->cbwlen - priv->residue;
+  clock_t elapsed = clock_systime_ticks() - priv->xfrstart;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (write)
+    {
+      priv->stats.nwritecmds++;
+      priv->stats.nwritebytes += nbytes;
+      priv->stats.writeticks  += elapsed;
+    }
+  else
+    {
+      priv->stats.nreadcmds++;
+      priv->stats.nreadbytes  += nbytes;
+      priv->stats.readticks   += elapsed;
+    }
+
+  leave_critical_section(flags);
+}
+#else
+#  define usbmsc_xfrstats(priv, write)
+#endif
+
+/****************************************************************************
+ * Name: usbmsc_cmdreaddirect
+ *
+ * Description:
+ *   Read as many whole sectors as fit into the write request at the head
+ *   of the wrreqlist straight from the block driver into the request
+ *   buffer and submit it to the bulk IN endpoint.  Each write request is
+ *   then one stage of the read pipeline: while the DCD sends one request,
+ *   the worker thread reads the next sectors into the next one.
+ *
+ * Returned Value:
+ *   OK if the request was submitted; a negated errno on a media or
+ *   submission failure (the sense data is already updated).
+ *
+ ****************************************************************************/
+
+static int usbmsc_cmdreaddirect(FAR struct usbmsc_dev_s *priv,
+                                FAR struct usbdev_req_s *req)
+{
+  FAR struct usbmsc_lun_s *lun = priv->lun;
+  FAR struct usbmsc_req_s *privreq;
+  irqstate_t flags;
+  uint32_t nsectors;
+  ssize_t nread;
+  int ret;
+
+  nsectors = USBMSC_BULKINREQLEN(priv->epbulkin) / lun->sectorsize;
+  nsectors = MIN(nsectors, priv->u.xfrlen);
+
+  nread = USBMSC_DRVR_READ(lun, req->buf, priv->sector, nsectors);
+  if (nread <= 0)
+    {
+      usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL), -nread);
+      lun->sd     = SCSI_KCQME_UNRRE1;
+      lun->sdinfo = priv->sector;
+      return nread < 0 ? nread : -EIO;
+    }
+
+  /* The block driver may have returned fewer sectors than requested */
+
+  nsectors = nread;
+
+  priv->u.xfrlen -= nsectors;
+  priv->sector   += nsectors;
+
+  flags = enter_critical_section();
+  privreq = (FAR struct usbmsc_req_s *)sq_remfirst(&priv->wrreqlist);
+  leave_critical_section(flags);
+
+  req->len      = nsectors * lun->sectorsize;
+  req->priv     = privreq;
+  req->callback = usbmsc_wrcomplete;
+  req->flags    = 0;
+
+  ret = EP_SUBMIT(priv->epbulkin, req);
+  if (ret != OK)
+    {
+      usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADSUBMIT),
+               (uint16_t)-ret);
+      lun->sd     = SCSI_KCQME_UNRRE1;
+      lun->sdinfo = priv->sector;
+      return ret;
+    }
+
+  priv->residue -= req->len;
+  return OK;
+}
+
 /****************************************************************************
  * Name: usbmsc_cmdreadstate
  *
@@ -2249,6 +2366,30 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
     {
       usbtrace(TRACE_CLASSSTATE(USBMSC_CLASSSTATE_CMDREAD), priv->u.xfrlen);
 
+      /* Can whole sectors be read directly into the next write request?
+       * That is possible if nothing is buffered and the request buffer
+       * holds at least one sector made of full packets.
+       */
+
+      if (priv->nsectbytes <= 0 && priv->nreqbytes == 0 &&
+          USBMSC_BULKINREQLEN(priv->epbulkin) >= lun->sectorsize &&
+          lun->sectorsize % priv->epbulkin->maxpacket == 0)
+        {
+          privreq = (FAR struct usbmsc_req_s *)sq_peek(&priv->wrreqlist);
+          if (!privreq)
+            {
+              usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADWRRQEMPTY), 0);
+              return -ENOMEM;
+            }
+
+          if (usbmsc_cmdreaddirect(priv, privreq->req) < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
       /* Is the I/O buffer empty? */
 
       if (priv->nsectbytes <= 0)
@@ -2298,7 +2439,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
       src    = &priv->iobuffer[lun->sectorsize - priv->nsectbytes];
       dest   = &req->buf[priv->nreqbytes];
 
-      nbytes = MIN(priv->epbulkin->maxpacket - priv->nreqbytes,
+      nbytes = MIN(USBMSC_BULKINREQLEN(priv->epbulkin) - priv->nreqbytes,
                    priv->nsectbytes);
 
       /* Copy the data from the sector buffer to the USB request and update
@@ -2314,7 +2455,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * then submit the request
        */
 
-      if (priv->nreqbytes >= priv->epbulkin->maxpacket ||
+      if (priv->nreqbytes >= USBMSC_BULKINREQLEN(priv->epbulkin) ||
           (priv->u.xfrlen <= 0 && priv->nsectbytes <= 0))
         {
           /* Remove the request that we just filled from wrreqlist (we've
@@ -2354,6 +2495,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
 
   usbtrace(TRACE_CLASSSTATE(USBMSC_CLASSSTATE_CMDREADCMDFINISH),
            priv->u.xfrlen);
+  usbmsc_xfrstats(priv, false);
   priv->thstate  = USBMSC_STATE_CMDFINISH;
   return OK;
 }
@@ -2548,6 +2690,7 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 errout:
   usbtrace(TRACE_CLASSSTATE(USBMSC_CLASSSTATE_CMDWRITECMDFINISH),
            priv->u.xfrlen);
+  usbmsc_xfrstats(priv, true);
   priv->thstate  = USBMSC_STATE_CMDFINISH;
   return OK;
 }
@@ -40,7 +40,12 @@
 
 #include <nuttx/random.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/map.h>
 #include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
 
@@ -52,6 +57,20 @@
 #  define CONFIG_NET_USRSOCKDEV_NPOLLWAITERS 1
 #endif
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+#  define USRSOCK_SHM_HDRSIZE   USRSOCK_SHM_ALIGN(sizeof(struct usrsock_shm_s))
+#  define USRSOCK_SHM_MINRING   256
+
+/* The ring geometry and the indices owned by the kernel are kept in the
+ * device, the copies in the shared header are only for the daemon.
+ */
+
+#  define USRSOCK_SHM_REQDATA(dev) \
+     ((FAR uint8_t *)(dev)->shm + USRSOCK_SHM_HDRSIZE)
+#  define USRSOCK_SHM_RESPDATA(dev) \
+     (USRSOCK_SHM_REQDATA(dev) + (dev)->shmsize)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -67,6 +86,16 @@ struct usrsockdev_s
     size_t                  pos;    /* Reader position on request buffer */
   } req;
   FAR struct pollfd *pollfds[CONFIG_NET_USRSOCKDEV_NPOLLWAITERS];
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+  FAR struct usrsock_shm_s *shm;    /* Shared rings, NULL if not mapped */
+  size_t             shmlen;        /* Size of the shared mapping */
+  uint32_t           shmsize;       /* Size of each ring (power of two) */
+  uint16_t           shmrefs;       /* Number of live mappings of shm */
+  uint32_t           reqhead;       /* Producer index of the request ring */
+  uint32_t           resptail;      /* Consumer index of the response ring */
+  sem_t              spacesem;      /* Wait for room in the request ring */
+  uint16_t           nspacewait;    /* Number of threads waiting for room */
+#endif
 };
 
 /****************************************************************************
@@ -91,6 +120,18 @@ static int usrsockdev_close(FAR struct file *filep);
 static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+
+static int usrsockdev_mmap(FAR struct file *filep,
+                           FAR struct mm_map_entry_s *map);
+
+static int usrsockdev_munmap(FAR struct task_group_s *group,
+                             FAR struct mm_map_entry_s *map,
+                             FAR void *start, size_t length);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -102,15 +143,23 @@ static const struct file_operations g_usrsockdevops =
   usrsockdev_read,    /* read */
   usrsockdev_write,   /* write */
   usrsockdev_seek,    /* seek */
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+  usrsockdev_ioctl,   /* ioctl */
+  usrsockdev_mmap,    /* mmap */
+#else
   NULL,               /* ioctl */
   NULL,               /* mmap */
+#endif
   NULL,               /* truncate */
   usrsockdev_poll     /* poll */
 };
 
 static struct usrsockdev_s g_usrsockdev =
 {
-  NXMUTEX_INITIALIZER
+  .devlock  = NXMUTEX_INITIALIZER,
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+  .spacesem = SEM_INITIALIZER(0),
+#endif
 };
 
 /****************************************************************************
@@ -133,6 +182,292 @@ static bool usrsockdev_is_opened(FAR struct usrsockdev_s *dev)
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+
+/****************************************************************************
+ * Name: usrsockdev_shm_used
+ *
+ * Description:
+ *   Return the number of bytes pending in a ring, or a negated errno if the
+ *   index published by the daemon is corrupted.
+ *
+ ****************************************************************************/
+
+static ssize_t usrsockdev_shm_used(FAR struct usrsockdev_s *dev,
+                                   uint32_t head, uint32_t tail)
+{
+  uint32_t used = head - tail;
+
+  return used > dev->shmsize ? -EIO : (ssize_t)used;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_shm_push
+ *
+ * Description:
+ *   Gather one request from the iovec list into the request ring.  Called
+ *   with devlock held.
+ *
+ * Returned Value:
+ *   OK on success, -EAGAIN if the ring does not have room for the record
+ *   yet, other negated errno on failure.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_shm_push(FAR struct usrsockdev_s *dev,
+                               FAR const struct iovec *iov, int iovcnt)
+{
+  FAR volatile struct usrsock_shmring_s *ring = &dev->shm->req;
+  FAR uint8_t *data = USRSOCK_SHM_REQDATA(dev);
+  FAR struct usrsock_shmrec_s *rec;
+  uint32_t size = dev->shmsize;
+  uint32_t mask = size - 1;
+  uint32_t oldhead = dev->reqhead;
+  uint32_t head = oldhead;
+  uint32_t contig;
+  ssize_t used;
+  size_t reclen;
+  size_t len = 0;
+  int i;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  reclen = USRSOCK_SHM_RECLEN(len);
+  if (reclen > size / 2)
+    {
+      return -EMSGSIZE;
+    }
+
+  used = usrsockdev_shm_used(dev, head, ring->tail);
+  if (used < 0)
+    {
+      return used;
+    }
+
+  /* A record that would straddle the end of the ring is preceded by a wrap
+   * marker skipping the rest of the ring.
+   */
+
+  contig = size - (head & mask);
+  if (size - used < (contig < reclen ? contig + reclen : reclen))
+    {
+      return -EAGAIN;
+    }
+
+  if (contig < reclen)
+    {
+      rec = (FAR struct usrsock_shmrec_s *)(data + (head & mask));
+      rec->len = USRSOCK_SHM_WRAP;
+      head += contig;
+    }
+
+  rec = (FAR struct usrsock_shmrec_s *)(data + (head & mask));
+  rec->len = len;
+  rec->reserved = 0;
+  usrsock_iovec_get(rec + 1, len, iov, iovcnt, 0, NULL);
+
+  /* Publish the record, then check whether the daemon had already drained
+   * the ring and so needs a wake-up.  Both sides pair a full barrier with
+   * the store of their index, so at least one of them sees the other.
+   */
+
+  dev->reqhead = head + reclen;
+  SP_DMB();
+  ring->head = dev->reqhead;
+  SP_DMB();
+
+  if (ring->tail == oldhead)
+    {
+      poll_notify(dev->pollfds, nitems(dev->pollfds), POLLIN);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_shm_request
+ *
+ * Description:
+ *   Queue one request into the request ring, waiting for the daemon to
+ *   make room if needed.  Called with devlock held.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_shm_request(FAR struct usrsockdev_s *dev,
+                                  FAR const struct iovec *iov, int iovcnt)
+{
+  int ret;
+
+  while ((ret = usrsockdev_shm_push(dev, iov, iovcnt)) == -EAGAIN)
+    {
+      /* Ask the daemon to kick us once it consumed some requests. */
+
+      dev->shm->waitspace = 1;
+      dev->nspacewait++;
+
+      nxmutex_unlock(&dev->devlock);
+      net_sem_wait_uninterruptible(&dev->spacesem);
+      net_mutex_lock(&dev->devlock);
+
+      if (!usrsockdev_is_opened(dev) || dev->shm == NULL)
+        {
+          return -ENETDOWN;
+        }
+    }
+
+  return ret < 0 ? ret : USRSOCK_REQUEST_QUEUED;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_shm_wakeup
+ *
+ * Description:
+ *   Wake up all requests waiting for room in the request ring.  Called with
+ *   devlock held.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_shm_wakeup(FAR struct usrsockdev_s *dev)
+{
+  if (dev->shm != NULL)
+    {
+      dev->shm->waitspace = 0;
+    }
+
+  while (dev->nspacewait > 0)
+    {
+      dev->nspacewait--;
+      nxsem_post(&dev->spacesem);
+    }
+}
+
+/****************************************************************************
+ * Name: usrsockdev_shm_kick
+ *
+ * Description:
+ *   Hand all messages pending in the response ring over to the usrsock
+ *   stack.  Called with devlock held.
+ *
+ * Returned Value:
+ *   The number of messages processed, or a negated errno if the ring is
+ *   corrupted or a message was rejected.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_shm_kick(FAR struct usrsockdev_s *dev)
+{
+  FAR volatile struct usrsock_shmring_s *ring;
+  FAR struct usrsock_shmrec_s *rec;
+  FAR const char *buffer;
+  FAR uint8_t *data;
+  uint32_t size;
+  uint32_t mask;
+  uint32_t tail;
+  uint32_t contig;
+  ssize_t used;
+  size_t reclen;
+  size_t len;
+  bool req_done;
+  int nmsgs = 0;
+  int ret = OK;
+
+  if (dev->shm == NULL)
+    {
+      return -ENXIO;
+    }
+
+  ring = &dev->shm->resp;
+  data = USRSOCK_SHM_RESPDATA(dev);
+  size = dev->shmsize;
+  mask = size - 1;
+
+  for (; ; )
+    {
+      tail = dev->resptail;
+      used = usrsockdev_shm_used(dev, ring->head, tail);
+      if (used <= 0)
+        {
+          if (used < 0)
+            {
+              nerr("ERROR: corrupted response ring head\n");
+              ret = used;
+            }
+
+          break;
+        }
+
+      SP_DMB();
+
+      contig = size - (tail & mask);
+      rec    = (FAR struct usrsock_shmrec_s *)(data + (tail & mask));
+
+      /* Read the length once, the daemon may still change it */
+
+      len    = *(FAR volatile uint32_t *)&rec->len;
+
+      if (len == USRSOCK_SHM_WRAP)
+        {
+          if (contig > used)
+            {
+              nerr("ERROR: corrupted response ring wrap\n");
+              ret = -EIO;
+              break;
+            }
+
+          dev->resptail = tail + contig;
+          ring->tail    = dev->resptail;
+          continue;
+        }
+
+      if (len > contig - sizeof(*rec) || USRSOCK_SHM_RECLEN(len) > used)
+        {
+          nerr("ERROR: corrupted response ring, len=%zu\n", len);
+          ret = -EIO;
+          break;
+        }
+
+      buffer = (FAR const char *)(rec + 1);
+      reclen = USRSOCK_SHM_RECLEN(len);
+
+      while (len > 0)
+        {
+          req_done = false;
+          used = usrsock_response(buffer, len, &req_done);
+          if (req_done && dev->req.iov)
+            {
+              dev->req.iov = NULL;
+              dev->req.pos = 0;
+              dev->req.iovcnt = 0;
+            }
+
+          if (used <= 0)
+            {
+              nerr("ERROR: rejected response message: %zd\n", used);
+              ret = used < 0 ? used : -EINVAL;
+              break;
+            }
+
+          buffer += used;
+          len    -= used;
+        }
+
+      dev->resptail = tail + reclen;
+      SP_DMB();
+      ring->tail = dev->resptail;
+      nmsgs++;
+    }
+
+  /* Whatever the daemon consumed from the request ring is free now. */
+
+  usrsockdev_shm_wakeup(dev);
+  return ret < 0 ? ret : nmsgs;
+}
+
+#endif /* CONFIG_NET_USRSOCK_DEVICE_SHMRING */
+
 /****************************************************************************
  * Name: usrsockdev_read
  ****************************************************************************/
@@ -380,12 +715,216 @@ static int usrsockdev_close(FAR struct file *filep)
   dev->req.iovcnt = 0;
   dev->req.pos = 0;
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+  /* The daemon is gone, release the requests waiting on the rings and stop
+   * using them.  The memory stays until its last mapping goes away.
+   */
+
+  usrsockdev_shm_wakeup(dev);
+  if (dev->shm != NULL && dev->shmrefs == 0)
+    {
+      kumm_free(dev->shm);
+    }
+
+  dev->shm = NULL;
+  dev->shmlen = 0;
+#endif
+
   nxmutex_unlock(&dev->devlock);
   usrsock_abort();
 
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+
+/****************************************************************************
+ * Name: usrsockdev_ioctl
+ ****************************************************************************/
+
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  int ret;
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  ret = nxmutex_lock(&dev->devlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case USRSOCKIOC_KICK:
+        ret = usrsockdev_shm_kick(dev);
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&dev->devlock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_mmap
+ *
+ * Description:
+ *   Map the shared request/response rings.  The first mapping allocates
+ *   the rings, sizing them to fit into the requested length.  Request
+ *   messages are routed through the rings from then on until the device
+ *   is closed.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_mmap(FAR struct file *filep,
+                           FAR struct mm_map_entry_s *map)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  FAR struct usrsock_shm_s *shm;
+  uint32_t size;
+  int ret;
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  if (map->offset != 0)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&dev->devlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (dev->shm == NULL)
+    {
+      if (map->length < USRSOCK_SHM_HDRSIZE + 2 * USRSOCK_SHM_MINRING)
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      /* Use the largest power-of-two rings fitting into the mapping.  The
+       * whole mapping is allocated, so that the daemon can never reach
+       * past the buffer.
+       */
+
+      for (size = USRSOCK_SHM_MINRING;
+           USRSOCK_SHM_HDRSIZE + 4 * (size_t)size <= map->length;
+           size <<= 1);
+
+      shm = kumm_zalloc(map->length);
+      if (shm == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      shm->magic       = USRSOCK_SHM_MAGIC;
+      shm->req.size    = size;
+      shm->req.offset  = USRSOCK_SHM_HDRSIZE;
+      shm->resp.size   = size;
+      shm->resp.offset = USRSOCK_SHM_HDRSIZE + size;
+
+      dev->shm      = shm;
+      dev->shmlen   = map->length;
+      dev->shmsize  = size;
+      dev->reqhead  = 0;
+      dev->resptail = 0;
+    }
+  else if (map->length > dev->shmlen)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  map->vaddr  = dev->shm;
+  map->munmap = usrsockdev_munmap;
+  map->priv.p = dev;
+
+  ret = mm_map_add(get_current_mm(), map);
+  if (ret >= 0)
+    {
+      dev->shmrefs++;
+    }
+  else if (dev->shmrefs == 0)
+    {
+      kumm_free(dev->shm);
+      dev->shm = NULL;
+      dev->shmlen = 0;
+    }
+
+errout:
+  nxmutex_unlock(&dev->devlock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_munmap
+ *
+ * Description:
+ *   Drop one mapping of the rings.  The rings are freed with their last
+ *   mapping, after the device was closed or straight away if the daemon
+ *   unmaps them while the device is still open.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_munmap(FAR struct task_group_s *group,
+                             FAR struct mm_map_entry_s *map,
+                             FAR void *start, size_t length)
+{
+  FAR struct usrsockdev_s *dev = map->priv.p;
+  FAR void *shm = map->vaddr;
+  int ret;
+
+  /* Partial unmap is not supported */
+
+  if (start != map->vaddr || length != map->length)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&dev->devlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  DEBUGASSERT(dev->shmrefs > 0);
+  if (--dev->shmrefs == 0)
+    {
+      if (dev->shm == shm)
+        {
+          /* Fall back to read()/write() for the requests to come */
+
+          usrsockdev_shm_wakeup(dev);
+          dev->shm = NULL;
+          dev->shmlen = 0;
+        }
+
+      kumm_free(shm);
+    }
+
+  nxmutex_unlock(&dev->devlock);
+
+  return mm_map_remove(get_group_mm(group), map);
+}
+
+#endif /* CONFIG_NET_USRSOCK_DEVICE_SHMRING */
+
 /****************************************************************************
  * Name: usrsockdev_poll
  ****************************************************************************/
@@ -458,6 +997,15 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+      /* Or if requests are pending in the request ring. */
+
+      if (dev->shm != NULL && dev->shm->req.tail != dev->reqhead)
+        {
+          eventset |= POLLIN;
+        }
+#endif
+
       poll_notify(dev->pollfds, nitems(dev->pollfds), eventset);
     }
   else
@@ -500,7 +1048,18 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
 
   net_mutex_lock(&dev->devlock);
 
-  if (usrsockdev_is_opened(dev))
+  if (!usrsockdev_is_opened(dev))
+    {
+      ninfo("daemon abruptly closed /dev/usrsock.\n");
+      ret = -ENETDOWN;
+    }
+#ifdef CONFIG_NET_USRSOCK_DEVICE_SHMRING
+  else if (dev->shm != NULL)
+    {
+      ret = usrsockdev_shm_request(dev, iov, iovcnt);
+    }
+#endif
+  else
     {
       DEBUGASSERT(dev->req.iov == NULL);
       dev->req.iov = iov;
@@ -511,11 +1070,6 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
 
       poll_notify(dev->pollfds, nitems(dev->pollfds), POLLIN);
     }
-  else
-    {
-      ninfo("daemon abruptly closed /dev/usrsock.\n");
-      ret = -ENETDOWN;
-    }
 
   nxmutex_unlock(&dev->devlock);
   return ret;
@@ -26,10 +26,15 @@
 #include <errno.h>
 #include <stdio.h>
 
+#include <sys/param.h>
+
+#include <nuttx/arch.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
-#include <nuttx/mutex.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/virtio/virtio.h>
 
 #include "virtio-blk.h"
@@ -57,6 +62,24 @@
 
 #define VIRTIO_BLK_SECTOR_SIZE      512
 
+/* Block device feature bits */
+
+#define VIRTIO_BLK_F_SEG_MAX        (1 << 2)
+#define VIRTIO_BLK_F_MQ             (1 << 12)
+
+#ifdef CONFIG_DRIVERS_VIRTIO_BLK_MQ
+#  define VIRTIO_BLK_FEATURES       (VIRTIO_BLK_F_SEG_MAX | VIRTIO_BLK_F_MQ)
+#  define VIRTIO_BLK_MAX_QUEUES     CONFIG_SMP_NCPUS
+#else
+#  define VIRTIO_BLK_FEATURES       VIRTIO_BLK_F_SEG_MAX
+#  define VIRTIO_BLK_MAX_QUEUES     1
+#endif
+
+/* Requests in flight per virtqueue and data segments merged per request */
+
+#define VIRTIO_BLK_NREQS            CONFIG_DRIVERS_VIRTIO_BLK_NREQS
+#define VIRTIO_BLK_NSEGS            CONFIG_DRIVERS_VIRTIO_BLK_NSEGS
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -105,14 +128,51 @@ begin_packed_struct struct virtio_blk_config_s
   uint32_t secure_erase_sector_alignment;
 } end_packed_struct;
 
+/* One read, write or flush of a block driver caller.  It waits in the
+ * pending queue for a free request slot, adjacent reads or writes waiting
+ * there are merged into the same request.
+ */
+
+struct virtio_blk_io_s
+{
+  sq_entry_t                    node;           /* Pending or slot list */
+  sem_t                         done;           /* Completion */
+  FAR void                     *buffer;         /* Data buffer */
+  uint64_t                      sector;         /* Start sector */
+  unsigned int                  nsectors;       /* Sector number */
+  uint32_t                      type;           /* VIRTIO_BLK_T_xxx */
+  int                           result;         /* OK or -EIO */
+};
+
+/* One request in flight, the cookie given to the virtqueue */
+
+struct virtio_blk_slot_s
+{
+  sq_entry_t                    node;           /* Free slot list */
+  sq_queue_t                    ios;            /* Merged ios, sector order */
+  FAR struct virtio_blk_req_s  *req;            /* Virtio block out header */
+  FAR struct virtio_blk_resp_s *resp;           /* Virtio block in header */
+};
+
+struct virtio_blk_queue_s
+{
+  FAR struct virtqueue         *vq;             /* Request virtqueue */
+  spinlock_t                    lock;           /* Protect vq and lists */
+  sq_queue_t                    pending;        /* ios waiting for a slot */
+  sq_queue_t                    free;           /* Free request slots */
+  struct virtio_blk_slot_s      slot[VIRTIO_BLK_NREQS];
+};
+
 struct virtio_blk_priv_s
 {
   FAR struct virtio_device     *vdev;           /* Virtio deivce */
   FAR struct virtio_blk_req_s  *req;            /* Virtio block out header */
   FAR struct virtio_blk_resp_s *resp;           /* Virtio block in header */
-  mutex_t                       lock;           /* Lock */
   uint64_t                      nsectors;       /* Sectore numbers */
+  int                           nqueues;        /* Virtqueues in use */
+  int                           nsegs;          /* Max segments per request */
   char                          name[NAME_MAX]; /* Device name */
+  struct virtio_blk_queue_s     queue[VIRTIO_BLK_MAX_QUEUES];
 };
 
 /****************************************************************************
@@ -121,6 +181,13 @@ struct virtio_blk_priv_s
 
 /* BLK block_operations functions and they helper function */
 
+static FAR struct virtio_blk_io_s *
+virtio_blk_merge(FAR struct virtio_blk_queue_s *q,
+                 FAR struct virtio_blk_slot_s *slot);
+static void    virtio_blk_dispatch(FAR struct virtio_blk_priv_s *priv,
+                                   FAR struct virtio_blk_queue_s *q);
+static int     virtio_blk_submit(FAR struct virtio_blk_priv_s *priv,
+                                 FAR struct virtio_blk_io_s *io);
 static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
                                FAR void *buffer, blkcnt_t startsector,
                                unsigned int nsectors, bool write);
@@ -176,73 +243,205 @@ static int g_virtio_blk_idx = 0;
  ****************************************************************************/
 
 /****************************************************************************
- * Name: virtio_blk_rdwr
+ * Name: virtio_blk_merge
  *
  * Description:
- *   Common function for read and write
+ *   Take the pending io which continues the request built in slot, if it
+ *   has the same type and starts at the sector where the request ends.
  *
  ****************************************************************************/
 
-static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
-                               FAR void *buffer, blkcnt_t startsector,
-                               unsigned int nsectors, bool write)
+static FAR struct virtio_blk_io_s *
+virtio_blk_merge(FAR struct virtio_blk_queue_s *q,
+                 FAR struct virtio_blk_slot_s *slot)
 {
-  FAR struct virtio_device *vdev = priv->vdev;
-  FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
-  FAR struct virtqueue_buf vb[3];
-  sem_t respsem;
-  ssize_t ret;
-  int readnum;
+  FAR struct virtio_blk_io_s *last =
+    (FAR struct virtio_blk_io_s *)sq_tail(&slot->ios);
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *node;
 
-  ret = nxmutex_lock(&priv->lock);
-  if (ret < 0)
+  if (last->type == VIRTIO_BLK_T_FLUSH)
     {
-      return ret;
+      return NULL;
+    }
+
+  for (node = sq_peek(&q->pending); node != NULL; node = sq_next(node))
+    {
+      FAR struct virtio_blk_io_s *io = (FAR struct virtio_blk_io_s *)node;
+
+      if (io->type == last->type &&
+          io->sector == last->sector + last->nsectors)
+        {
+          if (prev == NULL)
+            {
+              sq_remfirst(&q->pending);
+            }
+          else
+            {
+              sq_remafter(prev, &q->pending);
+            }
+
+          return io;
+        }
+
+      prev = node;
     }
 
-  nxsem_init(&respsem, 0, 0);
+  return NULL;
+}
 
-  /* Build the block request */
+/****************************************************************************
+ * Name: virtio_blk_dispatch
+ *
+ * Description:
+ *   Move the pending ios into free request slots, merging adjacent ones,
+ *   and kick the device once for all the requests added.
+ *
+ * Assumptions:
+ *   The queue lock is held.
+ *
+ ****************************************************************************/
 
-  priv->req->type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
-  priv->req->reserved = 0;
-  priv->req->sector   = startsector;
-  priv->resp->status  = VIRTIO_BLK_S_IOERR;
+static void virtio_blk_dispatch(FAR struct virtio_blk_priv_s *priv,
+                                FAR struct virtio_blk_queue_s *q)
+{
+  struct virtqueue_buf vb[VIRTIO_BLK_NSEGS + 2];
+  FAR struct virtio_blk_slot_s *slot;
+  FAR struct virtio_blk_io_s *io;
+  int submitted = 0;
+  int readnum;
+  int nsegs;
+  int ret;
 
-  /* Fill the virtqueue buffer:
-   * Buffer 0: the block out header;
-   * Buffer 1: the read/write buffer;
-   * Buffer 2: the block in header, return the status.
-   */
+  while (!sq_empty(&q->pending) && !sq_empty(&q->free))
+    {
+      slot = (FAR struct virtio_blk_slot_s *)sq_remfirst(&q->free);
+      io   = (FAR struct virtio_blk_io_s *)sq_remfirst(&q->pending);
+
+      /* Build the block request */
+
+      slot->req->type     = io->type;
+      slot->req->reserved = 0;
+      slot->req->sector   = io->sector;
+      slot->resp->status  = VIRTIO_BLK_S_IOERR;
+
+      /* Fill the virtqueue buffer:
+       * Buffer 0: the block out header;
+       * Buffer 1..n: the read/write buffer of each merged io;
+       * Buffer n+1: the block in header, return the status.
+       */
+
+      vb[0].buf = slot->req;
+      vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
+      nsegs     = 0;
+
+      while (io != NULL)
+        {
+          sq_addlast(&io->node, &slot->ios);
+          if (io->nsectors > 0)
+            {
+              nsegs++;
+              vb[nsegs].buf = io->buffer;
+              vb[nsegs].len = io->nsectors * VIRTIO_BLK_SECTOR_SIZE;
+            }
+
+          io = nsegs < priv->nsegs ? virtio_blk_merge(q, slot) : NULL;
+        }
+
+      vb[nsegs + 1].buf = slot->resp;
+      vb[nsegs + 1].len = VIRTIO_BLK_RESP_HEADER_SIZE;
+
+      readnum = slot->req->type == VIRTIO_BLK_T_IN ? 1 : nsegs + 1;
+      ret = virtqueue_add_buffer(q->vq, vb, readnum, nsegs + 2 - readnum,
+                                 slot);
+      if (ret < 0)
+        {
+          /* The slot number is sized from the ring so this should not
+           * happen, anyway put the ios back and retry on the next
+           * completion.
+           */
+
+          vrterr("virtqueue_add_buffer failed, ret=%d\n", ret);
+          sq_cat(&q->pending, &slot->ios);
+          sq_move(&slot->ios, &q->pending);
+          sq_addfirst(&slot->node, &q->free);
+          break;
+        }
+
+      submitted++;
+    }
 
-  vb[0].buf = priv->req;
-  vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
-  vb[1].buf = buffer;
-  vb[1].len = nsectors * VIRTIO_BLK_SECTOR_SIZE;
-  vb[2].buf = priv->resp;
-  vb[2].len = VIRTIO_BLK_RESP_HEADER_SIZE;
-  readnum = write ? 2 : 1;
-  ret = virtqueue_add_buffer(vq, vb, readnum, 3 - readnum, &respsem);
-  if (ret < 0)
+  if (submitted > 0)
     {
-      vrterr("virtqueue_add_buffer failed, ret=%zd\n", ret);
-      goto err;
+      virtqueue_kick(q->vq);
     }
+}
+
+/****************************************************************************
+ * Name: virtio_blk_submit
+ *
+ * Description:
+ *   Queue an io on the virtqueue of the current CPU and wait for it.  The
+ *   callers don't hold any lock while waiting, so requests from several
+ *   threads are in flight at the same time.
+ *
+ ****************************************************************************/
+
+static int virtio_blk_submit(FAR struct virtio_blk_priv_s *priv,
+                             FAR struct virtio_blk_io_s *io)
+{
+  FAR struct virtio_blk_queue_s *q;
+  irqstate_t flags;
+
+#ifdef CONFIG_DRIVERS_VIRTIO_BLK_MQ
+  q = &priv->queue[up_cpu_index() % priv->nqueues];
+#else
+  q = &priv->queue[0];
+#endif
+
+  nxsem_init(&io->done, 0, 0);
+  io->result = -EIO;
 
-  virtqueue_kick(vq);
+  flags = spin_lock_irqsave(&q->lock);
+  sq_addlast(&io->node, &q->pending);
+  virtio_blk_dispatch(priv, q);
+  spin_unlock_irqrestore(&q->lock, flags);
 
   /* Wait for the request completion */
 
-  nxsem_wait_uninterruptible(&respsem);
-  if (priv->resp->status != VIRTIO_BLK_S_OK)
+  nxsem_wait_uninterruptible(&io->done);
+  nxsem_destroy(&io->done);
+  return io->result;
+}
+
+/****************************************************************************
+ * Name: virtio_blk_rdwr
+ *
+ * Description:
+ *   Common function for read and write
+ *
+ ****************************************************************************/
+
+static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
+                               FAR void *buffer, blkcnt_t startsector,
+                               unsigned int nsectors, bool write)
+{
+  struct virtio_blk_io_s io;
+  int ret;
+
+  io.buffer   = buffer;
+  io.sector   = startsector;
+  io.nsectors = nsectors;
+  io.type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
+
+  ret = virtio_blk_submit(priv, &io);
+  if (ret < 0)
     {
       vrterr("%s Error\n", write ? "Write" : "Read");
-      ret = -EIO;
+      return ret;
     }
 
-err:
-  nxmutex_unlock(&priv->lock);
-  return ret >= 0 ? nsectors : ret;
+  return nsectors;
 }
 
 /****************************************************************************
@@ -342,55 +541,25 @@ static int virtio_blk_geometry(FAR struct inode *inode,
 }
 
 /****************************************************************************
- * Name: virtio_blk_ioctl
+ * Name: virtio_blk_flush
  ****************************************************************************/
 
 static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
 {
-  FAR struct virtio_device *vdev = priv->vdev;
-  FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
-  FAR struct virtqueue_buf vb[2];
-  sem_t respsem;
+  struct virtio_blk_io_s io;
   int ret;
 
-  ret = nxmutex_lock(&priv->lock);
-  if (ret < 0)
-    {
-      return ret;
-    }
+  io.buffer   = NULL;
+  io.sector   = 0;
+  io.nsectors = 0;
+  io.type     = VIRTIO_BLK_T_FLUSH;
 
-  nxsem_init(&respsem, 0, 0);
-
-  /* Build the block request */
-
-  priv->req->type     = VIRTIO_BLK_T_FLUSH;
-  priv->req->reserved = 0;
-  priv->req->sector   = 0;
-  priv->resp->status  = VIRTIO_BLK_S_IOERR;
-
-  vb[0].buf = priv->req;
-  vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
-  vb[1].buf = priv->resp;
-  vb[1].len = VIRTIO_BLK_RESP_HEADER_SIZE;
-  ret = virtqueue_add_buffer(vq, vb, 1, 1, &respsem);
+  ret = virtio_blk_submit(priv, &io);
   if (ret < 0)
-    {
-      goto err;
-    }
-
-  virtqueue_kick(vq);
-
-  /* Wait for the request completion */
-
-  nxsem_wait_uninterruptible(&respsem);
-  if (priv->resp->status != VIRTIO_BLK_S_OK)
     {
       vrterr("Flush Error\n");
-      ret = -EIO;
     }
 
-err:
-  nxmutex_unlock(&priv->lock);
   return ret;
 }
 
@@ -423,12 +592,40 @@ static int virtio_blk_ioctl(FAR struct inode *inode, int cmd,
 
 static void virtio_blk_done(FAR struct virtqueue *vq)
 {
-  FAR sem_t *respsem;
+  FAR struct virtio_blk_priv_s *priv = vq->vq_dev->priv;
+  FAR struct virtio_blk_queue_s *q = &priv->queue[vq->vq_queue_index];
+  FAR struct virtio_blk_slot_s *slot;
+  FAR struct virtio_blk_io_s *io;
+  sq_queue_t done;
+  irqstate_t flags;
+  int result;
+
+  sq_init(&done);
+
+  flags = spin_lock_irqsave(&q->lock);
+  while ((slot = virtqueue_get_buffer(vq, NULL, NULL)) != NULL)
+    {
+      result = slot->resp->status == VIRTIO_BLK_S_OK ? OK : -EIO;
+      while ((io = (FAR struct virtio_blk_io_s *)
+                   sq_remfirst(&slot->ios)) != NULL)
+        {
+          io->result = result;
+          sq_addlast(&io->node, &done);
+        }
+
+      sq_addlast(&slot->node, &q->free);
+    }
+
+  /* Reuse the freed slots for the ios waiting meanwhile */
+
+  virtio_blk_dispatch(priv, q);
+  spin_unlock_irqrestore(&q->lock, flags);
 
-  respsem = virtqueue_get_buffer(vq, NULL, NULL);
-  if (respsem != NULL)
+  /* Wake up the callers outside of the lock, io is gone after the post */
+
+  while ((io = (FAR struct virtio_blk_io_s *)sq_remfirst(&done)) != NULL)
     {
-      nxsem_post(respsem);
+      nxsem_post(&io->done);
     }
 }
 
@@ -439,55 +636,128 @@ static void virtio_blk_done(FAR struct virtqueue *vq)
 static int virtio_blk_init(FAR struct virtio_blk_priv_s *priv,
                            FAR struct virtio_device *vdev)
 {
-  FAR const char *vqname[1];
-  vq_callback callback[1];
+  FAR const char *vqname[VIRTIO_BLK_MAX_QUEUES];
+  vq_callback callback[VIRTIO_BLK_MAX_QUEUES];
+  FAR struct virtio_blk_queue_s *q;
+  uint32_t features;
+  uint32_t segmax;
+  int nslots;
   int ret;
+  int i;
+  int j;
+#ifdef CONFIG_DRIVERS_VIRTIO_BLK_MQ
+  uint16_t nqueues;
+#endif
 
   priv->vdev = vdev;
   vdev->priv = priv;
-  nxmutex_init(&priv->lock);
 
-  /* Alloc the request and in header from tansport layer */
+  /* Initialize the virtio device */
+
+  virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
+  features = virtio_get_features(vdev) & VIRTIO_BLK_FEATURES;
+  virtio_set_features(vdev, features);
+  virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
+
+  /* Limit the merged segments to what the device takes per request */
 
-  priv->req = virtio_alloc_buf(vdev, sizeof(*priv->req), 16);
+  priv->nsegs = VIRTIO_BLK_NSEGS;
+  if ((features & VIRTIO_BLK_F_SEG_MAX) != 0)
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s, seg_max,
+                                &segmax);
+      if (segmax > 0)
+        {
+          priv->nsegs = MIN(priv->nsegs, segmax);
+        }
+    }
+
+  /* Use one virtqueue per CPU if the device has enough of them */
+
+  priv->nqueues = 1;
+#ifdef CONFIG_DRIVERS_VIRTIO_BLK_MQ
+  if ((features & VIRTIO_BLK_F_MQ) != 0)
+    {
+      virtio_read_config_member(vdev, struct virtio_blk_config_s,
+                                num_queues, &nqueues);
+      priv->nqueues = MAX(MIN(nqueues, VIRTIO_BLK_MAX_QUEUES), 1);
+    }
+#endif
+
+  for (i = 0; i < priv->nqueues; i++)
+    {
+      vqname[i]   = "virtio_blk_vq";
+      callback[i] = virtio_blk_done;
+    }
+
+  ret = virtio_create_virtqueues(vdev, 0, priv->nqueues, vqname, callback);
+  if (ret < 0)
+    {
+      vrterr("virtio_device_create_virtqueue failed, ret=%d\n", ret);
+      return ret;
+    }
+
+  /* Alloc the request and in header from tansport layer, one per request
+   * slot.  Every request takes at most nsegs + 2 descriptors, so that
+   * many slots always fit in the ring.
+   */
+
+  nslots = VIRTIO_BLK_NREQS;
+  for (i = 0; i < priv->nqueues; i++)
+    {
+      nslots = MIN(nslots, vdev->vrings_info[i].info.num_descs /
+                           (priv->nsegs + 2));
+    }
+
+  nslots = MAX(nslots, 1);
+
+  priv->req = virtio_alloc_buf(vdev, sizeof(*priv->req) * nslots *
+                               priv->nqueues, 16);
   if (priv->req == NULL)
     {
       ret = -ENOMEM;
-      goto err_with_lock;
+      goto err_with_virtqueues;
     }
 
-  priv->resp = virtio_alloc_buf(vdev, sizeof(*priv->resp), 16);
+  priv->resp = virtio_alloc_buf(vdev, sizeof(*priv->resp) * nslots *
+                                priv->nqueues, 16);
   if (priv->resp == NULL)
     {
       ret = -ENOMEM;
       goto err_with_req;
     }
 
-  /* Initialize the virtio device */
-
-  virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
-  virtio_set_features(vdev, 0);
-  virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
-
-  vqname[0]   = "virtio_blk_vq";
-  callback[0] = virtio_blk_done;
-  ret = virtio_create_virtqueues(vdev, 0, 1, vqname, callback);
-  if (ret < 0)
+  for (i = 0; i < priv->nqueues; i++)
     {
-      vrterr("virtio_device_create_virtqueue failed, ret=%d\n", ret);
-      goto err_with_resp;
+      q = &priv->queue[i];
+      q->vq = vdev->vrings_info[i].vq;
+      sq_init(&q->pending);
+      sq_init(&q->free);
+
+      for (j = 0; j < nslots; j++)
+        {
+          q->slot[j].req  = &priv->req[i * nslots + j];
+          q->slot[j].resp = &priv->resp[i * nslots + j];
+          sq_init(&q->slot[j].ios);
+          sq_addlast(&q->slot[j].node, &q->free);
+        }
     }
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
-  virtqueue_enable_cb(vdev->vrings_info[0].vq);
+  for (i = 0; i < priv->nqueues; i++)
+    {
+      virtqueue_enable_cb(priv->queue[i].vq);
+    }
+
+  vrtinfo("Virtio blk queues=%d slots=%d segs=%d\n",
+          priv->nqueues, nslots, priv->nsegs);
   return OK;
 
-err_with_resp:
-  virtio_free_buf(vdev, priv->resp);
 err_with_req:
   virtio_free_buf(vdev, priv->req);
-err_with_lock:
-  nxmutex_destroy(&priv->lock);
+err_with_virtqueues:
+  virtio_reset_device(vdev);
+  virtio_delete_virtqueues(vdev);
   return ret;
 }
 
@@ -503,7 +773,6 @@ static void virtio_blk_uninit(FAR struct virtio_blk_priv_s *priv)
   virtio_delete_virtqueues(vdev);
   virtio_free_buf(vdev, priv->resp);
   virtio_free_buf(vdev, priv->req);
-  nxmutex_destroy(&priv->lock);
 }
 
 /****************************************************************************
@@ -27,10 +27,14 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <sys/param.h>
+
+#include <nuttx/arch.h>
 #include <nuttx/compiler.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev_lowerhalf.h>
+#include <nuttx/signal.h>
 #include <nuttx/virtio/virtio.h>
 
 #include "virtio-net.h"
@@ -45,12 +49,63 @@
 #define VIRTIO_NET_LLHDRSIZE  (sizeof(struct virtio_net_llhdr_s))
 #define VIRTIO_NET_BUFSIZE    (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE)
 
-/* Virtio net virtqueue index and number */
+/* Virtio net virtqueue index and number, queue pair p uses the virtqueues
+ * VIRTIO_NET_RXQ(p) and VIRTIO_NET_TXQ(p), the control virtqueue follows
+ * the last queue pair.
+ */
 
 #define VIRTIO_NET_RX         0
 #define VIRTIO_NET_TX         1
 #define VIRTIO_NET_NUM        2
 
+#define VIRTIO_NET_RXQ(p)     ((p) * VIRTIO_NET_NUM + VIRTIO_NET_RX)
+#define VIRTIO_NET_TXQ(p)     ((p) * VIRTIO_NET_NUM + VIRTIO_NET_TX)
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+#  define VIRTIO_NET_MAX_PAIRS CONFIG_SMP_NCPUS
+#else
+#  define VIRTIO_NET_MAX_PAIRS 1
+#endif
+
+#define VIRTIO_NET_MAX_VQS    (VIRTIO_NET_MAX_PAIRS * VIRTIO_NET_NUM + 1)
+
+/* Virtio net feature bits */
+
+#define VIRTIO_NET_F_CTRL_VQ  (1 << 17)
+#define VIRTIO_NET_F_MQ       (1 << 22)
+
+/* Features this driver can handle.  The checksum and TSO offloads are not
+ * requested: the network stack always computes checksums itself, never
+ * builds segments larger than the MTU and cannot take partially
+ * checksummed frames.
+ */
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_EVENT_IDX
+#  define VIRTIO_NET_RING_FEATURES  VIRTIO_RING_F_EVENT_IDX
+#else
+#  define VIRTIO_NET_RING_FEATURES  0
+#endif
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+#  define VIRTIO_NET_FEATURES (VIRTIO_NET_RING_FEATURES | \
+                               VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ)
+#else
+#  define VIRTIO_NET_FEATURES VIRTIO_NET_RING_FEATURES
+#endif
+
+/* Control virtqueue command, see struct virtio_net_ctrl_mq_s */
+
+#define VIRTIO_NET_CTRL_MQ    4
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET 0
+
+#define VIRTIO_NET_OK         0
+#define VIRTIO_NET_ERR        1
+
+/* Wait up to 100ms for the device to complete a control command */
+
+#define VIRTIO_NET_CTRL_DELAY 1000
+#define VIRTIO_NET_CTRL_RETRY 100
+
 #define VIRTIO_NET_MAX_PKT_SIZE \
     ((CONFIG_NET_LL_GUARDSIZE - ETH_HDRLEN) + VIRTIO_NET_BUFSIZE)
 #define VIRTIO_NET_MAX_NIOB \
@@ -74,6 +129,38 @@ begin_packed_struct struct virtio_net_hdr_s
   uint16_t csum_offset;
 } end_packed_struct;
 
+/* Virtio net device configuration layout */
+
+begin_packed_struct struct virtio_net_config_s
+{
+  uint8_t  mac[6];
+  uint16_t status;
+  uint16_t max_virtqueue_pairs;
+} end_packed_struct;
+
+/* Control virtqueue message for VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET, the
+ * class/cmd header and the pair number are read by the device, the ack is
+ * written back.
+ */
+
+begin_packed_struct struct virtio_net_ctrl_mq_s
+{
+  uint8_t  class;
+  uint8_t  cmd;
+  uint16_t pairs;
+  uint8_t  ack;
+} end_packed_struct;
+
+/* One RX/TX virtqueue pair */
+
+struct virtio_net_queue_s
+{
+  FAR struct virtqueue *rxq;           /* RX virtqueue */
+  FAR struct virtqueue *txq;           /* TX virtqueue */
+  int                   rxposted;      /* RX buffers owned by the device */
+  int                   txposted;      /* TX buffers not reclaimed yet */
+};
+
 struct virtio_net_priv_s
 {
   /* This holds the information visible to the NuttX network */
@@ -83,7 +170,11 @@ struct virtio_net_priv_s
   /* Virtio device information */
 
   FAR struct virtio_device *vdev;      /* Virtio device pointer */
-  int                       bufnum;    /* TX and RX Buffer number */
+  int                       bufnum;    /* TX and RX Buffer number per pair */
+  int                       batch;     /* Refill/reclaim batch size */
+  int                       npairs;    /* Number of queue pairs in use */
+  int                       rxnext;    /* Queue pair recv() drains next */
+  struct virtio_net_queue_s queue[VIRTIO_NET_MAX_PAIRS];
 };
 
 /* Virtio Link Layer Header, follow shows the iob buffer layout:
@@ -166,27 +257,40 @@ static const struct netdev_ops_s g_virtio_net_ops =
 
 /****************************************************************************
  * Name: virtio_net_rxfill
+ *
+ * Description:
+ *   Post free RX netpkts to the RX virtqueue of a queue pair.  The refill
+ *   is deferred until at least one batch of buffers has been consumed, so
+ *   the descriptors are published and the device kicked once per batch
+ *   rather than once per received packet.
+ *
  ****************************************************************************/
 
-static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_rxfill(FAR struct virtio_net_priv_s *priv,
+                              FAR struct virtio_net_queue_s *q)
 {
-  FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
+  FAR struct netdev_lowerhalf_s *dev = &priv->lower;
   FAR struct virtio_net_llhdr_s *hdr;
   struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB];
   struct iovec iov[VIRTIO_NET_MAX_NIOB];
   FAR netpkt_t *pkt;
   int iov_cnt;
+  int n = 0;
   int i;
 
-  for (i = 0; i < priv->bufnum; i++)
+  if (q->rxposted > priv->bufnum - priv->batch)
+    {
+      return;
+    }
+
+  while (q->rxposted < priv->bufnum)
     {
       /* IOB Offload, Alloc buffer from RX netpkt */
 
       pkt = netpkt_alloc(dev, NETPKT_RX);
       if (pkt == NULL)
         {
-          vrtinfo("Has ran out of the RX buffer, i=%d\n", i);
+          vrtinfo("Has ran out of the RX buffer, n=%d\n", n);
           break;
         }
 
@@ -195,7 +299,7 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
       if (netpkt_setdatalen(dev, pkt, VIRTIO_NET_BUFSIZE) <
           VIRTIO_NET_BUFSIZE)
         {
-          vrtwarn("No enough buffer to prepare RX buffer, i=%d\n", i);
+          vrtwarn("No enough buffer to prepare RX buffer, n=%d\n", n);
           netpkt_free(dev, pkt, NETPKT_RX);
           break;
         }
@@ -223,40 +327,61 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
       vb[0].len += VIRTIO_NET_HDRSIZE;
 
       vrtinfo("Fill rx, hdr=%p, count=%d\n", hdr, iov_cnt);
-      virtqueue_add_buffer(vq, vb, 0, iov_cnt, hdr);
+      virtqueue_add_buffer(q->rxq, vb, 0, iov_cnt, hdr);
+      q->rxposted++;
+      n++;
     }
 
-  if (i > 0)
+  if (n > 0)
     {
-      virtqueue_kick(vq);
+      virtqueue_kick(q->rxq);
     }
 }
 
 /****************************************************************************
  * Name: virtio_net_txfree
+ *
+ * Description:
+ *   Return all the TX netpkts the device has consumed from the TX
+ *   virtqueue of a queue pair to the upper-half.
+ *
  ****************************************************************************/
 
-static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_txfree(FAR struct virtio_net_priv_s *priv,
+                              FAR struct virtio_net_queue_s *q)
 {
-  FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
   FAR struct virtio_net_llhdr_s *hdr;
 
-  while (1)
+  while (q->txposted > 0)
     {
       /* Get buffer from tx virtqueue */
 
-      hdr = virtqueue_get_buffer(vq, NULL, NULL);
+      hdr = virtqueue_get_buffer(q->txq, NULL, NULL);
       if (hdr == NULL)
         {
           break;
         }
 
-      netpkt_free(dev, hdr->pkt, NETPKT_TX);
+      q->txposted--;
+      netpkt_free(&priv->lower, hdr->pkt, NETPKT_TX);
       vrtinfo("Free, hdr: %p, pkt: %p\n", hdr, hdr->pkt);
     }
 }
 
+/****************************************************************************
+ * Name: virtio_net_txfree_all
+ ****************************************************************************/
+
+static void virtio_net_txfree_all(FAR struct virtio_net_priv_s *priv)
+{
+  int i;
+
+  for (i = 0; i < priv->npairs; i++)
+    {
+      virtio_net_txfree(priv, &priv->queue[i]);
+    }
+}
+
 /****************************************************************************
  * Name: virtio_net_ifup
  ****************************************************************************/
@@ -264,6 +389,8 @@ static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
 static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
+  FAR struct virtio_net_queue_s *q;
+  int i;
 
 #ifdef CONFIG_NET_IPv4
   vrtinfo("Bringing up: %u.%u.%u.%u\n",
@@ -280,8 +407,12 @@ static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 
   /* Prepare interrupt and packets for receiving */
 
-  virtqueue_enable_cb(priv->vdev->vrings_info[VIRTIO_NET_RX].vq);
-  virtio_net_rxfill(dev);
+  for (i = 0; i < priv->npairs; i++)
+    {
+      q = &priv->queue[i];
+      virtqueue_enable_cb(q->rxq);
+      virtio_net_rxfill(priv, q);
+    }
 
   return netdev_lower_carrier_on(dev);
 }
@@ -297,9 +428,10 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev)
 
   /* Disable the Ethernet interrupt */
 
-  for (i = 0; i < VIRTIO_NET_NUM; i++)
+  for (i = 0; i < priv->npairs; i++)
     {
-      virtqueue_disable_cb(priv->vdev->vrings_info[i].vq);
+      virtqueue_disable_cb(priv->queue[i].rxq);
+      virtqueue_disable_cb(priv->queue[i].txq);
     }
 
   return netdev_lower_carrier_off(dev);
@@ -313,7 +445,7 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
                            FAR netpkt_t *pkt)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
+  FAR struct virtio_net_queue_s *q;
   FAR struct virtio_net_llhdr_s *hdr;
   struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB];
   struct iovec iov[VIRTIO_NET_MAX_NIOB];
@@ -328,6 +460,14 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
       return -EINVAL;
     }
 
+  /* Transmit on the queue pair of the current CPU */
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+  q = &priv->queue[up_cpu_index() % priv->npairs];
+#else
+  q = &priv->queue[0];
+#endif
+
   /* Convert netpkt to virtqueue_buf */
 
   iov_cnt = netpkt_to_iov(dev, pkt, iov, VIRTIO_NET_MAX_NIOB);
@@ -350,21 +490,37 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
   vb[0].buf = &hdr->vhdr;
   vb[0].len += VIRTIO_NET_HDRSIZE;
 
-  /* Add buffer to vq and notify the other side */
+  /* Add buffer to vq and notify the other side, the notification is
+   * skipped by virtqueue_kick() while the device is still busy with the
+   * ring if VIRTIO_RING_F_EVENT_IDX is negotiated.
+   */
 
   vrtinfo("Send, hdr=%p, count=%d\n", hdr, iov_cnt);
-  virtqueue_add_buffer(vq, vb, iov_cnt, 0, hdr);
-  virtqueue_kick(vq);
+  virtqueue_add_buffer(q->txq, vb, iov_cnt, 0, hdr);
+  virtqueue_kick(q->txq);
+  q->txposted++;
 
-  /* Try return Netpkt TX buffer to upper-half. */
+  /* Reclaim the consumed TX buffers in batches, reading the used ring on
+   * every packet would only bounce its cache line with the device.
+   */
 
-  virtio_net_txfree(dev);
+  if (q->txposted >= priv->batch ||
+      netdev_lower_quota_load(dev, NETPKT_TX) <= 0)
+    {
+      virtio_net_txfree(priv, q);
+    }
 
   /* If we have no buffer left, enable TX done callback. */
 
   if (netdev_lower_quota_load(dev, NETPKT_TX) <= 0)
     {
-      virtqueue_enable_cb(vq);
+      for (i = 0; i < priv->npairs; i++)
+        {
+          if (priv->queue[i].txposted > 0)
+            {
+              virtqueue_enable_cb(priv->queue[i].txq);
+            }
+        }
     }
 
   return OK;
@@ -377,40 +533,63 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
 static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
+  FAR struct virtio_net_queue_s *q;
   FAR struct virtio_net_llhdr_s *hdr;
   uint32_t len;
+  int i;
 
-  /* Fill the free Netpkt RX buffer to the RX virtqueue */
+  /* Drain the queue pairs round robin, one pair until it is empty */
 
-  virtio_net_rxfill(dev);
+  for (i = 0; i < priv->npairs; i++)
+    {
+      q = &priv->queue[priv->rxnext];
 
-  /* Get received buffer form RX virtqueue */
+      /* Fill the free Netpkt RX buffer to the RX virtqueue */
 
-  hdr = virtqueue_get_buffer(vq, &len, NULL);
-  if (hdr == NULL)
-    {
-      /* If we have no buffer left, enable RX callback. */
+      virtio_net_rxfill(priv, q);
+
+      /* Get received buffer form RX virtqueue */
+
+      hdr = virtqueue_get_buffer(q->rxq, &len, NULL);
+      if (hdr == NULL)
+        {
+          /* If we have no buffer left, enable RX callback and look again
+           * to catch the packets that arrived before it was enabled.
+           */
+
+          virtqueue_enable_cb(q->rxq);
+          hdr = virtqueue_get_buffer(q->rxq, &len, NULL);
+          if (hdr != NULL)
+            {
+              virtqueue_disable_cb(q->rxq);
+            }
+        }
 
-      virtqueue_enable_cb(vq);
+      if (hdr != NULL)
+        {
+          q->rxposted--;
 
-      /* We do transmit after recv, now it's time to free TX buffer.
-       * Depends on upper-half order (Call TX after RX).
-       *
-       * TODO: Find a better way to free TX buffer.
-       */
+          /* Set the received pkt length */
 
-      virtio_net_txfree(&priv->lower);
+          netpkt_setdatalen(dev, hdr->pkt, len - VIRTIO_NET_HDRSIZE);
+          vrtinfo("Recv, hdr=%p, pkt=%p, len=%" PRIu32 "\n",
+                  hdr, hdr->pkt, len);
+          return hdr->pkt;
+        }
 
-      vrtinfo("get NULL buffer\n");
-      return NULL;
+      priv->rxnext = (priv->rxnext + 1) % priv->npairs;
     }
 
-  /* Set the received pkt length */
+  /* We do transmit after recv, now it's time to free TX buffer.
+   * Depends on upper-half order (Call TX after RX).
+   *
+   * TODO: Find a better way to free TX buffer.
+   */
+
+  virtio_net_txfree_all(priv);
 
-  netpkt_setdatalen(dev, hdr->pkt, len - VIRTIO_NET_HDRSIZE);
-  vrtinfo("Recv, hdr=%p, pkt=%p, len=%" PRIu32 "\n", hdr, hdr->pkt, len);
-  return hdr->pkt;
+  vrtinfo("get NULL buffer\n");
+  return NULL;
 }
 
 #ifdef CONFIG_NET_MCASTGROUP
@@ -470,6 +649,108 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
   netdev_lower_txdone(&priv->lower);
 }
 
+/****************************************************************************
+ * Name: virtio_net_features
+ *
+ * Description:
+ *   Select the features to negotiate with the device and the number of
+ *   queue pairs to use.  Multi-queue is only used if the device offers no
+ *   more queue pairs than we have CPUs, the control virtqueue index is
+ *   derived from the pair number offered.
+ *
+ ****************************************************************************/
+
+static uint32_t virtio_net_features(FAR struct virtio_net_priv_s *priv)
+{
+  FAR struct virtio_device *vdev = priv->vdev;
+  uint32_t features;
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+  uint16_t pairs;
+#endif
+
+  features = virtio_get_features(vdev) & VIRTIO_NET_FEATURES;
+  priv->npairs = 1;
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+  if ((features & VIRTIO_NET_F_MQ) != 0 &&
+      (features & VIRTIO_NET_F_CTRL_VQ) != 0)
+    {
+      virtio_read_config_member(vdev, struct virtio_net_config_s,
+                                max_virtqueue_pairs, &pairs);
+      if (pairs > 1 && pairs <= VIRTIO_NET_MAX_PAIRS)
+        {
+          priv->npairs = pairs;
+          return features;
+        }
+
+      vrtinfo("Ignore %u queue pairs, use one\n", pairs);
+    }
+
+  features &= ~(VIRTIO_NET_F_MQ | VIRTIO_NET_F_CTRL_VQ);
+#endif
+
+  return features;
+}
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+/****************************************************************************
+ * Name: virtio_net_set_pairs
+ *
+ * Description:
+ *   Tell the device how many queue pairs to use, it only uses the first
+ *   pair until this command succeeds.
+ *
+ ****************************************************************************/
+
+static int virtio_net_set_pairs(FAR struct virtio_net_priv_s *priv,
+                                FAR struct virtqueue *vq)
+{
+  FAR struct virtio_net_ctrl_mq_s *msg;
+  struct virtqueue_buf vb[3];
+  int retry;
+
+  msg = virtio_zalloc_buf(priv->vdev, sizeof(*msg), 16);
+  if (msg == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  msg->class = VIRTIO_NET_CTRL_MQ;
+  msg->cmd   = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+  msg->pairs = priv->npairs;
+  msg->ack   = VIRTIO_NET_ERR;
+
+  vb[0].buf  = &msg->class;
+  vb[0].len  = sizeof(msg->class) + sizeof(msg->cmd);
+  vb[1].buf  = &msg->pairs;
+  vb[1].len  = sizeof(msg->pairs);
+  vb[2].buf  = &msg->ack;
+  vb[2].len  = sizeof(msg->ack);
+
+  virtqueue_add_buffer(vq, vb, 2, 1, msg);
+  virtqueue_kick(vq);
+
+  /* The control virtqueue has no callback, poll for the completion */
+
+  for (retry = 0; retry < VIRTIO_NET_CTRL_RETRY; retry++)
+    {
+      if (virtqueue_get_buffer(vq, NULL, NULL) != NULL)
+        {
+          int ret = msg->ack == VIRTIO_NET_OK ? OK : -EIO;
+
+          virtio_free_buf(priv->vdev, msg);
+          return ret;
+        }
+
+      nxsig_usleep(VIRTIO_NET_CTRL_DELAY);
+    }
+
+  /* The device still owns the message, leave it alone */
+
+  return -ETIMEDOUT;
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_init
  ****************************************************************************/
@@ -477,9 +758,12 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
 static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
                            FAR struct virtio_device *vdev)
 {
-  FAR const char *vqnames[VIRTIO_NET_NUM];
-  vq_callback callbacks[VIRTIO_NET_NUM];
+  FAR const char *vqnames[VIRTIO_NET_MAX_VQS];
+  vq_callback callbacks[VIRTIO_NET_MAX_VQS];
+  uint32_t features;
+  int nvqs;
   int ret;
+  int i;
 
   priv->vdev = vdev;
   vdev->priv = priv;
@@ -487,15 +771,27 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
-  virtio_set_features(vdev, 0);
+  features = virtio_net_features(priv);
+  virtio_set_features(vdev, features);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
-  vqnames[VIRTIO_NET_RX]   = "virtio_net_rx";
-  vqnames[VIRTIO_NET_TX]   = "virtio_net_tx";
-  callbacks[VIRTIO_NET_RX] = virtio_net_rxready;
-  callbacks[VIRTIO_NET_TX] = virtio_net_txdone;
-  ret = virtio_create_virtqueues(vdev, 0, VIRTIO_NET_NUM, vqnames,
-                                 callbacks);
+  nvqs = priv->npairs * VIRTIO_NET_NUM;
+  for (i = 0; i < priv->npairs; i++)
+    {
+      vqnames[VIRTIO_NET_RXQ(i)]   = "virtio_net_rx";
+      vqnames[VIRTIO_NET_TXQ(i)]   = "virtio_net_tx";
+      callbacks[VIRTIO_NET_RXQ(i)] = virtio_net_rxready;
+      callbacks[VIRTIO_NET_TXQ(i)] = virtio_net_txdone;
+    }
+
+  if ((features & VIRTIO_NET_F_CTRL_VQ) != 0)
+    {
+      vqnames[nvqs]   = "virtio_net_ctrl";
+      callbacks[nvqs] = NULL;
+      nvqs++;
+    }
+
+  ret = virtio_create_virtqueues(vdev, 0, nvqs, vqnames, callbacks);
   if (ret < 0)
     {
       vrterr("virtio_device_create_virtqueue failed, ret=%d\n", ret);
@@ -504,19 +800,46 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
 
+  for (i = 0; i < priv->npairs; i++)
+    {
+      priv->queue[i].rxq = vdev->vrings_info[VIRTIO_NET_RXQ(i)].vq;
+      priv->queue[i].txq = vdev->vrings_info[VIRTIO_NET_TXQ(i)].vq;
+    }
+
+#ifdef CONFIG_DRIVERS_VIRTIO_NET_MQ
+  if (priv->npairs > 1)
+    {
+      ret = virtio_net_set_pairs(priv, vdev->vrings_info[nvqs - 1].vq);
+      if (ret < 0)
+        {
+          vrtwarn("Set %d queue pairs failed, ret=%d\n", priv->npairs, ret);
+          priv->npairs = 1;
+        }
+    }
+#endif
+
 #if CONFIG_DRIVERS_VIRTIO_NET_BUFNUM > 0
   priv->bufnum = CONFIG_DRIVERS_VIRTIO_NET_BUFNUM;
 #else
   /* Calculate the virtio network buffer number:
-   * 1/4 for the TX netpkts, 1/4 for the RX netpkts.
+   * 1/4 for the TX netpkts, 1/4 for the RX netpkts, shared by the pairs.
    */
 
-  priv->bufnum = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4;
+  priv->bufnum = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4 /
+                 priv->npairs;
+  priv->bufnum = MAX(priv->bufnum, 1);
 #endif
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_RX].info.num_descs,
-                     priv->bufnum);
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TX].info.num_descs,
-                     priv->bufnum);
+  for (i = 0; i < priv->npairs; i++)
+    {
+      priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_RXQ(i)].info.num_descs,
+                         priv->bufnum);
+      priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TXQ(i)].info.num_descs,
+                         priv->bufnum);
+    }
+
+  /* Refill and reclaim once half of the buffers are used */
+
+  priv->batch = MAX(priv->bufnum / 2, 1);
   return OK;
 }
 
@@ -547,8 +870,8 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
   /* Initialize the netdev lower half */
 
   netdev = &priv->lower;
-  netdev->quota[NETPKT_RX] = priv->bufnum;
-  netdev->quota[NETPKT_TX] = priv->bufnum;
+  netdev->quota[NETPKT_RX] = priv->bufnum * priv->npairs;
+  netdev->quota[NETPKT_TX] = priv->bufnum * priv->npairs;
   netdev->ops = &g_virtio_net_ops;
 
   /* Register the net deivce */
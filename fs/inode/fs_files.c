@@ -34,6 +34,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/mutex.h>
 #include <nuttx/sched.h>
 
@@ -153,6 +154,10 @@ void files_initlist(FAR struct filelist *list)
   /* Initialize the list access mutex */
 
   nxmutex_init(&list->fl_lock);
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_bind_sem(&list->fl_lock.sem, "filelist");
+#endif
 }
 
 /****************************************************************************
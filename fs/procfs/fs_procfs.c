@@ -59,12 +59,16 @@ extern const struct procfs_operations g_critmon_operations;
 extern const struct procfs_operations g_fdt_operations;
 extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
+extern const struct procfs_operations g_latency_operations;
+extern const struct procfs_operations g_lockstat_operations;
 extern const struct procfs_operations g_meminfo_operations;
 extern const struct procfs_operations g_memdump_operations;
 extern const struct procfs_operations g_mempool_operations;
+extern const struct procfs_operations g_memprofile_operations;
 extern const struct procfs_operations g_module_operations;
 extern const struct procfs_operations g_pm_operations;
 extern const struct procfs_operations g_proc_operations;
+extern const struct procfs_operations g_profile_operations;
 extern const struct procfs_operations g_tcbinfo_operations;
 extern const struct procfs_operations g_uptime_operations;
 extern const struct procfs_operations g_version_operations;
@@ -142,6 +146,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",         &g_irq_operations,      PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_LATENCY) && !defined(CONFIG_FS_PROCFS_EXCLUDE_LATENCY)
+  { "latency",      &g_latency_operations,  PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_SCHED_LOCKSTAT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_LOCKSTAT)
+  { "lockstat",     &g_lockstat_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
 #  ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
   { "memdump",      &g_memdump_operations,  PROCFS_FILE_TYPE   },
@@ -153,6 +165,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "mempool",      &g_mempool_operations,  PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_MM_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPROFILE)
+  { "memprofile",   &g_memprofile_operations, PROCFS_FILE_TYPE },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",      &g_module_operations,   PROCFS_FILE_TYPE   },
 #endif
@@ -175,6 +191,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "pm/**",        &g_pm_operations,       PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+  { "profile",      &g_profile_operations,  PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_PROCESS
   { "self",         &g_proc_operations,     PROCFS_DIR_TYPE    },
   { "self/**",      &g_proc_operations,     PROCFS_UNKOWN_TYPE },
@@ -0,0 +1,418 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslatency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched_latency.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_LATENCY) && !defined(CONFIG_FS_PROCFS_EXCLUDE_LATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.  A bucket takes up to
+ * 32 characters.
+ */
+
+#define LATENCY_LINELEN (64 + 32 * CONFIG_SCHED_LATENCY_NBUCKETS)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct latency_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[LATENCY_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     latency_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     latency_close(FAR struct file *filep);
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     latency_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     latency_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_latency_operations =
+{
+  latency_open,   /* open */
+  latency_close,  /* close */
+  latency_read,   /* read */
+  latency_write,  /* write */
+  latency_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  latency_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_open
+ ****************************************************************************/
+
+static int latency_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct latency_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = kmm_zalloc(sizeof(struct latency_file_s));
+  if (procfile == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_close
+ ****************************************************************************/
+
+static int latency_close(FAR struct file *filep)
+{
+  FAR struct latency_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_nsec
+ *
+ * Description:
+ *   Convert perf_gettime() counts to nanoseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t latency_nsec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: latency_hist_line
+ *
+ * Description:
+ *   Format one histogram as "cpu kind id count max bound:samples...".
+ *   Only the buckets with samples are printed.  Each is labelled with its
+ *   exclusive upper bound in nanoseconds, or "inf" for the last bucket.
+ *
+ ****************************************************************************/
+
+static size_t latency_hist_line(FAR struct latency_file_s *procfile,
+                                int cpu, FAR const char *kind, int id,
+                                FAR const struct latency_hist_s *hist)
+{
+  size_t linesize;
+  int i;
+
+  /* Keep one byte for the newline */
+
+  linesize = procfs_snprintf(procfile->line, LATENCY_LINELEN - 1,
+                             "%d %s %d %" PRIu32 " %" PRIu64,
+                             cpu, kind, id, hist->count,
+                             latency_nsec(hist->max));
+
+  for (i = 0; i < CONFIG_SCHED_LATENCY_NBUCKETS; i++)
+    {
+      if (hist->bucket[i] == 0)
+        {
+          continue;
+        }
+
+      if (i == CONFIG_SCHED_LATENCY_NBUCKETS - 1 ||
+          i >= 8 * sizeof(clock_t))
+        {
+          linesize += procfs_snprintf(procfile->line + linesize,
+                                      LATENCY_LINELEN - 1 - linesize,
+                                      " inf:%" PRIu32, hist->bucket[i]);
+        }
+      else
+        {
+          linesize += procfs_snprintf(procfile->line + linesize,
+                                      LATENCY_LINELEN - 1 - linesize,
+                                      " %" PRIu64 ":%" PRIu32,
+                                      latency_nsec((clock_t)1 << i),
+                                      hist->bucket[i]);
+        }
+    }
+
+  procfile->line[linesize++] = '\n';
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: latency_read
+ ****************************************************************************/
+
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct latency_file_s *procfile;
+  struct latency_hist_s hist;
+  uint32_t dropped;
+  uint8_t priority;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+  int cpu;
+  int irq;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* The first line describes the columns, times are in nanoseconds */
+
+  linesize  = procfs_snprintf(procfile->line, LATENCY_LINELEN,
+                              "# cpu kind id count max "
+                              "[bound:samples...]\n");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  for (cpu = 0;
+       buflen > 0 && nxsched_latency_switchhist(cpu, &hist, &dropped) == OK;
+       cpu++)
+    {
+      /* A comment line with the wakeups that were not counted */
+
+      linesize   = procfs_snprintf(procfile->line, LATENCY_LINELEN,
+                                   "# cpu %d dropped %" PRIu32 "\n",
+                                   cpu, dropped);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* The context switch cost */
+
+      linesize   = latency_hist_line(procfile, cpu, "switch", 0, &hist);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* The wakeup-to-run latency of each priority */
+
+      for (index = 0;
+           buflen > 0 &&
+           nxsched_latency_wakehist(cpu, index, &priority, &hist) == OK;
+           index++)
+        {
+          linesize   = latency_hist_line(procfile, cpu, "wakeup", priority,
+                                         &hist);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+        }
+
+      /* The handler duration of each IRQ that was taken */
+
+      for (irq = 0; buflen > 0 && irq < NR_IRQS; irq++)
+        {
+          if (nxsched_latency_irqhist(cpu, irq, &hist) != OK)
+            {
+              continue;
+            }
+
+          linesize   = latency_hist_line(procfile, cpu, "irq", irq, &hist);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+        }
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: latency_write
+ *
+ * Description:
+ *   "reset" clears the histograms.
+ *
+ ****************************************************************************/
+
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  size_t len = buflen;
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* Ignore a trailing newline, as written by echo */
+
+  while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r'))
+    {
+      len--;
+    }
+
+  if (len != 5 || strncmp(buffer, "reset", 5) != 0)
+    {
+      return -EINVAL;
+    }
+
+  nxsched_latency_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: latency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int latency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct latency_file_s *oldattr;
+  FAR struct latency_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct latency_file_s));
+  if (newattr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct latency_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int latency_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_LATENCY && !CONFIG_FS_PROCFS_EXCLUDE_LATENCY */
@@ -0,0 +1,376 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslockstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/lockstat.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_LOCKSTAT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_LOCKSTAT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define LOCKSTAT_LINELEN 128
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct lockstat_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[LOCKSTAT_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/* State of one read, passed through lockstat_foreach() */
+
+struct lockstat_read_s
+{
+  FAR struct lockstat_file_s *procfile;
+  FAR char *buffer;               /* User buffer */
+  size_t buflen;                  /* Room left in the user buffer */
+  size_t totalsize;               /* Bytes copied so far */
+  off_t offset;                   /* Bytes still to skip */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     lockstat_close(FAR struct file *filep);
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t lockstat_write(FAR struct file *filep,
+                 FAR const char *buffer, size_t buflen);
+static int     lockstat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     lockstat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_lockstat_operations =
+{
+  lockstat_open,   /* open */
+  lockstat_close,  /* close */
+  lockstat_read,   /* read */
+  lockstat_write,  /* write */
+  lockstat_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  lockstat_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_open
+ ****************************************************************************/
+
+static int lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct lockstat_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = kmm_zalloc(sizeof(struct lockstat_file_s));
+  if (procfile == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_close
+ ****************************************************************************/
+
+static int lockstat_close(FAR struct file *filep)
+{
+  FAR struct lockstat_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_copy
+ ****************************************************************************/
+
+static void lockstat_copy(FAR struct lockstat_read_s *info, size_t linesize)
+{
+  size_t copysize;
+
+  copysize = procfs_memcpy(info->procfile->line, linesize, info->buffer,
+                           info->buflen, &info->offset);
+
+  info->totalsize += copysize;
+  info->buffer    += copysize;
+  info->buflen    -= copysize;
+}
+
+/****************************************************************************
+ * Name: lockstat_time
+ *
+ * Description:
+ *   Convert perf_gettime() counts to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t lockstat_time(uint64_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert((clock_t)elapsed, &ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: lockstat_class_line
+ *
+ * Description:
+ *   Print one line with the statistics of a lock class summed over all
+ *   CPUs.
+ *
+ ****************************************************************************/
+
+static void lockstat_class_line(FAR struct lockstat_s *stat, FAR void *arg)
+{
+  FAR struct lockstat_read_s *info = arg;
+  uint32_t acquired = 0;
+  uint32_t contended = 0;
+  uint64_t waittime = 0;
+  clock_t maxwait = 0;
+  pid_t maxholder = INVALID_PROCESS_ID;
+  size_t linesize;
+  int cpu;
+
+  if (info->buflen == 0)
+    {
+      return;
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      acquired  += stat->cpu[cpu].acquired;
+      contended += stat->cpu[cpu].contended;
+      waittime  += stat->cpu[cpu].waittime;
+
+      if (stat->cpu[cpu].maxwait > maxwait)
+        {
+          maxwait   = stat->cpu[cpu].maxwait;
+          maxholder = stat->cpu[cpu].maxholder;
+        }
+    }
+
+  linesize = procfs_snprintf(info->procfile->line, LOCKSTAT_LINELEN,
+                             "%-16s %10" PRIu32 " %10" PRIu32
+                             " %12" PRIu64 " %10" PRIu64 " %6d\n",
+                             stat->name, acquired, contended,
+                             lockstat_time(waittime),
+                             lockstat_time(maxwait), (int)maxholder);
+  lockstat_copy(info, linesize);
+}
+
+/****************************************************************************
+ * Name: lockstat_read
+ ****************************************************************************/
+
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct lockstat_read_s info;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  info.procfile  = filep->f_priv;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.totalsize = 0;
+  info.offset    = filep->f_pos;
+  DEBUGASSERT(info.procfile);
+
+  /* The first line describes the columns, times are in microseconds */
+
+  linesize = procfs_snprintf(info.procfile->line, LOCKSTAT_LINELEN,
+                             "%-16s %10s %10s %12s %10s %6s\n",
+                             "CLASS", "ACQUIRED", "CONTENDED", "WAIT(us)",
+                             "MAX(us)", "HOLDER");
+  lockstat_copy(&info, linesize);
+
+  /* Then one line per lock class */
+
+  lockstat_foreach(lockstat_class_line, &info);
+
+  /* Update the file offset */
+
+  filep->f_pos += info.totalsize;
+  return info.totalsize;
+}
+
+/****************************************************************************
+ * Name: lockstat_write
+ *
+ * Description:
+ *   "reset" clears the statistics.
+ *
+ ****************************************************************************/
+
+static ssize_t lockstat_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen)
+{
+  size_t len = buflen;
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* Ignore a trailing newline, as written by echo */
+
+  while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r'))
+    {
+      len--;
+    }
+
+  if (len != 5 || strncmp(buffer, "reset", 5) != 0)
+    {
+      return -EINVAL;
+    }
+
+  lockstat_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: lockstat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int lockstat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct lockstat_file_s *oldattr;
+  FAR struct lockstat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct lockstat_file_s));
+  if (newattr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct lockstat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int lockstat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_LOCKSTAT && !CONFIG_FS_PROCFS_EXCLUDE_LOCKSTAT */
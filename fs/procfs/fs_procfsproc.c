@@ -53,6 +53,7 @@
 #include <nuttx/fs/procfs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/pmu.h>
 
 #if defined(CONFIG_SCHED_CPULOAD) || defined(CONFIG_SCHED_CRITMONITOR)
 #  include <nuttx/clock.h>
@@ -90,6 +91,9 @@ enum proc_node_e
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_PMU
+  PROC_PMU,                           /* Hardware event counts */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   PROC_HEAP,                          /* Task heap info */
 #endif
@@ -154,7 +158,7 @@ struct proc_envinfo_s
 
 static FAR const char *g_policy[4] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_DEADLINE"
 };
 
 /****************************************************************************
@@ -181,6 +185,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_PMU
+static ssize_t proc_pmu(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
 static ssize_t proc_heap(FAR struct proc_file_s *procfile,
                          FAR struct tcb_s *tcb, FAR char *buffer,
@@ -292,6 +301,13 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_PMU
+static const struct proc_node_s g_pmu =
+{
+  "pmu",          "pmu",     (uint8_t)PROC_PMU,          DTYPE_FILE        /* Hardware event counts */
+};
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static const struct proc_node_s g_heap =
 {
@@ -346,6 +362,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
 #endif
+#ifdef CONFIG_SCHED_PMU
+  &g_pmu,          /* Hardware event counts */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -375,6 +394,9 @@ static const struct proc_node_s * const g_level0info[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_PMU
+  &g_pmu,          /* Hardware event counts */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -458,7 +480,8 @@ static FAR const struct proc_node_s *proc_findnode(FAR const char *relpath)
  *                                   MQ full}
  *   Flags:      xxx                N,P,X
  *   Priority:   nnn                Decimal, 0-255
- *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC}
+ *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC,
+ *                                   SCHED_DEADLINE}
  *   Sigmask:    nnnnnnnn           Hexadecimal, 32-bit
  *
  ****************************************************************************/
@@ -872,6 +895,66 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_pmu
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PMU
+static ssize_t proc_pmu(FAR struct proc_file_s *procfile,
+                        FAR struct tcb_s *tcb, FAR char *buffer,
+                        size_t buflen, off_t offset)
+{
+  static FAR const char * const names[PMU_NEVENTS] =
+  {
+    "cycles",
+    "instructions",
+    "cache-references",
+    "cache-misses",
+    "branches",
+    "branch-misses"
+  };
+
+  struct pmu_counts_s counts;
+  uint32_t events;
+  size_t remaining;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  remaining = buflen;
+  totalsize = 0;
+
+  if (pmu_read(procfile->pid, &counts) < 0)
+    {
+      return 0;
+    }
+
+  /* One line for each event counted */
+
+  events = pmu_events();
+  for (i = 0; i < PMU_NEVENTS && remaining > 0; i++)
+    {
+      if ((events & PMU_EVENT_BIT(i)) == 0)
+        {
+          continue;
+        }
+
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-16s %" PRIu64 "\n", names[i],
+                                   counts.count[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                 remaining, &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      remaining -= copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_heap
  ****************************************************************************/
@@ -1531,6 +1614,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 #endif
+#ifdef CONFIG_SCHED_PMU
+    case PROC_PMU: /* Hardware event counts */
+      ret = proc_pmu(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
     case PROC_HEAP: /* Task heap info */
       ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
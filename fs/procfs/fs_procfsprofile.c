@@ -0,0 +1,373 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsprofile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched_profile.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.  A frame takes up to
+ * 48 characters when it is printed with its symbol name.
+ */
+
+#define PROFILE_LINELEN (40 + 48 * CONFIG_SCHED_PROFILE_DEPTH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct profile_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[PROFILE_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     profile_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     profile_close(FAR struct file *filep);
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     profile_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     profile_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_profile_operations =
+{
+  profile_open,   /* open */
+  profile_close,  /* close */
+  profile_read,   /* read */
+  profile_write,  /* write */
+  profile_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  profile_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_open
+ ****************************************************************************/
+
+static int profile_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct profile_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = kmm_zalloc(sizeof(struct profile_file_s));
+  if (procfile == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_close
+ ****************************************************************************/
+
+static int profile_close(FAR struct file *filep)
+{
+  FAR struct profile_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_entry_line
+ *
+ * Description:
+ *   Format one sampled stack as "cpu count pid frame...", innermost frame
+ *   first.  Frames are printed with %pS, i.e. as symbol+offset when the
+ *   kernel has a symbol table and as plain addresses otherwise.
+ *
+ ****************************************************************************/
+
+static size_t profile_entry_line(FAR struct profile_file_s *procfile,
+                                 int cpu,
+                                 FAR const struct profile_entry_s *entry)
+{
+  size_t linesize;
+  int i;
+
+  /* Keep one byte for the newline */
+
+  linesize = procfs_snprintf(procfile->line, PROFILE_LINELEN - 1,
+                             "%d %" PRIu32 " %d", cpu, entry->count,
+                             (int)entry->pid);
+
+  for (i = 0; i < entry->depth; i++)
+    {
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  PROFILE_LINELEN - 1 - linesize,
+                                  " %pS", (FAR void *)entry->pc[i]);
+    }
+
+  procfile->line[linesize++] = '\n';
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct profile_file_s *procfile;
+  struct profile_stats_s stats;
+  struct profile_entry_s entry;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+  int cpu;
+  int ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* The first line describes the columns */
+
+  linesize  = procfs_snprintf(procfile->line, PROFILE_LINELEN,
+                              "# cpu count pid pc [caller...]\n");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  for (cpu = 0; buflen > 0 && nxsched_profile_stats(cpu, &stats) == OK;
+       cpu++)
+    {
+      /* A comment line with the statistics of the CPU */
+
+      linesize   = procfs_snprintf(procfile->line, PROFILE_LINELEN,
+                                   "# cpu %d samples %" PRIu32
+                                   " dropped %" PRIu32 " stacks %" PRIu32
+                                   "\n", cpu, stats.samples, stats.dropped,
+                                   stats.nentries);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Then one line per sampled stack */
+
+      for (index = 0; buflen > 0; index++)
+        {
+          ret = nxsched_profile_entry(cpu, index, &entry);
+          if (ret == -EINVAL)
+            {
+              break;
+            }
+          else if (ret < 0)
+            {
+              continue;
+            }
+
+          linesize   = profile_entry_line(procfile, cpu, &entry);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+        }
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: profile_write
+ *
+ * Description:
+ *   "start" and "stop" control sampling, "reset" discards the samples.
+ *
+ ****************************************************************************/
+
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  size_t len = buflen;
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* Ignore a trailing newline, as written by echo */
+
+  while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r'))
+    {
+      len--;
+    }
+
+  if (len == 5 && strncmp(buffer, "start", 5) == 0)
+    {
+      nxsched_profile_start();
+    }
+  else if (len == 4 && strncmp(buffer, "stop", 4) == 0)
+    {
+      nxsched_profile_stop();
+    }
+  else if (len == 5 && strncmp(buffer, "reset", 5) == 0)
+    {
+      nxsched_profile_reset();
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: profile_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int profile_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct profile_file_s *oldattr;
+  FAR struct profile_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct profile_file_s));
+  if (newattr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct profile_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int profile_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_PROFILE && !CONFIG_FS_PROCFS_EXCLUDE_PROFILE */
@@ -31,6 +31,16 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* UDP protocol (SOL_UDP) socket options */
+
+#define UDP_SEGMENT   103 /* Split sends into datagrams of this
+                           * size (segmentation offload), same
+                           * value as Linux.  arg: int */
+
+/* Maximum number of datagrams a single UDP_SEGMENT send may produce */
+
+#define UDP_MAX_SEGMENTS 64
+
 /* UDP header as specified by RFC 768, August 1980. */
 
 struct udphdr
@@ -81,6 +81,8 @@
                                  /* all filters must match to trigger */
 #define CAN_RAW_TX_DEADLINE    (__SO_PROTOCOL + 6)
                                  /* Abort frame when deadline passed */
+#define CAN_RAW_RX_RING        (__SO_PROTOCOL + 7)
+                                 /* NuttX: frames in timestamped RX ring */
 
 /* CAN filter support (Hardware level filtering) ****************************/
 
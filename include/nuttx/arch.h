@@ -1927,6 +1927,21 @@ int up_timer_tick_start(clock_t ticks);
 
 uintptr_t up_getusrsp(FAR void *regs);
 
+/****************************************************************************
+ * Name: up_getusrpc
+ *
+ * Input Parameters:
+ *   regs - regs to get pc
+ *
+ * Returned Value:
+ *   Program counter of the interrupted context.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_GETUSRPC
+uintptr_t up_getusrpc(FAR void *regs);
+#endif
+
 /****************************************************************************
  * TLS support
  ****************************************************************************/
@@ -2722,6 +2737,26 @@ unsigned long up_perf_gettime(void);
 unsigned long up_perf_getfreq(void);
 void up_perf_convert(unsigned long elapsed, FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: up_pmu_events, up_pmu_read
+ *
+ * Description:
+ *   The hardware event counters of the current CPU, see
+ *   include/nuttx/pmu.h.  up_pmu_events() returns the set of the events
+ *   of enum pmu_event_e that the CPU counts, as PMU_EVENT_BIT() of each.
+ *   up_pmu_read() returns the free running count of every event in
+ *   counts[PMU_NEVENTS], zero for the events that are not counted.
+ *
+ *   With CONFIG_SCHED_PMU, up_pmu_read() is called at every context
+ *   switch with interrupts disabled, so it should be quick.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PMU
+uint32_t up_pmu_events(void);
+void up_pmu_read(FAR uint64_t *counts);
+#endif
+
 /****************************************************************************
  * Name: up_show_cpuinfo
  *
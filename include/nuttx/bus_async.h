@@ -0,0 +1,168 @@
+/****************************************************************************
+ * include/nuttx/bus_async.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_BUS_ASYNC_H
+#define __INCLUDE_NUTTX_BUS_ASYNC_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_BUS_ASYNC
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The request queue behind the asynchronous bus interfaces, such as
+ * spi_async_submit() and i2c_async_submit().  A kernel thread per bus
+ * performs the queued requests one at a time, in priority order and in
+ * submission order within a priority.  The bus interfaces embed the queue
+ * and the requests in their own structures and provide the operations
+ * that perform and complete a request.
+ */
+
+struct bus_async_s;
+
+struct bus_async_req_s
+{
+  sq_entry_t node;                /* Used by the bus queue */
+  uint8_t priority;               /* Higher priority requests go first */
+};
+
+struct bus_async_ops_s
+{
+  /* Perform one request on the bus thread and return its result */
+
+  CODE int (*transfer)(FAR struct bus_async_s *async,
+                       FAR struct bus_async_req_s *req);
+
+  /* Report the result of a request, -ECANCELED if it was still queued
+   * when the queue was uninitialized.
+   */
+
+  CODE void (*complete)(FAR struct bus_async_req_s *req, int result);
+};
+
+struct bus_async_s
+{
+  FAR const struct bus_async_ops_s *ops; /* Bus specific operations */
+  FAR struct bus_async_req_s *active;    /* Request being performed */
+  sq_queue_t queue;                      /* Pending requests by priority */
+  spinlock_t lock;                       /* Protects queue and active */
+  sem_t sem;                             /* Posted once per submission */
+  sem_t exitsem;                         /* Posted when the thread ends */
+  bool exiting;                          /* Thread is asked to end */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: bus_async_initialize
+ *
+ * Description:
+ *   Initialize a request queue and start the thread that serves it.
+ *
+ * Input Parameters:
+ *   async     - The queue to initialize
+ *   ops       - The operations performing and completing the requests
+ *   name      - The name of the thread
+ *   priority  - The priority of the thread
+ *   stacksize - The stack size of the thread
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int bus_async_initialize(FAR struct bus_async_s *async,
+                         FAR const struct bus_async_ops_s *ops,
+                         FAR const char *name, int priority,
+                         int stacksize);
+
+/****************************************************************************
+ * Name: bus_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue, after the request in progress is
+ *   done.  Requests that are still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void bus_async_uninitialize(FAR struct bus_async_s *async);
+
+/****************************************************************************
+ * Name: bus_async_submit
+ *
+ * Description:
+ *   Queue a request in priority order.  May be called from an interrupt
+ *   handler.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ESHUTDOWN if the queue is being uninitialized.
+ *
+ ****************************************************************************/
+
+int bus_async_submit(FAR struct bus_async_s *async,
+                     FAR struct bus_async_req_s *req);
+
+/****************************************************************************
+ * Name: bus_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.  The
+ *   request is not completed.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed, -EBUSY if it is being performed
+ *   and -ENOENT if it is not queued.
+ *
+ ****************************************************************************/
+
+int bus_async_cancel(FAR struct bus_async_s *async,
+                     FAR struct bus_async_req_s *req);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_BUS_ASYNC */
+#endif /* __INCLUDE_NUTTX_BUS_ASYNC_H */
@@ -99,6 +99,7 @@
 #define _SEIOCBASE      (0x3a00) /* Secure element ioctl commands */
 #define _SYSLOGBASE     (0x3c00) /* Syslog device ioctl commands */
 #define _STEPIOBASE     (0x3d00) /* Stepper device ioctl commands */
+#define _USRSOCKBASE    (0x3e00) /* Usrsock device ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -670,6 +671,13 @@
 #define _SYSLOGVALID(c) (_IOC_TYPE(c)==_SYSLOGBASE)
 #define _SYSLOGIOC(nr)  _IOC(_SYSLOGBASE,nr)
 
+/* usrsock driver ioctl definitions *****************************************/
+
+/* (see nuttx/include/nuttx/net/usrsock.h */
+
+#define _USRSOCKIOCVALID(c) (_IOC_TYPE(c)==_USRSOCKBASE)
+#define _USRSOCKIOC(nr)     _IOC(_USRSOCKBASE,nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
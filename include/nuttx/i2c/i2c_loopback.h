@@ -0,0 +1,69 @@
+/****************************************************************************
+ * include/nuttx/i2c/i2c_loopback.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_I2C_I2C_LOOPBACK_H
+#define __INCLUDE_NUTTX_I2C_I2C_LOOPBACK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_LOOPBACK
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  i2c_loopback_initialize
+ *
+ * Description:
+ *   Create an instance of the simulated loopback I2C bus.  One target at
+ *   CONFIG_I2C_LOOPBACK_ADDR answers with a register file: the first byte
+ *   written selects the register, further bytes are stored from there and
+ *   reads return them back.  Each message takes the time it would take at
+ *   the requested frequency plus CONFIG_I2C_LOOPBACK_LATENCY.
+ *
+ * Returned Value:
+ *   On success a non-NULL, initialized I2C driver instance is returned.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_master_s *i2c_loopback_initialize(void);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_I2C_LOOPBACK */
+#endif /* __INCLUDE_NUTTX_I2C_I2C_LOOPBACK_H */
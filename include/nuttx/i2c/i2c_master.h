@@ -31,6 +31,11 @@
 #include <stdint.h>
 
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/queue.h>
+
+#ifdef CONFIG_I2C_ASYNC
+#  include <nuttx/bus_async.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -234,6 +239,28 @@ struct i2c_transfer_s
   size_t msgc;                /* Number of messages in the array. */
 };
 
+#ifdef CONFIG_I2C_ASYNC
+/* An asynchronous request queued with i2c_async_submit().  The request and
+ * the messages it refers to belong to the bus queue until the callback is
+ * called or the request is cancelled.
+ */
+
+struct i2c_async_s;
+struct i2c_async_req_s;
+
+typedef CODE void (*i2c_async_callback_t)(FAR struct i2c_async_req_s *req,
+                                          int result);
+
+struct i2c_async_req_s
+{
+  struct bus_async_req_s base;    /* Queue entry and priority */
+  FAR struct i2c_msg_s *msgv;     /* Array of I2C messages to transfer */
+  int msgc;                       /* Number of messages in the array */
+  i2c_async_callback_t callback;  /* Called on the bus thread when done */
+  FAR void *arg;                  /* Argument for the callback */
+};
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -347,6 +374,75 @@ int i2c_read(FAR struct i2c_master_s *dev,
              FAR const struct i2c_config_s *config,
              FAR uint8_t *buffer, int buflen);
 
+#ifdef CONFIG_I2C_ASYNC
+
+/****************************************************************************
+ * Name: i2c_async_initialize
+ *
+ * Description:
+ *   Create an asynchronous request queue for an I2C bus and start the
+ *   thread that serves it.  Each request is one I2C_TRANSFER() call, so
+ *   synchronous users of the bus are still serialized with it by the lower
+ *   half.
+ *
+ * Input Parameters:
+ *   dev - An instance of the lower half I2C driver
+ *   bus - The I2C bus number, used to name the thread
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_async_s *i2c_async_initialize(FAR struct i2c_master_s *dev,
+                                             int bus);
+
+/****************************************************************************
+ * Name: i2c_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue and free it.  Requests that are
+ *   still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void i2c_async_uninitialize(FAR struct i2c_async_s *async);
+
+/****************************************************************************
+ * Name: i2c_async_submit
+ *
+ * Description:
+ *   Queue a transfer.  Requests are served in priority order and in
+ *   submission order within a priority.  req->callback is called from the
+ *   bus thread with the result of I2C_TRANSFER().  May be called from an
+ *   interrupt handler.
+ *
+ * Returned Value:
+ *   0: success, <0: A negated errno
+ *
+ ****************************************************************************/
+
+int i2c_async_submit(FAR struct i2c_async_s *async,
+                     FAR struct i2c_async_req_s *req);
+
+/****************************************************************************
+ * Name: i2c_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.  The
+ *   callback of a cancelled request is not called.
+ *
+ * Returned Value:
+ *   0 if the request was removed, -EBUSY if it is being performed and
+ *   -ENOENT if it is not queued.
+ *
+ ****************************************************************************/
+
+int i2c_async_cancel(FAR struct i2c_async_s *async,
+                     FAR struct i2c_async_req_s *req);
+
+#endif /* CONFIG_I2C_ASYNC */
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
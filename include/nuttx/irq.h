@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #ifndef __ASSEMBLY__
+#  include <sys/types.h>
 #  include <stdint.h>
 #  include <stdbool.h>
 #endif
@@ -154,6 +155,24 @@ int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
 #  define irqchain_detach(irq, isr, arg) irq_detach(irq)
 #endif
 
+/****************************************************************************
+ * Name: irq_affinity
+ *
+ * Description:
+ *   Route the interrupt 'irq' to the CPUs of 'cpuset'.  The setting is kept
+ *   when the interrupt is detached and attached again.  Without it, the
+ *   interrupts are routed to the CPUs that are not isolated
+ *   (CONFIG_SMP_ISOLATED_CPUSET) when they are attached.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if 'irq' is not valid or 'cpuset' has no CPU.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAVE_IRQAFFINITY)
+int irq_affinity(int irq, cpu_set_t cpuset);
+#endif
+
 /****************************************************************************
  * Name: enter_critical_section
  *
@@ -174,6 +193,10 @@ int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
  *
  *     This function is equivalent to up_irq_save().
  *
+ *   Data that is shared by a few functions only is better protected by a
+ *   lock of its own with spin_lock_irqsave(lock), which disables the
+ *   interrupts of the local CPU only and does not serialize all the CPUs.
+ *
  * Input Parameters:
  *   None
  *
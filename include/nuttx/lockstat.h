@@ -0,0 +1,167 @@
+/****************************************************************************
+ * include/nuttx/lockstat.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LOCKSTAT_H
+#define __INCLUDE_NUTTX_LOCKSTAT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Contention statistics of a lock class gathered on one CPU.  Times are in
+ * perf_gettime() counts.
+ */
+
+struct lockstat_cpu_s
+{
+  uint32_t acquired;              /* Number of acquisitions */
+  uint32_t contended;             /* Acquisitions that had to wait */
+  uint64_t waittime;              /* Total time spent waiting */
+  clock_t  maxwait;               /* Longest wait */
+  pid_t    maxholder;             /* Holder during the longest wait */
+};
+
+/* A lock class: all lock instances bound under the same name */
+
+struct lockstat_s
+{
+  FAR const char *name;           /* Name of the class */
+  struct lockstat_cpu_s cpu[CONFIG_SMP_NCPUS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lockstat_bind_sem
+ *
+ * Description:
+ *   Gather the statistics of a semaphore, or of the semaphore inside a
+ *   mutex, under the lock class called name.  The class is registered the
+ *   first time the name is used.  name must stay valid.
+ *
+ * Returned Value:
+ *   OK on success; -ENOMEM if all CONFIG_SCHED_LOCKSTAT_NCLASSES classes
+ *   are in use.
+ *
+ ****************************************************************************/
+
+int lockstat_bind_sem(FAR sem_t *sem, FAR const char *name);
+
+/****************************************************************************
+ * Name: lockstat_bind_spin
+ *
+ * Description:
+ *   Gather the statistics of a spinlock under the lock class called name.
+ *
+ * Returned Value:
+ *   OK on success; -ENOMEM if there is no free class or spinlock slot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK
+int lockstat_bind_spin(FAR volatile spinlock_t *lock, FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: lockstat_sem_contend, lockstat_sem_acquired
+ *
+ * Description:
+ *   Hooks of the semaphore logic.  lockstat_sem_contend() is called before
+ *   blocking on sem and returns the holder to blame for the wait.
+ *   lockstat_sem_acquired() is called once sem is taken; start is the
+ *   perf_gettime() value when the wait began, or 0 if there was no wait.
+ *   lockstat_sem_spun() adds the time spun on sem before nxsem_trywait()
+ *   took it, that acquisition being counted by nxsem_trywait() already.
+ *
+ ****************************************************************************/
+
+pid_t lockstat_sem_contend(FAR sem_t *sem);
+void lockstat_sem_acquired(FAR sem_t *sem, clock_t start, pid_t holder);
+void lockstat_sem_spun(FAR sem_t *sem, clock_t start, pid_t holder);
+
+/****************************************************************************
+ * Name: lockstat_spin_contend, lockstat_spin_acquired
+ *
+ * Description:
+ *   The same hooks for spin_lock().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK
+pid_t lockstat_spin_contend(FAR volatile spinlock_t *lock);
+void lockstat_spin_acquired(FAR volatile spinlock_t *lock, clock_t start,
+                            pid_t holder);
+#endif
+
+/****************************************************************************
+ * Name: lockstat_foreach
+ *
+ * Description:
+ *   Call handler for each registered lock class.
+ *
+ ****************************************************************************/
+
+typedef CODE void (*lockstat_handler_t)(FAR struct lockstat_s *stat,
+                                        FAR void *arg);
+
+void lockstat_foreach(lockstat_handler_t handler, FAR void *arg);
+
+/****************************************************************************
+ * Name: lockstat_reset
+ *
+ * Description:
+ *   Clear the statistics of all lock classes.
+ *
+ ****************************************************************************/
+
+void lockstat_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
+#endif /* __INCLUDE_NUTTX_LOCKSTAT_H */
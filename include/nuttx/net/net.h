@@ -204,6 +204,15 @@ struct socket_conn_s
   FAR struct devif_callback_s *list;
   FAR struct devif_callback_s *list_tail;
 
+  /* Link in the pending output queue of a device (see devif_pendq_s) and
+   * the queue it is linked in, NULL if none.
+   */
+
+#ifdef CONFIG_NET_POLL_PENDING
+  dq_entry_t    s_pendnode;
+  FAR struct devif_pendq_s *s_pendq;
+#endif
+
   /* Socket options */
 
 #ifdef CONFIG_NET_SOCKOPTS
@@ -218,6 +227,9 @@ struct socket_conn_s
   uint8_t       s_boundto;   /* Index of the interface we are bound to.
                               * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #  endif
+#  ifdef CONFIG_NET_BUSY_POLL
+  uint32_t      s_busypoll;  /* Receive busy poll time (microseconds) */
+#  endif
 #endif
 
   /* Definitions of 8-bit socket flags */
@@ -925,6 +937,56 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends multiple messages on a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that it is not a cancellation point, it does not modify the
+ *   errno variable and it accepts the internal socket structure as input.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Array of messages to send
+ *   vlen      Number of entries in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  If no message could
+ *   be sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives multiple messages from a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that it is not a cancellation point, it does not modify the
+ *   errno variable and it accepts the internal socket structure as input.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Array of messages to receive
+ *   vlen      Number of entries in msgvec
+ *   flags     Receive flags
+ *   timeout   Optional timeout, checked after each received message
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If no message
+ *   could be received, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
@@ -237,6 +237,20 @@ struct netdev_varaddr_s
 
 struct devif_callback_s; /* Forward reference */
 
+#ifdef CONFIG_NET_POLL_PENDING
+/* Queue of the connections that have output pending on a device.  next
+ * and cur are the cursor of the poll in progress and are updated when a
+ * connection leaves the queue while it is being polled.
+ */
+
+struct devif_pendq_s
+{
+  dq_queue_t queue;                  /* Connections with pending output */
+  FAR struct socket_conn_s *next;    /* Next connection to poll */
+  FAR struct socket_conn_s *cur;     /* Connection being polled */
+};
+#endif
+
 struct net_driver_s
 {
   /* This link is used to maintain a single-linked list of ethernet drivers.
@@ -327,6 +341,20 @@ struct net_driver_s
   FAR struct iob_queue_s d_fragout;
 #endif
 
+  /* Connections that have marked output pending on this device.  With
+   * CONFIG_NET_POLL_PENDING, devif_poll() visits only these TCP and UDP
+   * connections instead of every allocated one.
+   */
+
+#ifdef CONFIG_NET_POLL_PENDING
+#  ifdef CONFIG_NET_TCP
+  struct devif_pendq_s d_tcppend;
+#  endif
+#  ifdef CONFIG_NET_UDP
+  struct devif_pendq_s d_udppend;
+#  endif
+#endif
+
   /* The d_buf array is used to hold incoming and outgoing packets. The
    * device driver should place incoming data into this buffer.  When sending
    * data, the device driver should read the link level headers and the
@@ -438,6 +466,14 @@ struct net_driver_s
   int (*d_ioctl)(FAR struct net_driver_s *dev, int cmd,
                  unsigned long arg);
 #endif
+#ifdef CONFIG_NET_BUSY_POLL
+  /* Optional: process the pending receive (and transmit) work in the
+   * context of the caller, with the network locked.  Returns the number
+   * of packets received.  Used by SO_BUSY_POLL readers.
+   */
+
+  int (*d_busypoll)(FAR struct net_driver_s *dev);
+#endif
 
   /* Drivers may attached device-specific, private information */
 
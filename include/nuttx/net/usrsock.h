@@ -34,6 +34,7 @@
 
 #include <nuttx/net/netconfig.h>
 #include <nuttx/compiler.h>
+#include <nuttx/fs/ioctl.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -61,6 +62,43 @@
 #define USRSOCK_MESSAGE_REQ_COMPLETED(flags) \
                           (!USRSOCK_MESSAGE_REQ_IN_PROGRESS(flags))
 
+/* Return value of usrsock_request() when the request was copied out by the
+ * transport and the caller need not wait for the daemon to fetch it.
+ */
+
+#define USRSOCK_REQUEST_QUEUED 1
+
+/* /dev/usrsock shared-memory rings.
+ *
+ * The daemon maps the device (offset 0) to get a struct usrsock_shm_s
+ * header followed by two byte rings: the request ring (kernel => daemon)
+ * and the response ring (daemon => kernel).  Both carry the very same
+ * messages as read()/write() on the device, each one prefixed with a
+ * struct usrsock_shmrec_s and padded to USRSOCK_SHM_ALIGNMENT.  Indices are
+ * free running and the ring sizes are powers of two.  A record that would
+ * straddle the end of the ring is replaced by a USRSOCK_SHM_WRAP record
+ * and written again from the start of the ring.
+ *
+ * The kernel raises POLLIN only when the request ring turns non-empty, so
+ * the daemon should drain all requests per wake-up.  Responses and events
+ * are handed to the kernel in one go with USRSOCKIOC_KICK.
+ */
+
+#define USRSOCK_SHM_MAGIC          0x55534b52 /* "USKR" */
+#define USRSOCK_SHM_ALIGNMENT      8
+#define USRSOCK_SHM_ALIGN(n)       (((n) + USRSOCK_SHM_ALIGNMENT - 1) & \
+                                    ~(USRSOCK_SHM_ALIGNMENT - 1))
+#define USRSOCK_SHM_RECLEN(n)      \
+  USRSOCK_SHM_ALIGN(sizeof(struct usrsock_shmrec_s) + (n))
+#define USRSOCK_SHM_WRAP           UINT32_MAX
+
+/* Process all records pending in the response ring and wake up requests
+ * waiting for room in the request ring.  Argument: none.  Returns the
+ * number of response/event messages processed.
+ */
+
+#define USRSOCKIOC_KICK            _USRSOCKIOC(0x0001)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -95,6 +133,34 @@ enum usrsock_message_types_e
   USRSOCK_MESSAGE_SOCKET_EVENT,
 };
 
+/* Shared-memory ring layout (see USRSOCK_SHM_MAGIC).  usrsock_shm_s::
+ * waitspace is written by the kernel only, with plain stores: it is set
+ * while a request is waiting for room in the request ring, and the daemon
+ * should then issue USRSOCKIOC_KICK after it consumed requests.
+ */
+
+struct usrsock_shmring_s
+{
+  uint32_t head;    /* Producer index */
+  uint32_t tail;    /* Consumer index */
+  uint32_t size;    /* Size of the ring data in bytes (power of two) */
+  uint32_t offset;  /* Offset of the ring data from the mapping start */
+};
+
+struct usrsock_shm_s
+{
+  uint32_t magic;                /* USRSOCK_SHM_MAGIC */
+  uint32_t waitspace;            /* Nonzero: kick after consuming requests */
+  struct usrsock_shmring_s req;  /* kernel => daemon */
+  struct usrsock_shmring_s resp; /* daemon => kernel */
+};
+
+struct usrsock_shmrec_s
+{
+  uint32_t len;     /* Message length or USRSOCK_SHM_WRAP */
+  uint32_t reserved;
+};
+
 /* Request structures (kernel => /dev/usrsock => daemon) */
 
 begin_packed_struct struct usrsock_request_common_s
@@ -295,6 +361,12 @@ ssize_t usrsock_response(FAR const char *buffer, size_t len,
 
 /****************************************************************************
  * Name: usrsock_request() - finish usrsock's request
+ *
+ * Returned Value:
+ *   Zero if the daemon will acknowledge the request once it fetched it,
+ *   USRSOCK_REQUEST_QUEUED if the request was already copied out and no
+ *   acknowledgment must be waited for, or a negated errno on failure.
+ *
  ****************************************************************************/
 
 int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt);
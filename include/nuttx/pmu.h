@@ -0,0 +1,120 @@
+/****************************************************************************
+ * include/nuttx/pmu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_PMU_H
+#define __INCLUDE_NUTTX_PMU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PMU_EVENT_BIT(e)  (UINT32_C(1) << (e))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The generic hardware events.  The architecture maps each of them to the
+ * nearest counter of its PMU, if it has one.
+ */
+
+enum pmu_event_e
+{
+  PMU_EVENT_CYCLES = 0,           /* CPU cycles */
+  PMU_EVENT_INSTRUCTIONS,         /* Instructions retired */
+  PMU_EVENT_CACHE_REFERENCES,     /* Last level cache accesses */
+  PMU_EVENT_CACHE_MISSES,         /* Last level cache misses */
+  PMU_EVENT_BRANCHES,             /* Branch instructions retired */
+  PMU_EVENT_BRANCH_MISSES,        /* Mispredicted branches */
+  PMU_NEVENTS
+};
+
+/* The counts of all events, indexed by enum pmu_event_e */
+
+struct pmu_counts_s
+{
+  uint64_t count[PMU_NEVENTS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_SCHED_PMU
+
+/****************************************************************************
+ * Name: pmu_events
+ *
+ * Description:
+ *   Return the set of events counted, as PMU_EVENT_BIT() of each of them.
+ *   The counts of the other events always read as zero.
+ *
+ ****************************************************************************/
+
+uint32_t pmu_events(void);
+
+/****************************************************************************
+ * Name: pmu_read
+ *
+ * Description:
+ *   Read the counts of events that occurred while the thread pid was
+ *   running since it was created.  The counts of the calling thread are up
+ *   to date; those of a thread running on another CPU are as of its last
+ *   switch in.
+ *
+ *   The difference of two reads around a piece of code gives its cost, for
+ *   example its instructions per cycle.
+ *
+ * Input Parameters:
+ *   pid    - The thread to read, 0 for the calling thread.
+ *   counts - Where to return the counts.
+ *
+ * Returned Value:
+ *   OK on success; -ESRCH if there is no thread pid.
+ *
+ ****************************************************************************/
+
+int pmu_read(pid_t pid, FAR struct pmu_counts_s *counts);
+
+#endif /* CONFIG_SCHED_PMU */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_PMU_H */
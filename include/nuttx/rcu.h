@@ -0,0 +1,144 @@
+/****************************************************************************
+ * include/nuttx/rcu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RCU_H
+#define __INCLUDE_NUTTX_RCU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/queue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Read a pointer to RCU protected data inside a read-side critical
+ * section.  It is read once, so the data it points to is consistent.
+ * These are also usable without CONFIG_SCHED_RCU, for data that is then
+ * protected by a lock instead.
+ */
+
+#define rcu_dereference(p)      (*(FAR volatile __typeof__(p) *)&(p))
+
+/* A full memory barrier, for the compiler and for the other CPUs */
+
+#define rcu_mb()                __sync_synchronize()
+
+/* Publish a pointer to RCU protected data.  The stores that initialized the
+ * data are seen by the readers before the pointer is.
+ */
+
+#define rcu_assign_pointer(p, v) \
+  do \
+    { \
+      rcu_mb(); \
+      rcu_dereference(p) = (v); \
+    } \
+  while (0)
+
+#ifdef CONFIG_SCHED_RCU
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* An object released with call_rcu() embeds this structure */
+
+struct rcu_head;
+typedef CODE void (*rcu_callback_t)(FAR struct rcu_head *head);
+
+struct rcu_head
+{
+  sq_entry_t node;                /* Entry in the list of pending callbacks */
+  rcu_callback_t func;            /* Called after the grace period */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: rcu_read_lock
+ *
+ * Description:
+ *   Enter a read-side critical section.  The data read with
+ *   rcu_dereference() inside it is not freed before it is left.  It takes
+ *   no lock and never waits, so it may be used from interrupt handlers.
+ *   Sections may nest.  The thread may be preempted inside one but should
+ *   not block there, since that delays every updater.
+ *
+ ****************************************************************************/
+
+void rcu_read_lock(void);
+
+/****************************************************************************
+ * Name: rcu_read_unlock
+ *
+ * Description:
+ *   Leave a read-side critical section.
+ *
+ ****************************************************************************/
+
+void rcu_read_unlock(void);
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait for a grace period: until all read-side critical sections that
+ *   were entered before the call have been left.  The data unlinked before
+ *   the call may then be freed.  It must not be called from a read-side
+ *   critical section or from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void);
+
+/****************************************************************************
+ * Name: call_rcu
+ *
+ * Description:
+ *   Call func(head) on the low priority work queue after a grace period,
+ *   without waiting for it.  Typically func frees the object that embeds
+ *   head.  It may be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_RCU */
+#endif /* __INCLUDE_NUTTX_RCU_H */
@@ -60,6 +60,12 @@ extern "C"
 int rpmsg_wait(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 
+/* Send the notifications (kicks) deferred by CONFIG_RPTUN_KICK_COALESCE
+ * to the peer now.  No-op if kick coalescing is disabled.
+ */
+
+int rpmsg_flush(FAR struct rpmsg_endpoint *ept);
+
 const char *rpmsg_get_cpuname(FAR struct rpmsg_device *rdev);
 
 int rpmsg_register_callback(FAR void *priv,
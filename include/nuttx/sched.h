@@ -39,6 +39,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/irq.h>
 #include <nuttx/mutex.h>
+#include <nuttx/pmu.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/queue.h>
 #include <nuttx/wdog.h>
@@ -97,6 +98,7 @@
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
+#  define TCB_FLAG_SCHED_DEADLINE  (3 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
 #define TCB_FLAG_CPU_LOCKED        (1 << 8)                      /* Bit 7: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 9)                      /* Bit 8: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 10)                     /* Bit 9: In a system call */
@@ -317,6 +319,31 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s ********************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure is an allocated "plug-in" to the main TCB structure.  It is
+ * allocated when the deadline scheduling policy is assigned to a thread.
+ * The remaining budget of the current period is kept in the timeslice
+ * field of the TCB.
+ */
+
+struct deadline_s
+{
+  bool      throttled;              /* Budget exhausted, waiting for the
+                                     * next period */
+  uint32_t  bandwidth;              /* Reserved runtime / period, as a
+                                     * fraction of 1 << 20                */
+  clock_t   runtime;                /* Execution budget per period        */
+  clock_t   deadline;               /* Deadline relative to the period    */
+  clock_t   period;                 /* Replenishment period               */
+  clock_t   absdeadline;            /* Deadline of the current period     */
+  struct wdog_s timer;              /* Replenishment timer                */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -577,14 +604,21 @@ struct tcb_s
   int16_t  cpcount;                      /* Nested cancellation point count */
 #endif
   int16_t  errcode;                      /* Used to pass error information  */
+#ifdef CONFIG_SCHED_RCU
+  uint32_t rcu_ctr;                      /* RCU read-side phase and nesting */
+#endif
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
-  int32_t  timeslice;                    /* RR timeslice OR Sporadic budget */
-                                         /* interval remaining              */
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
+  int32_t  timeslice;                    /* RR timeslice OR Sporadic or     */
+                                         /* Deadline budget remaining       */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  FAR struct deadline_s *deadline;       /* Deadline scheduling parameters  */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
 
@@ -641,6 +675,18 @@ struct tcb_s
   clock_t run_time;                /* Total time thread run           */
 #endif
 
+  /* Latency histogram support **********************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+  clock_t ready_start;             /* Time thread made ready-to-run   */
+#endif
+
+  /* Hardware event counting support ****************************************/
+
+#ifdef CONFIG_SCHED_PMU
+  struct pmu_counts_s pmu;         /* Events while the thread ran     */
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * include/nuttx/sched_latency.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SCHED_LATENCY_H
+#define __INCLUDE_NUTTX_SCHED_LATENCY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A log2 histogram of durations in perf_gettime() counts.  bucket[0] holds
+ * durations of 0, bucket[n] those in [2^(n-1), 2^n), and the last bucket
+ * also everything longer.
+ */
+
+struct latency_hist_s
+{
+  uint32_t count;                           /* Number of samples */
+  clock_t  max;                             /* Longest duration */
+  uint32_t bucket[CONFIG_SCHED_LATENCY_NBUCKETS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxsched_latency_irqhist
+ *
+ * Description:
+ *   Return the histogram of the handler durations of an IRQ on a CPU.
+ *
+ * Returned Value:
+ *   OK if the histogram has samples; -ENOENT if it is empty; -EINVAL if
+ *   cpu or irq is out of range.
+ *
+ ****************************************************************************/
+
+int nxsched_latency_irqhist(int cpu, int irq,
+                            FAR struct latency_hist_s *hist);
+
+/****************************************************************************
+ * Name: nxsched_latency_wakehist
+ *
+ * Description:
+ *   Return the index'th histogram of the wakeup-to-run latencies on a CPU,
+ *   together with the priority it is kept for.  Priorities are given a
+ *   histogram when they are first seen on the CPU.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if cpu is out of range or no histogram has that
+ *   index.
+ *
+ ****************************************************************************/
+
+int nxsched_latency_wakehist(int cpu, int index, FAR uint8_t *priority,
+                             FAR struct latency_hist_s *hist);
+
+/****************************************************************************
+ * Name: nxsched_latency_switchhist
+ *
+ * Description:
+ *   Return the histogram of the context switch costs on a CPU, and in
+ *   dropped the number of wakeups that found no free priority histogram.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if cpu is out of range.
+ *
+ ****************************************************************************/
+
+int nxsched_latency_switchhist(int cpu, FAR struct latency_hist_s *hist,
+                               FAR uint32_t *dropped);
+
+/****************************************************************************
+ * Name: nxsched_latency_reset
+ *
+ * Description:
+ *   Clear all histograms.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_LATENCY */
+#endif /* __INCLUDE_NUTTX_SCHED_LATENCY_H */
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * include/nuttx/sched_profile.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SCHED_PROFILE_H
+#define __INCLUDE_NUTTX_SCHED_PROFILE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One distinct sampled stack */
+
+struct profile_entry_s
+{
+  uint32_t  count;                          /* Samples that hit this stack */
+  pid_t     pid;                            /* Thread that was interrupted */
+  uint8_t   depth;                          /* Valid entries in pc[] */
+  uintptr_t pc[CONFIG_SCHED_PROFILE_DEPTH]; /* Interrupted PC, then callers */
+};
+
+/* Sampling statistics of one CPU */
+
+struct profile_stats_s
+{
+  uint32_t samples;                         /* Samples taken */
+  uint32_t dropped;                         /* Samples with no free slot */
+  uint32_t nentries;                        /* Distinct stacks recorded */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxsched_process_profile
+ *
+ * Description:
+ *   Take one sample of the context interrupted on this CPU.  Called from
+ *   the system timer or the profiling oneshot; architectures with per-CPU
+ *   timers may call it from those too.
+ *
+ * Assumptions:
+ *   Called from a timer interrupt handler.
+ *
+ ****************************************************************************/
+
+void nxsched_process_profile(void);
+
+/****************************************************************************
+ * Name: nxsched_profile_start, nxsched_profile_stop
+ *
+ * Description:
+ *   Start or stop sampling.  The collected samples are kept.
+ *
+ ****************************************************************************/
+
+void nxsched_profile_start(void);
+void nxsched_profile_stop(void);
+
+/****************************************************************************
+ * Name: nxsched_profile_reset
+ *
+ * Description:
+ *   Discard the samples of all CPUs.
+ *
+ ****************************************************************************/
+
+void nxsched_profile_reset(void);
+
+/****************************************************************************
+ * Name: nxsched_profile_stats
+ *
+ * Description:
+ *   Return the sampling statistics of a CPU.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if cpu is not valid.
+ *
+ ****************************************************************************/
+
+int nxsched_profile_stats(int cpu, FAR struct profile_stats_s *stats);
+
+/****************************************************************************
+ * Name: nxsched_profile_entry
+ *
+ * Description:
+ *   Return a copy of one slot of the stack table of a CPU.
+ *
+ * Returned Value:
+ *   OK if the slot holds a stack; -ENOENT if it is free; -EINVAL if cpu or
+ *   index is out of range.
+ *
+ ****************************************************************************/
+
+int nxsched_profile_entry(int cpu, int index,
+                          FAR struct profile_entry_s *entry);
+
+/****************************************************************************
+ * Name: nxsched_profile_oneshot
+ *
+ * Description:
+ *   Take samples from a oneshot timer at CONFIG_SCHED_PROFILE_FREQUENCY
+ *   instead of from the system timer.  Called once by board logic.
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot timer interface as defined in
+ *           include/nuttx/timers/oneshot.h
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+struct oneshot_lowerhalf_s;
+void nxsched_profile_oneshot(FAR struct oneshot_lowerhalf_s *lower);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_PROFILE */
+#endif /* __INCLUDE_NUTTX_SCHED_PROFILE_H */
@@ -1195,6 +1195,60 @@ extern "C"
 void sensor_remap_vector_raw16(FAR const int16_t *in, FAR int16_t *out,
                                int place);
 
+/****************************************************************************
+ * Name: sensor_push_batch
+ *
+ * Description:
+ *   Push a batch of events read from a hardware FIFO in one call.  The
+ *   timestamps of the events are spread evenly between the time of the
+ *   oldest and the newest event, so a driver only needs the time of its
+ *   watermark interrupt and of the previous batch instead of stamping
+ *   every sample.  Every event must begin with its uint64_t timestamp, as
+ *   all struct sensor_xxx do.
+ *
+ * Input Parameters:
+ *   lower   - The lower half sensor driver pushing the events.
+ *   data    - The events, oldest first.  Their timestamps are rewritten.
+ *   esize   - The size of one event.
+ *   nevents - The number of events in data.
+ *   first   - The timestamp of the oldest event, in us.
+ *   last    - The timestamp of the newest event, in us.
+ *
+ * Returned Value:
+ *   The bytes of push is returned when success;
+ *   A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t sensor_push_batch(FAR struct sensor_lowerhalf_s *lower,
+                          FAR void *data, size_t esize,
+                          unsigned long nevents,
+                          uint64_t first, uint64_t last);
+
+/****************************************************************************
+ * Name: sensor_batch_watermark
+ *
+ * Description:
+ *   Convert the latency requested through SNIOC_BATCH into a FIFO
+ *   watermark.  Lower half batch() methods can use this to program the
+ *   hardware FIFO so that it interrupts once per batch.  The latency is
+ *   rounded to a whole number of samples that fits in the FIFO.
+ *
+ * Input Parameters:
+ *   interval   - The sampling interval, in us.
+ *   latency_us - The requested latency, in us.  Updated with the latency
+ *                that will be used; 0 disables batching.
+ *   fifo_size  - The number of samples the hardware FIFO holds.
+ *
+ * Returned Value:
+ *   The number of samples to collect before interrupting, at least one.
+ *
+ ****************************************************************************/
+
+unsigned long sensor_batch_watermark(unsigned long interval,
+                                     FAR unsigned long *latency_us,
+                                     unsigned long fifo_size);
+
 /****************************************************************************
  * "Upper Half" Sensor Driver Interfaces
  ****************************************************************************/
@@ -0,0 +1,67 @@
+/****************************************************************************
+ * include/nuttx/spi/spi_loopback.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SPI_SPI_LOOPBACK_H
+#define __INCLUDE_NUTTX_SPI_SPI_LOOPBACK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/spi/spi.h>
+
+#ifdef CONFIG_SPI_LOOPBACK
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  spi_loopback_initialize
+ *
+ * Description:
+ *   Create an instance of the simulated loopback SPI bus.  Every word sent
+ *   is received back, and each exchange takes the time the transfer would
+ *   take at the selected frequency plus CONFIG_SPI_LOOPBACK_LATENCY.
+ *
+ * Returned Value:
+ *   On success a non-NULL, initialized SPI driver instance is returned.
+ *
+ ****************************************************************************/
+
+FAR struct spi_dev_s *spi_loopback_initialize(void);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_SPI_LOOPBACK */
+#endif /* __INCLUDE_NUTTX_SPI_SPI_LOOPBACK_H */
@@ -32,8 +32,13 @@
 #include <stdbool.h>
 
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/queue.h>
 #include <nuttx/spi/spi.h>
 
+#ifdef CONFIG_SPI_ASYNC
+#  include <nuttx/bus_async.h>
+#endif
+
 #ifdef CONFIG_SPI_EXCHANGE
 
 /* SPI Character Driver IOCTL Commands **************************************/
@@ -112,6 +117,37 @@ struct spi_sequence_s
   FAR struct spi_trans_s *trans;
 };
 
+#ifdef CONFIG_SPI_ASYNC
+/* An asynchronous request queued with spi_async_submit().  The request and
+ * the sequence it refers to belong to the bus queue until the callback is
+ * called or the request is cancelled.
+ *
+ * Example usage:
+ *   static void mycallback(FAR struct spi_async_req_s *req, int result);
+ *   ...
+ *   myreq.seq           = &myseq;
+ *   myreq.base.priority = 10;
+ *   myreq.callback      = mycallback;
+ *   myreq.arg           = mydev;
+ *   ...
+ *   int ret = spi_async_submit(myasync, &myreq);
+ */
+
+struct spi_async_s;
+struct spi_async_req_s;
+
+typedef CODE void (*spi_async_callback_t)(FAR struct spi_async_req_s *req,
+                                          int result);
+
+struct spi_async_req_s
+{
+  struct bus_async_req_s base;    /* Queue entry and priority */
+  FAR struct spi_sequence_s *seq; /* The transfers to perform */
+  spi_async_callback_t callback;  /* Called on the bus thread when done */
+  FAR void *arg;                  /* Argument for the callback */
+};
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -135,6 +171,75 @@ struct spi_sequence_s
 
 int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq);
 
+#ifdef CONFIG_SPI_ASYNC
+
+/****************************************************************************
+ * Name: spi_async_initialize
+ *
+ * Description:
+ *   Create an asynchronous request queue for an SPI bus and start the
+ *   thread that serves it.  Requests are performed one at a time with
+ *   spi_transfer(), so synchronous users of the bus are still serialized
+ *   with them by the bus lock.
+ *
+ * Input Parameters:
+ *   spi - An instance of the SPI device to queue transfers for
+ *   bus - The SPI bus number, used to name the thread
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct spi_async_s *spi_async_initialize(FAR struct spi_dev_s *spi,
+                                             int bus);
+
+/****************************************************************************
+ * Name: spi_async_uninitialize
+ *
+ * Description:
+ *   Stop the thread serving the queue and free it.  Requests that are
+ *   still queued complete with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void spi_async_uninitialize(FAR struct spi_async_s *async);
+
+/****************************************************************************
+ * Name: spi_async_submit
+ *
+ * Description:
+ *   Queue a sequence of transfers.  Requests are served in priority order
+ *   and in submission order within a priority.  req->callback is called
+ *   from the bus thread with the result of spi_transfer().  May be called
+ *   from an interrupt handler.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_async_submit(FAR struct spi_async_s *async,
+                     FAR struct spi_async_req_s *req);
+
+/****************************************************************************
+ * Name: spi_async_cancel
+ *
+ * Description:
+ *   Remove a request that has not been started yet from the queue.  The
+ *   callback of a cancelled request is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed, -EBUSY if it is being performed
+ *   and -ENOENT if it is not queued.
+ *
+ ****************************************************************************/
+
+int spi_async_cancel(FAR struct spi_async_s *async,
+                     FAR struct spi_async_req_s *req);
+
+#endif /* CONFIG_SPI_ASYNC */
+
 /****************************************************************************
  * Name: spi_register
  *
@@ -40,6 +40,32 @@ typedef atomic_int rwlock_t;
 #define RW_SP_WRITE_LOCKED -1
 #endif
 
+#ifdef CONFIG_MCS_SPINLOCK
+#include <stdatomic.h>
+
+/* A queued (MCS) spinlock is the tail of a queue of waiters.  Each waiter
+ * spins on the flag of its own node, and the holder hands the lock over by
+ * clearing the flag of the next one.  The nodes are aligned so that no two
+ * of them share a cache line.
+ */
+
+struct mcs_node_s
+{
+  _Atomic(FAR struct mcs_node_s *) next   /* The next waiter */
+    aligned_data(CONFIG_MCS_SPINLOCK_ALIGN);
+  atomic_int locked;                      /* Nonzero while waiting */
+};
+
+struct mcs_lock_s
+{
+  _Atomic(FAR struct mcs_node_s *) tail;  /* The last waiter, NULL if free */
+};
+
+typedef struct mcs_lock_s mcs_lock_t;
+
+#define MCS_LOCK_INITIALIZER {NULL}
+#endif
+
 #ifndef CONFIG_SPINLOCK
 #  define SP_UNLOCKED 0  /* The Un-locked state */
 #  define SP_LOCKED   1  /* The Locked state */
@@ -809,4 +835,133 @@ void write_unlock_irqrestore(FAR rwlock_t *lock, irqstate_t flags);
 #endif
 
 #endif /* CONFIG_RW_SPINLOCK */
+
+#ifdef CONFIG_MCS_SPINLOCK
+
+/****************************************************************************
+ * Name: mcs_lock_init
+ *
+ * Description:
+ *   Initialize a queued spinlock to its unlocked state.
+ *
+ ****************************************************************************/
+
+#define mcs_lock_init(l) atomic_init(&(l)->tail, NULL)
+
+/****************************************************************************
+ * Name: mcs_lock
+ *
+ * Description:
+ *   Loop until the queued spinlock is locked.  The waiters get the lock in
+ *   the order in which they called this function.
+ *
+ *   This implementation is non-reentrant.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *   node - The queue node of the caller, typically on its stack.  It must
+ *          stay in place until the matching mcs_unlock().
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+void mcs_lock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node);
+
+/****************************************************************************
+ * Name: mcs_trylock
+ *
+ * Description:
+ *   Try once to lock the queued spinlock.  Do not wait if it is already
+ *   locked.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *   node - The queue node of the caller.
+ *
+ * Returned Value:
+ *   true if the spinlock was locked; false if it was already locked.
+ *
+ ****************************************************************************/
+
+bool mcs_trylock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node);
+
+/****************************************************************************
+ * Name: mcs_unlock
+ *
+ * Description:
+ *   Release the queued spinlock, handing it over to the next waiter if
+ *   there is one.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to unlock.
+ *   node - The queue node given to mcs_lock() or mcs_trylock().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void mcs_unlock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node);
+
+/****************************************************************************
+ * Name: mcs_lock_irqsave
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts and lock the queued spinlock with a node of
+ *     this CPU.  Up to four of these locks may be nested on a CPU, and they
+ *     must be released in the reverse order.
+ *
+ *     NOTE: Do not use this API with kernel APIs which suspend a caller
+ *     thread. (e.g. nxsem_wait)
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_save().
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to mcs_lock_irqsave(lock);
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP)
+irqstate_t mcs_lock_irqsave(FAR mcs_lock_t *lock);
+#else
+#  define mcs_lock_irqsave(l) ((void)(l), up_irq_save())
+#endif
+
+/****************************************************************************
+ * Name: mcs_unlock_irqrestore
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release the queued spinlock locked last by mcs_lock_irqsave() on this
+ *     CPU and restore the interrupt state as it was prior to that call.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to mcs_lock_irqsave(lock);
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP)
+void mcs_unlock_irqrestore(FAR mcs_lock_t *lock, irqstate_t flags);
+#else
+#  define mcs_unlock_irqrestore(l, f) up_irq_restore(f)
+#endif
+
+#endif /* CONFIG_MCS_SPINLOCK */
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
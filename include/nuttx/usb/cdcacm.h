@@ -158,8 +158,8 @@
  * bulk endpoint.  NOTE that difference sizes may be selected for full (FS)
  * or high speed (HS) modes.
  *
- * NOTE:  The BULKOUT request buffer size is always the same as the
- * maxpacket size.
+ * NOTE:  The BULKOUT request buffer size is the maxpacket size unless
+ * CONFIG_CDCACM_BULKOUT_REQLEN asks for more.
  */
 
 #ifndef CONFIG_CDCACM_COMPOSITE
@@ -176,6 +176,12 @@
 #  define CONFIG_CDCACM_EPBULKOUT_HSSIZE 512
 #endif
 
+/* Size of one read request, 0 means one maxpacket */
+
+#ifndef CONFIG_CDCACM_BULKOUT_REQLEN
+#  define CONFIG_CDCACM_BULKOUT_REQLEN 0
+#endif
+
 /* Number of requests in the write queue.  This includes write requests used
  * for both the interrupt and bulk IN endpoints.
  */
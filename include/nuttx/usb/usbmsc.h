@@ -50,6 +50,24 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_USBMSC_STATISTICS
+/* Read/write statistics returned by usbmsc_getstats().  The ticks count the
+ * data phases of the commands, from the parsing of the CBW until the last
+ * data was handed to the DCD (read) or to the block driver (write), so the
+ * throughput is nbytes * CLK_TCK / ticks.
+ */
+
+struct usbmsc_stats_s
+{
+  uint32_t nreadcmds;                 /* Number of READ(6/10/12) commands */
+  uint32_t nwritecmds;                /* Number of WRITE(6/10/12) commands */
+  uint64_t nreadbytes;                /* Bytes sent to the host */
+  uint64_t nwritebytes;               /* Bytes written to the media */
+  clock_t  readticks;                 /* Time spent reading */
+  clock_t  writeticks;                /* Time spent writing */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -153,6 +171,28 @@ int usbmsc_unbindlun(FAR void *handle, unsigned int lunno);
 
 int usbmsc_exportluns(FAR void *handle);
 
+/****************************************************************************
+ * Name: usbmsc_getstats
+ *
+ * Description:
+ *   Return the read/write statistics of the USB storage device, optionally
+ *   resetting them.
+ *
+ * Input Parameters:
+ *   handle - The handle returned by a previous call to usbmsc_configure().
+ *   stats  - Location to return the statistics
+ *   reset  - True: Clear the statistics after reading them
+ *
+ * Returned Value:
+ *   0 on success; a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_USBMSC_STATISTICS
+int usbmsc_getstats(FAR void *handle, FAR struct usbmsc_stats_s *stats,
+                    bool reset);
+#endif
+
 /****************************************************************************
  * Name: usbmsc_classobject
  *
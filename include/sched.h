@@ -46,6 +46,7 @@
 #define SCHED_FIFO                1  /* FIFO priority scheduling policy */
 #define SCHED_RR                  2  /* Round robin scheduling policy */
 #define SCHED_SPORADIC            3  /* Sporadic scheduling policy */
+#define SCHED_DEADLINE            4  /* Earliest deadline first policy */
 
 /* Maximum number of SCHED_SPORADIC replenishments */
 
@@ -197,6 +198,13 @@ struct sched_param
   int sched_ss_max_repl;                /* Maximum pending replenishments for
                                          * sporadic server. */
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  struct timespec sched_dl_runtime;     /* Execution time budget per period */
+  struct timespec sched_dl_deadline;    /* Deadline relative to the start of
+                                         * the period */
+  struct timespec sched_dl_period;      /* Period, the deadline if zero */
+#endif
 };
 
 /****************************************************************************
@@ -94,6 +94,10 @@ struct semholder_s
 
 #define SEM_WAITLIST_INITIALIZER {NULL, NULL}
 
+#ifdef CONFIG_SCHED_LOCKSTAT
+struct lockstat_s;
+#endif
+
 /* This is the generic semaphore structure. */
 
 struct sem_s
@@ -116,6 +120,10 @@ struct sem_s
   struct semholder_s holder;     /* Slot for old and new holder */
 #  endif
 #endif
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  FAR struct lockstat_s *lockstat; /* Lock class of the semaphore */
+#endif
 };
 
 typedef struct sem_s sem_t;
@@ -24,10 +24,13 @@
 
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -35,6 +38,15 @@
 
 #define NXMUTEX_RESET          ((pid_t)-2)
 
+/* A locked mutex is spun on while its holder runs on another CPU.  That
+ * needs the TCB of the holder, which only the kernel can see.
+ */
+
+#if defined(CONFIG_MUTEX_ADAPTIVE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define HAVE_NXMUTEX_ADAPTIVE 1
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -57,6 +69,95 @@ static bool nxmutex_is_reset(FAR mutex_t *mutex)
   return mutex->holder == NXMUTEX_RESET;
 }
 
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Spin on the mutex while its holder is running, since it will likely
+ *   unlock it before the caller could sleep and be woken up again.  The
+ *   mutex is only read while it is locked, so that the spinning CPUs do
+ *   not take the critical section of the semaphore; only the state of
+ *   the holder is checked under it, once per spin.  The time spun before
+ *   the mutex was taken is counted as a contended wait by the lock
+ *   statistics.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   true if the mutex was taken; false if the caller has to wait for it.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_NXMUTEX_ADAPTIVE
+static bool nxmutex_spin(FAR mutex_t *mutex)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  bool running;
+  pid_t curr;
+  int spins;
+#ifdef CONFIG_SCHED_LOCKSTAT
+  clock_t waitstart = 0;
+  pid_t waitholder = INVALID_PROCESS_ID;
+#endif
+
+  for (spins = 0; spins < CONFIG_MUTEX_ADAPTIVE_SPINS; spins++)
+    {
+      if (mutex->sem.semcount > 0 && nxsem_trywait(&mutex->sem) >= 0)
+        {
+#ifdef CONFIG_SCHED_LOCKSTAT
+          if (waitstart != 0)
+            {
+              lockstat_sem_spun(&mutex->sem, waitstart, waitholder);
+            }
+#endif
+
+          return true;
+        }
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+      /* Note who we are spinning for before the holder changes */
+
+      if (waitstart == 0)
+        {
+          waitholder = lockstat_sem_contend(&mutex->sem);
+          waitstart  = perf_gettime();
+        }
+#endif
+
+      /* The holder is not known yet right after the mutex is taken */
+
+      curr = *(FAR volatile pid_t *)&mutex->holder;
+      if (curr >= 0)
+        {
+          /* The holder may exit and its TCB be freed at any time, so it is
+           * looked up again and only read inside the critical section.
+           */
+
+          flags   = enter_critical_section();
+          tcb     = nxsched_get_tcb(curr);
+          running = tcb != NULL &&
+                    tcb->task_state == TSTATE_TASK_RUNNING;
+          leave_critical_section(flags);
+
+          /* Stop spinning as soon as the holder does not run */
+
+          if (!running)
+            {
+              break;
+            }
+        }
+
+      /* Do not read the mutex again ahead of the checks above */
+
+      SP_DMB();
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -197,6 +298,17 @@ int nxmutex_lock(FAR mutex_t *mutex)
   int ret;
 
   DEBUGASSERT(!nxmutex_is_hold(mutex));
+
+#ifdef HAVE_NXMUTEX_ADAPTIVE
+  /* Spin first if the holder is running on another CPU */
+
+  if (nxmutex_spin(mutex))
+    {
+      mutex->holder = _SCHED_GETTID();
+      return OK;
+    }
+#endif
+
   for (; ; )
     {
       /* Take the semaphore (perhaps waiting) */
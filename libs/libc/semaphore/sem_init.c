@@ -85,6 +85,11 @@ int nxsem_init(FAR sem_t *sem, int pshared, unsigned int value)
   INITIALIZE_SEMHOLDER(&sem->holder);
 #  endif
 #endif
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  sem->lockstat = NULL;
+#endif
+
   return OK;
 }
 
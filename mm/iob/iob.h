@@ -31,6 +31,7 @@
 
 #include <nuttx/mm/iob.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_MM_IOB
 
@@ -48,6 +49,19 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Every CPU that sends or receives takes g_iob_lock, so it is a queued
+ * spinlock when those are available:  Its waiters then do not all spin on
+ * the same cache line, and they get the lock in turn.
+ */
+
+#ifdef CONFIG_MCS_SPINLOCK
+#  define iob_lock()                mcs_lock_irqsave(&g_iob_lock)
+#  define iob_unlock(flags)         mcs_unlock_irqrestore(&g_iob_lock, flags)
+#else
+#  define iob_lock()                spin_lock_irqsave(&g_iob_lock)
+#  define iob_unlock(flags)         spin_unlock_irqrestore(&g_iob_lock, flags)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -70,14 +84,33 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
-/* Counting semaphores that tracks the number of free IOBs/qentries */
+/* Protects the lists and the counts of the I/O buffers and of their queue
+ * containers, and the queues of I/O buffer chains.  Nothing else is ever
+ * locked or posted while it is held.
+ */
+
+#ifdef CONFIG_MCS_SPINLOCK
+extern mcs_lock_t g_iob_lock;
+#else
+extern spinlock_t g_iob_lock;
+#endif
+
+/* The number of free I/O buffers and of the threads waiting for one.  The
+ * waiters sleep on the semaphores, which are posted once for each buffer
+ * committed to them.
+ */
 
-extern sem_t g_iob_sem;       /* Counts free I/O buffers */
+extern int16_t g_iob_count;   /* Counts free I/O buffers */
+extern int16_t g_iob_nwait;   /* Counts threads waiting for an I/O buffer */
+extern sem_t g_iob_sem;
 #if CONFIG_IOB_THROTTLE > 0
-extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
+extern int16_t g_throttle_nwait; /* Counts threads waiting when throttled */
+extern sem_t g_throttle_sem;
 #endif
 #if CONFIG_IOB_NCHAINS > 0
-extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
+extern int16_t g_qentry_count; /* Counts free I/O buffer queue containers */
+extern int16_t g_qentry_nwait; /* Counts threads waiting for a container */
+extern sem_t g_qentry_sem;
 #endif
 
 /****************************************************************************
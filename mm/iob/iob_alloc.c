@@ -38,21 +38,43 @@
  * Private Functions
  ****************************************************************************/
 
-static clock_t iob_allocwait_gettimeout(clock_t start, unsigned int timeout)
+/****************************************************************************
+ * Name: iob_tryalloc_internal
+ *
+ * Description:
+ *   Take the I/O buffer at the head of the free list, unless that would
+ *   leave fewer free buffers than the allocation must leave.  g_iob_lock
+ *   must be held.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_tryalloc_internal(bool throttled)
 {
-  sclock_t tick;
+  FAR struct iob_s *iob;
+  int16_t reserved = 0;
 
-  tick = clock_systime_ticks() - start;
-  if (tick >= MSEC2TICK(timeout))
+#if CONFIG_IOB_THROTTLE > 0
+  /* A throttled allocation leaves some buffers for the others */
+
+  if (throttled)
     {
-      tick = 0;
+      reserved = CONFIG_IOB_THROTTLE;
     }
-  else
+#endif
+
+  if (g_iob_count <= reserved)
     {
-      tick = MSEC2TICK(timeout) - tick;
+      return NULL;
     }
 
-  return tick;
+  /* Remove the I/O buffer from the free list */
+
+  iob = g_iob_freelist;
+  DEBUGASSERT(iob != NULL);
+
+  g_iob_freelist = iob->io_flink;
+  g_iob_count--;
+  return iob;
 }
 
 /****************************************************************************
@@ -60,20 +82,13 @@ static clock_t iob_allocwait_gettimeout(clock_t start, unsigned int timeout)
  *
  * Description:
  *   Allocate an I/O buffer by taking the buffer at the head of the committed
- *   list.
+ *   list.  g_iob_lock must be held.
  *
  ****************************************************************************/
 
 static FAR struct iob_s *iob_alloc_committed(void)
 {
-  FAR struct iob_s *iob = NULL;
-  irqstate_t flags;
-
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the committed list:  We disable interrupts very briefly.
-   */
-
-  flags = enter_critical_section();
+  FAR struct iob_s *iob;
 
   /* Take the I/O buffer from the head of the committed list */
 
@@ -83,16 +98,8 @@ static FAR struct iob_s *iob_alloc_committed(void)
       /* Remove the I/O buffer from the committed list */
 
       g_iob_committed = iob->io_flink;
-
-      /* Put the I/O buffer in a known state */
-
-      iob->io_flink  = NULL; /* Not in a chain */
-      iob->io_len    = 0;    /* Length of the data in the entry */
-      iob->io_offset = 0;    /* Offset to the beginning of data */
-      iob->io_pktlen = 0;    /* Total length of the packet */
     }
 
-  leave_critical_section(flags);
   return iob;
 }
 
@@ -108,92 +115,96 @@ static FAR struct iob_s *iob_alloc_committed(void)
 static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
 {
   FAR struct iob_s *iob;
+  FAR int16_t *nwait;
   irqstate_t flags;
   FAR sem_t *sem;
-  clock_t start;
-  int ret = OK;
+  int ret;
 
 #if CONFIG_IOB_THROTTLE > 0
-  /* Select the semaphore count to check. */
+  /* Select the semaphore and the count of the waiters */
 
-  sem = (throttled ? &g_throttle_sem : &g_iob_sem);
-#else
-  sem = &g_iob_sem;
+  if (throttled)
+    {
+      sem   = &g_throttle_sem;
+      nwait = &g_throttle_nwait;
+    }
+  else
 #endif
+    {
+      sem   = &g_iob_sem;
+      nwait = &g_iob_nwait;
+    }
 
-  /* The following must be atomic; interrupt must be disabled so that there
-   * is no conflict with interrupt level I/O buffer allocations.  This is
-   * not as bad as it sounds because interrupts will be re-enabled while
-   * we are waiting for I/O buffers to become free.
+  /* Try to get an I/O buffer.  If there is none, become a waiter in the
+   * same locked section, so that iob_free() commits the next buffer to us.
    */
 
-  flags = enter_critical_section();
+  flags = iob_lock();
+  iob   = iob_tryalloc_internal(throttled);
+  if (iob == NULL)
+    {
+      (*nwait)++;
+    }
 
-  /* Try to get an I/O buffer.  If successful, the semaphore count will be
-   * decremented atomically.
-   */
+  iob_unlock(flags);
 
-  start = clock_systime_ticks();
-  iob   = iob_tryalloc(throttled);
-  while (ret == OK && iob == NULL)
+  if (iob == NULL)
     {
-      /* If not successful, then the semaphore count was less than or equal
-       * to zero (meaning that there are no free buffers).  We need to wait
-       * for an I/O buffer to be released and placed in the committed
-       * list.
-       */
-
-      if (timeout == UINT_MAX)
-        {
-          ret = nxsem_wait_uninterruptible(sem);
-        }
-      else
-        {
-          ret = nxsem_tickwait_uninterruptible(sem,
-                                   iob_allocwait_gettimeout(start, timeout));
-        }
+      /* Wait for an I/O buffer to be committed to us */
 
-      if (ret >= 0)
+      for (; ; )
         {
-          /* When we wake up from wait successfully, an I/O buffer was
-           * freed and we hold a count for one IOB.
-           */
+          if (timeout == UINT_MAX)
+            {
+              ret = nxsem_wait_uninterruptible(sem);
+            }
+          else
+            {
+              ret = nxsem_tickwait_uninterruptible(sem, MSEC2TICK(timeout));
+            }
 
-          iob = iob_alloc_committed();
-          if (iob == NULL)
+          flags = iob_lock();
+          if (ret >= 0)
             {
-              /* We need release our count so that it is available to
-               * iob_tryalloc(), perhaps allowing another thread to take our
-               * count.  In that event, iob_tryalloc() will fail above and
-               * we will have to wait again.
+              /* We hold a post of the semaphore, for which one I/O buffer
+               * was put in the committed list.
                */
 
-              sem->semcount++;
-              iob = iob_tryalloc(throttled);
+              iob = iob_alloc_committed();
+              DEBUGASSERT(iob != NULL);
+              break;
             }
 
-          /* REVISIT: I think this logic should be moved inside of
-           * iob_alloc_committed, so that it can exist inside of the critical
-           * section along with all other sem count changes.
-           */
-
-#if CONFIG_IOB_THROTTLE > 0
-          else
+          if (*nwait > 0)
             {
-              if (throttled)
-                {
-                  g_iob_sem.semcount--;
-                }
-              else
-                {
-                  g_throttle_sem.semcount--;
-                }
+              /* No I/O buffer was committed to us, so give up */
+
+              (*nwait)--;
+              break;
             }
-#endif
+
+          /* The wait failed, but iob_free() has already committed an I/O
+           * buffer to each of the remaining waiters and is about to post
+           * the semaphore.  Wait for that post.
+           */
+
+          iob_unlock(flags);
+          timeout = UINT_MAX;
         }
+
+      iob_unlock(flags);
+    }
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
     }
 
-  leave_critical_section(flags);
   return iob;
 }
 
@@ -258,74 +269,24 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
 {
   FAR struct iob_s *iob;
   irqstate_t flags;
-#if CONFIG_IOB_THROTTLE > 0
-  FAR sem_t *sem;
-#endif
-
-#if CONFIG_IOB_THROTTLE > 0
-  /* Select the semaphore count to check. */
 
-  sem = (throttled ? &g_throttle_sem : &g_iob_sem);
-#endif
-
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly, and take the IOB spinlock against the other CPUs.
    */
 
-  flags = enter_critical_section();
+  flags = iob_lock();
+  iob   = iob_tryalloc_internal(throttled);
+  iob_unlock(flags);
 
-#if CONFIG_IOB_THROTTLE > 0
-  /* If there are free I/O buffers for this allocation */
-
-  if (sem->semcount > 0 ||
-      (throttled && g_iob_sem.semcount - CONFIG_IOB_THROTTLE > 0))
-#endif
+  if (iob != NULL)
     {
-      /* Take the I/O buffer from the head of the free list */
-
-      iob = g_iob_freelist;
-      if (iob != NULL)
-        {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
-
-          g_iob_freelist = iob->io_flink;
-
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
-
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
-
-#if CONFIG_IOB_THROTTLE > 0
-          /* The throttle semaphore is a little more complicated because
-           * it can be negative!  Decrementing is still safe, however.
-           *
-           * Note: usually g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE.
-           * But it can be smaller than that if there are blocking threads.
-           */
-
-          g_throttle_sem.semcount--;
-#endif
-
-          leave_critical_section(flags);
-
-          /* Put the I/O buffer in a known state */
+      /* Put the I/O buffer in a known state */
 
-          iob->io_flink  = NULL; /* Not in a chain */
-          iob->io_len    = 0;    /* Length of the data in the entry */
-          iob->io_offset = 0;    /* Offset to the beginning of data */
-          iob->io_pktlen = 0;    /* Total length of the packet */
-          return iob;
-        }
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
     }
 
-  leave_critical_section(flags);
-  return NULL;
+  return iob;
 }
@@ -39,25 +39,46 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_tryalloc_qinternal
+ *
+ * Description:
+ *   Take the I/O buffer chain container at the head of the free list.
+ *   g_iob_lock must be held.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_qentry_s *iob_tryalloc_qinternal(void)
+{
+  FAR struct iob_qentry_s *iobq;
+
+  iobq = g_iob_freeqlist;
+  if (iobq != NULL)
+    {
+      /* Remove the I/O buffer chain container from the free list and
+       * decrement the count of free containers.
+       */
+
+      g_iob_freeqlist = iobq->qe_flink;
+      g_qentry_count--;
+      DEBUGASSERT(g_qentry_count >= 0);
+    }
+
+  return iobq;
+}
+
 /****************************************************************************
  * Name: iob_alloc_qcommitted
  *
  * Description:
  *   Allocate an I/O buffer by taking the buffer at the head of the committed
- *   list.
+ *   list.  g_iob_lock must be held.
  *
  ****************************************************************************/
 
 static FAR struct iob_qentry_s *iob_alloc_qcommitted(void)
 {
-  FAR struct iob_qentry_s *iobq = NULL;
-  irqstate_t flags;
-
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the committed list:  We disable interrupts very briefly.
-   */
-
-  flags = enter_critical_section();
+  FAR struct iob_qentry_s *iobq;
 
   /* Take the I/O buffer from the head of the committed list */
 
@@ -67,13 +88,8 @@ static FAR struct iob_qentry_s *iob_alloc_qcommitted(void)
       /* Remove the I/O buffer from the committed list */
 
       g_iob_qcommitted = iobq->qe_flink;
-
-      /* Put the I/O buffer in a known state */
-
-      iobq->qe_head = NULL; /* Nothing is contained */
     }
 
-  leave_critical_section(flags);
   return iobq;
 }
 
@@ -91,60 +107,68 @@ static FAR struct iob_qentry_s *iob_allocwait_qentry(void)
 {
   FAR struct iob_qentry_s *qentry;
   irqstate_t flags;
-  int ret = OK;
+  int ret;
 
-  /* The following must be atomic; interrupt must be disabled so that there
-   * is no conflict with interrupt level I/O buffer chain container
-   * allocations.  This is not as bad as it sounds because interrupts will be
-   * re-enabled while we are waiting for I/O buffers to become free.
+  /* Try to get an I/O buffer chain container.  If there is none, become a
+   * waiter in the same locked section, so that iob_free_qentry() commits
+   * the next container to us.
    */
 
-  flags = enter_critical_section();
+  flags  = iob_lock();
+  qentry = iob_tryalloc_qinternal();
+  if (qentry == NULL)
+    {
+      g_qentry_nwait++;
+    }
 
-  /* Try to get an I/O buffer chain container.  If successful, the semaphore
-   * count will bedecremented atomically.
-   */
+  iob_unlock(flags);
 
-  qentry = iob_tryalloc_qentry();
-  while (ret == OK && qentry == NULL)
+  if (qentry == NULL)
     {
-      /* If not successful, then the semaphore count was less than or equal
-       * to zero (meaning that there are no free buffers).  We need to wait
-       * for an I/O buffer chain container to be released when the
-       * semaphore count will be incremented.
-       */
+      /* Wait for an I/O buffer chain container to be committed to us */
 
-      ret = nxsem_wait_uninterruptible(&g_qentry_sem);
-      if (ret >= 0)
+      for (; ; )
         {
-          /* When we wake up from wait successfully, an I/O buffer chain
-           * container was freed and we hold a count for one IOB.  Unless
-           * something failed, we should have an IOB waiting for us in the
-           * committed list.
-           */
-
-          qentry = iob_alloc_qcommitted();
-          DEBUGASSERT(qentry != NULL);
+          ret   = nxsem_wait_uninterruptible(&g_qentry_sem);
+          flags = iob_lock();
 
-          if (qentry == NULL)
+          if (ret >= 0)
             {
-              /* This should not fail, but we allow for that possibility to
-               * handle any potential, non-obvious race condition.  Perhaps
-               * the free IOB ended up in the g_iob_free list?
-               *
-               * We need release our count so that it is available to
-               * iob_tryalloc(), perhaps allowing another thread to take our
-               * count.  In that event, iob_tryalloc() will fail above and
-               * we will have to wait again.
+              /* We hold a post of the semaphore, for which one container
+               * was put in the committed list.
                */
 
-              nxsem_post(&g_qentry_sem);
-              qentry = iob_tryalloc_qentry();
+              qentry = iob_alloc_qcommitted();
+              DEBUGASSERT(qentry != NULL);
+              break;
             }
+
+          if (g_qentry_nwait > 0)
+            {
+              /* No container was committed to us, so give up */
+
+              g_qentry_nwait--;
+              break;
+            }
+
+          /* The wait failed, but iob_free_qentry() has already committed a
+           * container to each of the remaining waiters and is about to
+           * post the semaphore.  Wait for that post.
+           */
+
+          iob_unlock(flags);
         }
+
+      iob_unlock(flags);
+    }
+
+  if (qentry != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      qentry->qe_head = NULL; /* Nothing is contained */
     }
 
-  leave_critical_section(flags);
   return qentry;
 }
 
@@ -195,37 +219,21 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
   FAR struct iob_qentry_s *iobq;
   irqstate_t flags;
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
+  /* We don't know what context we are called from so we disable interrupts
+   * very briefly, and take the IOB spinlock against the other CPUs.
    */
 
-  flags = enter_critical_section();
-  iobq  = g_iob_freeqlist;
-  if (iobq)
-    {
-      /* Remove the I/O buffer chain container from the free list and
-       * decrement the counting semaphore that tracks the number of free
-       * containers.
-       */
-
-      g_iob_freeqlist = iobq->qe_flink;
-
-      /* Take a semaphore count.  Note that we cannot do this in
-       * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-       * because this function may be called from an interrupt
-       * handler. Fortunately we know at at least one free buffer
-       * so a simple decrement is all that is needed.
-       */
-
-      g_qentry_sem.semcount--;
-      DEBUGASSERT(g_qentry_sem.semcount >= 0);
+  flags = iob_lock();
+  iobq  = iob_tryalloc_qinternal();
+  iob_unlock(flags);
 
+  if (iobq != NULL)
+    {
       /* Put the I/O buffer in a known state */
 
       iobq->qe_head = NULL; /* Nothing is contained */
     }
 
-  leave_critical_section(flags);
   return iobq;
 }
 
@@ -74,6 +74,7 @@
 FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 {
   FAR struct iob_s *next = iob->io_flink;
+  FAR sem_t *sem;
   irqstate_t flags;
 #ifdef CONFIG_IOB_NOTIFIER
   int16_t navail;
@@ -114,19 +115,36 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
-   * we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
+   * we disable interrupts very briefly, and take the IOB spinlock against
+   * the other CPUs.
    */
 
-  flags = enter_critical_section();
+  flags = iob_lock();
 
   /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
+   * the IOB on the committed list where it is reserved for that
+   * allocation (and not available to iob_tryalloc()).  A throttled
+   * waiter only gets it if enough IOBs stay free for the others.
    */
 
-  if (g_iob_sem.semcount < 0)
+  if (g_iob_nwait > 0)
+    {
+      g_iob_nwait--;
+      sem = &g_iob_sem;
+    }
+#if CONFIG_IOB_THROTTLE > 0
+  else if (g_throttle_nwait > 0 && g_iob_count >= CONFIG_IOB_THROTTLE)
+    {
+      g_throttle_nwait--;
+      sem = &g_throttle_sem;
+    }
+#endif
+  else
+    {
+      sem = NULL;
+    }
+
+  if (sem != NULL)
     {
       iob->io_flink   = g_iob_committed;
       g_iob_committed = iob;
@@ -135,41 +153,36 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
     {
       iob->io_flink   = g_iob_freelist;
       g_iob_freelist  = iob;
+      g_iob_count++;
+      DEBUGASSERT(g_iob_count <= CONFIG_IOB_NBUFFERS);
     }
 
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
+#ifdef CONFIG_IOB_NOTIFIER
+  navail = g_iob_count;
+#endif
 
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+  iob_unlock(flags);
 
-#if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
-#endif
+  /* Wake up the thread that the IOB was committed to.  It will find the
+   * IOB in the committed list.
+   */
+
+  if (sem != NULL)
+    {
+      nxsem_post(sem);
+    }
 
 #ifdef CONFIG_IOB_NOTIFIER
-  /* Check if the IOB was claimed by a thread that is blocked waiting
-   * for an IOB.
+  /* Signal any threads that have requested a signal notification
+   * when an IOB becomes available.
    */
 
-  navail = iob_navail(false);
   if (navail > 0 && (navail & IOB_MASK) == 0)
     {
-      /* Signal any threads that have requested a signal notification
-       * when an IOB becomes available.
-       */
-
       iob_notifier_signal();
     }
 #endif
 
-  leave_critical_section(flags);
-
   /* And return the I/O buffer after the one that was freed */
 
   return next;
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
@@ -51,23 +52,25 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq)
 {
   FAR struct iob_qentry_s *nextq = iobq->qe_flink;
   irqstate_t flags;
+  bool committed;
 
   /* Free the I/O buffer chain container by adding it to the head of the
    * free or the committed list. We don't know what context we are called
-   * from so we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
+   * from so we disable interrupts very briefly, and take the IOB spinlock
+   * against the other CPUs.
    */
 
-  flags = enter_critical_section();
+  flags = iob_lock();
 
   /* Which list?  If there is a task waiting for an IOB chain, then put
-   * the IOB chain on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc_qentry()).
+   * the IOB chain on the committed list where it is reserved for that
+   * allocation (and not available to iob_tryalloc_qentry()).
    */
 
-  if (g_qentry_sem.semcount < 0)
+  committed = g_qentry_nwait > 0;
+  if (committed)
     {
+      g_qentry_nwait--;
       iobq->qe_flink   = g_iob_qcommitted;
       g_iob_qcommitted = iobq;
     }
@@ -75,17 +78,20 @@ FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq)
     {
       iobq->qe_flink   = g_iob_freeqlist;
       g_iob_freeqlist  = iobq;
+      g_qentry_count++;
+      DEBUGASSERT(g_qentry_count <= CONFIG_IOB_NCHAINS);
     }
 
-  /* Signal that an I/O buffer chain container is available.  If there
-   * is a thread waiting for an I/O buffer chain container, this will
-   * wake up exactly one thread.  The semaphore count will correctly
-   * indicated that the awakened task owns an I/O buffer chain container
-   * and should find it in the committed list.
+  iob_unlock(flags);
+
+  /* Wake up the thread that the I/O buffer chain container was committed
+   * to.  It will find the container in the committed list.
    */
 
-  nxsem_post(&g_qentry_sem);
-  leave_critical_section(flags);
+  if (committed)
+    {
+      nxsem_post(&g_qentry_sem);
+    }
 
   /* And return the I/O buffer chain container after the one that was freed */
 
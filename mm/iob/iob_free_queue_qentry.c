@@ -51,7 +51,7 @@ void iob_free_queue_qentry(FAR struct iob_s *iob,
   FAR struct iob_qentry_s *prev = NULL;
   FAR struct iob_qentry_s *qentry;
 
-  irqstate_t flags = enter_critical_section();
+  irqstate_t flags = iob_lock();
   for (qentry = iobq->qh_head; qentry != NULL;
        prev = qentry, qentry = qentry->qe_flink)
     {
@@ -73,19 +73,21 @@ void iob_free_queue_qentry(FAR struct iob_s *iob,
               iobq->qh_tail = prev;
             }
 
-          /* Remove the queue container */
-
-          iob_free_qentry(qentry);
-
-          /* Free the I/O chain */
-
-          iob_free_chain(iob);
-
           break;
         }
     }
 
-  leave_critical_section(flags);
+  iob_unlock(flags);
+
+  /* Free the queue container and the I/O chain, which take the lock
+   * again.
+   */
+
+  if (qentry != NULL)
+    {
+      iob_free_qentry(qentry);
+      iob_free_chain(iob);
+    }
 }
 
 #endif /* CONFIG_IOB_NCHAINS > 0 */
@@ -85,21 +85,33 @@ FAR struct iob_qentry_s *g_iob_freeqlist;
 FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
-/* Counting semaphores that tracks the number of free IOBs/qentries */
+/* Protects the lists, the counts and the queues of I/O buffer chains */
 
-sem_t g_iob_sem = SEM_INITIALIZER(CONFIG_IOB_NBUFFERS);
+#ifdef CONFIG_MCS_SPINLOCK
+mcs_lock_t g_iob_lock = MCS_LOCK_INITIALIZER;
+#else
+spinlock_t g_iob_lock = SP_UNLOCKED;
+#endif
+
+/* The number of free I/O buffers and of the threads waiting for one */
+
+int16_t g_iob_count = CONFIG_IOB_NBUFFERS;
+int16_t g_iob_nwait;
+sem_t g_iob_sem = SEM_INITIALIZER(0);
 
 #if CONFIG_IOB_THROTTLE > 0
-/* Counts available I/O buffers when throttled */
+/* The number of threads waiting for a throttled I/O buffer */
 
-sem_t g_throttle_sem = SEM_INITIALIZER(CONFIG_IOB_NBUFFERS -
-                                       CONFIG_IOB_THROTTLE);
+int16_t g_throttle_nwait;
+sem_t g_throttle_sem = SEM_INITIALIZER(0);
 #endif
 
 #if CONFIG_IOB_NCHAINS > 0
-/* Counts free I/O buffer queue containers */
+/* The number of free I/O buffer queue containers and of their waiters */
 
-sem_t g_qentry_sem = SEM_INITIALIZER(CONFIG_IOB_NCHAINS);
+int16_t g_qentry_count = CONFIG_IOB_NCHAINS;
+int16_t g_qentry_nwait;
+sem_t g_qentry_sem = SEM_INITIALIZER(0);
 #endif
 
 /****************************************************************************
@@ -44,34 +44,26 @@
 
 int iob_navail(bool throttled)
 {
-  int navail = 0;
-  int ret;
+  int ret = 0;
 
 #if CONFIG_IOB_NBUFFERS > 0
-  /* Get the value of the IOB counting semaphores */
+  /* Get the count of the free IOBs */
 
-  ret = nxsem_get_value(&g_iob_sem, &navail);
-  if (ret >= 0)
-    {
-      ret = navail;
+  ret = g_iob_count;
 
 #if CONFIG_IOB_THROTTLE > 0
-      /* Subtract the throttle value is so requested */
+  /* Subtract the throttle value is so requested */
 
-      if (throttled)
-        {
-          ret -= CONFIG_IOB_THROTTLE;
-        }
+  if (throttled)
+    {
+      ret -= CONFIG_IOB_THROTTLE;
+    }
 #endif
 
-      if (ret < 0)
-        {
-          ret = 0;
-        }
+  if (ret < 0)
+    {
+      ret = 0;
     }
-
-#else
-  ret = navail;
 #endif
 
   return ret;
@@ -87,24 +79,12 @@ int iob_navail(bool throttled)
 
 int iob_qentry_navail(void)
 {
-  int navail = 0;
-  int ret;
+  int ret = 0;
 
 #if CONFIG_IOB_NCHAINS > 0
-  /* Get the value of the IOB chain qentry counting semaphores */
-
-  ret = nxsem_get_value(&g_qentry_sem, &navail);
-  if (ret >= 0)
-    {
-      ret = navail;
-      if (ret < 0)
-        {
-          ret = 0;
-        }
-    }
+  /* Get the count of the free IOB chain qentries */
 
-#else
-  ret = navail;
+  ret = g_qentry_count;
 #endif
 
   return ret;
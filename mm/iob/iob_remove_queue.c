@@ -56,7 +56,7 @@ FAR struct iob_s *iob_remove_queue(FAR struct iob_queue_s *iobq)
 
   /* Remove the I/O buffer chain from the head of the queue */
 
-  irqstate_t flags = enter_critical_section();
+  irqstate_t flags = iob_lock();
   qentry = iobq->qh_head;
   if (qentry)
     {
@@ -66,15 +66,20 @@ FAR struct iob_s *iob_remove_queue(FAR struct iob_queue_s *iobq)
           iobq->qh_tail = NULL;
         }
 
-      /* Extract the I/O buffer chain from the container and free the
-       * container.
-       */
+      /* Extract the I/O buffer chain from the container */
 
       iob = qentry->qe_head;
+    }
+
+  iob_unlock(flags);
+
+  /* And free the container, which takes the lock again */
+
+  if (qentry)
+    {
       iob_free_qentry(qentry);
     }
 
-  leave_critical_section(flags);
   return iob;
 }
 
@@ -54,28 +54,14 @@ void iob_getstats(FAR struct iob_stats_s *stats)
 {
   stats->ntotal = CONFIG_IOB_NBUFFERS;
 
-  nxsem_get_value(&g_iob_sem, &stats->nfree);
-  if (stats->nfree < 0)
-    {
-      stats->nwait = -stats->nfree;
-      stats->nfree = 0;
-    }
-  else
-    {
-      stats->nwait = 0;
-    }
+  stats->nfree = g_iob_count;
+  stats->nwait = g_iob_nwait;
 
 #if CONFIG_IOB_THROTTLE > 0
-  nxsem_get_value(&g_throttle_sem, &stats->nthrottle);
-  if (stats->nthrottle < 0)
-    {
-      stats->nthrottle = -stats->nthrottle;
-    }
-  else
+  stats->nthrottle = g_throttle_nwait;
+#else
+  stats->nthrottle = 0;
 #endif
-    {
-      stats->nthrottle = 0;
-    }
 }
 
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
@@ -32,6 +32,7 @@
 #include <nuttx/sched.h>
 
 #include "kasan/kasan.h"
+#include "mm_profile/mm_profile.h"
 
 #if UINTPTR_MAX <= UINT32_MAX
 #  define MM_PTR_FMT_WIDTH 11
@@ -105,6 +106,8 @@ static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
     {
       buf->backtrace[0] = NULL;
     }
+
+  mm_profile_alloc(buf->backtrace, pool->blocksize);
 #  endif
 }
 #endif
@@ -312,6 +315,7 @@ void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 
   DEBUGASSERT(list_in_list(&buf->node));
   list_delete(&buf->node);
+  mm_profile_free(buf->backtrace, pool->blocksize);
 #else
   pool->nalloc--;
 #endif
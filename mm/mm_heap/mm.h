@@ -33,6 +33,8 @@
 #include <nuttx/lib/math32.h>
 #include <nuttx/mm/mempool.h>
 
+#include "mm_profile/mm_profile.h"
+
 #include <assert.h>
 #include <sys/types.h>
 #include <stdbool.h>
@@ -157,6 +159,15 @@
 #define MM_PREVNODE_IS_ALLOC(node) (((node)->size & MM_PREVFREE_BIT) == 0)
 #define MM_PREVNODE_IS_FREE(node) (((node)->size & MM_PREVFREE_BIT) != 0)
 
+/* Count an allocated node in the allocation profiler */
+
+#define MM_PROFILE_ALLOC(node) \
+  mm_profile_alloc((node)->backtrace, \
+                   MM_SIZEOF_NODE(node) - MM_ALLOCNODE_OVERHEAD)
+#define MM_PROFILE_FREE(node) \
+  mm_profile_free((node)->backtrace, \
+                  MM_SIZEOF_NODE(node) - MM_ALLOCNODE_OVERHEAD)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
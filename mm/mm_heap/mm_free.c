@@ -119,6 +119,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
   DEBUGASSERT(MM_NODE_IS_ALLOC(node));
 
+  MM_PROFILE_FREE(node);
   node->size &= ~MM_ALLOC_BIT;
 
   /* Check if the following node is free and, if so, merge it */
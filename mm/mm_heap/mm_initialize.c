@@ -28,6 +28,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/lockstat.h>
 #include <nuttx/mm/mm.h>
 
 #include "mm_heap/mm.h"
@@ -258,6 +259,11 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   nxmutex_init(&heap->mm_lock);
 
+#if defined(CONFIG_SCHED_LOCKSTAT) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+  lockstat_bind_sem(&heap->mm_lock.sem, "mm_lock");
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
 #  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
   heap->mm_procfs.name = name;
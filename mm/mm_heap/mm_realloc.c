@@ -137,6 +137,8 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
   oldsize = MM_SIZEOF_NODE(oldnode);
   if (newsize <= oldsize)
     {
+      MM_PROFILE_FREE(oldnode);
+
       /* Handle the special case where we are not going to change the size
        * of the allocation.
        */
@@ -152,6 +154,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
       mm_unlock(heap);
       MM_ADD_BACKTRACE(heap, oldnode);
+      MM_PROFILE_ALLOC(oldnode);
 
       return oldmem;
     }
@@ -185,6 +188,8 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       size_t takeprev;
       size_t takenext;
 
+      MM_PROFILE_FREE(oldnode);
+
       /* Check if we can extend into the previous chunk and if the
        * previous chunk is smaller than the next chunk.
        */
@@ -367,6 +372,8 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
       mm_unlock(heap);
       MM_ADD_BACKTRACE(heap, (FAR char *)newmem - MM_SIZEOF_ALLOCNODE);
+      MM_PROFILE_ALLOC((FAR struct mm_allocnode_s *)
+                       ((FAR char *)newmem - MM_SIZEOF_ALLOCNODE));
 
       kasan_unpoison(newmem, mm_malloc_size(heap, newmem));
       if (newmem != oldmem)
@@ -0,0 +1,357 @@
+/****************************************************************************
+ * mm/mm_profile/mm_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+
+#include "mm_profile/mm_profile.h"
+
+#ifdef MM_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Slots probed for a call site before the allocation is counted as
+ * dropped.
+ */
+
+#define MM_PROFILE_PROBES 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mm_profile_slot_s
+{
+  bool used;                        /* The slot holds a call site */
+  struct mm_profile_site_s site;    /* The call site and its counters */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mm_profile_slot_s g_mm_profile[CONFIG_MM_PROFILE_NSITES];
+static struct mm_profile_sample_s g_mm_totals;
+static uint32_t g_mm_dropped;
+
+#if CONFIG_MM_PROFILE_NHISTORY > 0
+static struct mm_profile_sample_s g_mm_history[CONFIG_MM_PROFILE_NHISTORY];
+static unsigned int g_mm_nhistory;  /* Valid samples in g_mm_history */
+static unsigned int g_mm_hhead;     /* Slot of the next sample */
+static clock_t g_mm_nextsample;     /* Time the next sample is due */
+#endif
+
+/* Protects all of the above.  Allocations and frees may come from any
+ * context that can take the heap or mempool locks.
+ */
+
+static spinlock_t g_mm_profile_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profile_depth
+ ****************************************************************************/
+
+static uint8_t mm_profile_depth(FAR void * const *backtrace)
+{
+  uint8_t depth = 0;
+
+  while (depth < CONFIG_MM_BACKTRACE && backtrace[depth] != NULL)
+    {
+      depth++;
+    }
+
+  return depth;
+}
+
+/****************************************************************************
+ * Name: mm_profile_hash
+ ****************************************************************************/
+
+static uint32_t mm_profile_hash(FAR void * const *backtrace, uint8_t depth)
+{
+  uint32_t hash = depth;
+  int i;
+
+  for (i = 0; i < depth; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)backtrace[i]) * 2654435761u;
+    }
+
+  return hash ^ (hash >> 16);
+}
+
+/****************************************************************************
+ * Name: mm_profile_find
+ *
+ * Description:
+ *   Find the call site of a backtrace, claiming a free slot for a call site
+ *   not seen before if alloc is true.
+ *
+ * Assumptions:
+ *   g_mm_profile_lock is held.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_profile_site_s *
+mm_profile_find(FAR void * const *backtrace, bool alloc)
+{
+  FAR struct mm_profile_slot_s *slot;
+  uint8_t depth = mm_profile_depth(backtrace);
+  uint32_t index = mm_profile_hash(backtrace, depth);
+  int i;
+
+  for (i = 0; i < MM_PROFILE_PROBES; i++, index++)
+    {
+      slot = &g_mm_profile[index % CONFIG_MM_PROFILE_NSITES];
+
+      if (!slot->used)
+        {
+          if (!alloc)
+            {
+              return NULL;
+            }
+
+          slot->used       = true;
+          slot->site.depth = depth;
+          memcpy(slot->site.backtrace, backtrace,
+                 depth * sizeof(FAR void *));
+          return &slot->site;
+        }
+
+      if (slot->site.depth == depth &&
+          memcmp(slot->site.backtrace, backtrace,
+                 depth * sizeof(FAR void *)) == 0)
+        {
+          return &slot->site;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: mm_profile_sample
+ *
+ * Description:
+ *   Add the totals to the history if a sample is due.  Samples are only
+ *   taken when the heap is used, so an idle period leaves a gap.
+ *
+ * Assumptions:
+ *   g_mm_profile_lock is held.
+ *
+ ****************************************************************************/
+
+static void mm_profile_sample(void)
+{
+#if CONFIG_MM_PROFILE_NHISTORY > 0
+  clock_t now = clock_systime_ticks();
+
+  if ((sclock_t)(now - g_mm_nextsample) < 0)
+    {
+      return;
+    }
+
+  g_mm_nextsample = now + MSEC2TICK(CONFIG_MM_PROFILE_INTERVAL);
+
+  g_mm_totals.time = now;
+  g_mm_history[g_mm_hhead] = g_mm_totals;
+
+  g_mm_hhead = (g_mm_hhead + 1) % CONFIG_MM_PROFILE_NHISTORY;
+  if (g_mm_nhistory < CONFIG_MM_PROFILE_NHISTORY)
+    {
+      g_mm_nhistory++;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profile_alloc
+ ****************************************************************************/
+
+void mm_profile_alloc(FAR void * const *backtrace, size_t size)
+{
+  FAR struct mm_profile_site_s *site;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_mm_profile_lock);
+
+  g_mm_totals.allocs++;
+  g_mm_totals.live += size;
+
+  site = mm_profile_find(backtrace, true);
+  if (site != NULL)
+    {
+      site->allocs++;
+      site->bytes += size;
+      site->live  += size;
+    }
+  else
+    {
+      g_mm_dropped++;
+    }
+
+  mm_profile_sample();
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_free
+ ****************************************************************************/
+
+void mm_profile_free(FAR void * const *backtrace, size_t size)
+{
+  FAR struct mm_profile_site_s *site;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_mm_profile_lock);
+
+  g_mm_totals.frees++;
+  g_mm_totals.live -= size;
+
+  site = mm_profile_find(backtrace, false);
+  if (site != NULL)
+    {
+      site->frees++;
+      site->live -= size;
+    }
+
+  mm_profile_sample();
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_site
+ ****************************************************************************/
+
+int mm_profile_site(int index, FAR struct mm_profile_site_s *site)
+{
+  irqstate_t flags;
+  bool used;
+
+  if (index < 0 || index >= CONFIG_MM_PROFILE_NSITES)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_profile_lock);
+  used  = g_mm_profile[index].used;
+  *site = g_mm_profile[index].site;
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+
+  return used ? OK : -ENOENT;
+}
+
+/****************************************************************************
+ * Name: mm_profile_history
+ ****************************************************************************/
+
+int mm_profile_history(int index, FAR struct mm_profile_sample_s *sample)
+{
+#if CONFIG_MM_PROFILE_NHISTORY > 0
+  irqstate_t flags;
+  int ret = -EINVAL;
+
+  flags = spin_lock_irqsave(&g_mm_profile_lock);
+
+  if (index >= 0 && index < g_mm_nhistory)
+    {
+      index += g_mm_hhead + CONFIG_MM_PROFILE_NHISTORY - g_mm_nhistory;
+      *sample = g_mm_history[index % CONFIG_MM_PROFILE_NHISTORY];
+      ret = OK;
+    }
+
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+  return ret;
+#else
+  return -EINVAL;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_profile_totals
+ ****************************************************************************/
+
+void mm_profile_totals(FAR struct mm_profile_sample_s *totals,
+                       FAR uint32_t *dropped)
+{
+  irqstate_t flags;
+
+  flags    = spin_lock_irqsave(&g_mm_profile_lock);
+  *totals  = g_mm_totals;
+  *dropped = g_mm_dropped;
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+
+  totals->time = clock_systime_ticks();
+}
+
+/****************************************************************************
+ * Name: mm_profile_reset
+ ****************************************************************************/
+
+void mm_profile_reset(void)
+{
+  FAR struct mm_profile_slot_s *slot;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_mm_profile_lock);
+
+  for (slot = g_mm_profile;
+       slot < g_mm_profile + CONFIG_MM_PROFILE_NSITES;
+       slot++)
+    {
+      slot->site.allocs = 0;
+      slot->site.frees  = 0;
+      slot->site.bytes  = 0;
+    }
+
+  g_mm_totals.allocs = 0;
+  g_mm_totals.frees  = 0;
+  g_mm_dropped       = 0;
+
+#if CONFIG_MM_PROFILE_NHISTORY > 0
+  g_mm_nhistory      = 0;
+  g_mm_hhead         = 0;
+  g_mm_nextsample    = clock_systime_ticks();
+#endif
+
+  spin_unlock_irqrestore(&g_mm_profile_lock, flags);
+}
+
+#endif /* MM_PROFILE */
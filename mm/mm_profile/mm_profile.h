@@ -0,0 +1,166 @@
+/****************************************************************************
+ * mm/mm_profile/mm_profile.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __MM_MM_PROFILE_MM_PROFILE_H
+#define __MM_MM_PROFILE_MM_PROFILE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The profiler lives in the kernel; user-space heaps of a protected or
+ * kernel build are not profiled.
+ */
+
+#if defined(CONFIG_MM_PROFILE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_PROFILE
+#endif
+
+#ifndef MM_PROFILE
+#  define mm_profile_alloc(backtrace, size)
+#  define mm_profile_free(backtrace, size)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef MM_PROFILE
+
+/* The allocations made from one call site */
+
+struct mm_profile_site_s
+{
+  uint32_t allocs;                          /* Allocations since reset */
+  uint32_t frees;                           /* Frees since reset */
+  uint64_t bytes;                           /* Bytes allocated since reset */
+  int64_t  live;                            /* Bytes currently allocated */
+  uint8_t  depth;                           /* Valid entries in backtrace */
+  FAR void *backtrace[CONFIG_MM_BACKTRACE]; /* The call site */
+};
+
+/* Totals of all call sites at one point of time */
+
+struct mm_profile_sample_s
+{
+  clock_t  time;                            /* System time in ticks */
+  uint32_t allocs;                          /* Allocations since reset */
+  uint32_t frees;                           /* Frees since reset */
+  int64_t  live;                            /* Bytes currently allocated */
+};
+
+#endif /* MM_PROFILE */
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef MM_PROFILE
+
+/****************************************************************************
+ * Name: mm_profile_alloc, mm_profile_free
+ *
+ * Description:
+ *   Count an allocation or a free of size usable bytes against the call
+ *   site recorded in the backtrace of the block.  A backtrace that was not
+ *   recorded starts with NULL and is counted against an unknown site.
+ *
+ ****************************************************************************/
+
+void mm_profile_alloc(FAR void * const *backtrace, size_t size);
+void mm_profile_free(FAR void * const *backtrace, size_t size);
+
+/****************************************************************************
+ * Name: mm_profile_site
+ *
+ * Description:
+ *   Return the call site in the index'th slot of the site table.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if the slot is free; -EINVAL if index is out of
+ *   range.
+ *
+ ****************************************************************************/
+
+int mm_profile_site(int index, FAR struct mm_profile_site_s *site);
+
+/****************************************************************************
+ * Name: mm_profile_history
+ *
+ * Description:
+ *   Return the index'th sample of the history, oldest first.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if there is no such sample.
+ *
+ ****************************************************************************/
+
+int mm_profile_history(int index, FAR struct mm_profile_sample_s *sample);
+
+/****************************************************************************
+ * Name: mm_profile_totals
+ *
+ * Description:
+ *   Return the current totals, and in dropped the number of allocations
+ *   that found no free slot in the site table.
+ *
+ ****************************************************************************/
+
+void mm_profile_totals(FAR struct mm_profile_sample_s *totals,
+                       FAR uint32_t *dropped);
+
+/****************************************************************************
+ * Name: mm_profile_reset
+ *
+ * Description:
+ *   Clear the counters and the history.  The live bytes are kept, so that
+ *   they stay exact.
+ *
+ ****************************************************************************/
+
+void mm_profile_reset(void);
+
+#endif /* MM_PROFILE */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MM_MM_PROFILE_MM_PROFILE_H */
@@ -0,0 +1,386 @@
+/****************************************************************************
+ * mm/mm_profile/mm_profile_procfs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "mm_profile/mm_profile.h"
+
+#if defined(MM_PROFILE) && !defined(CONFIG_DISABLE_MOUNTPOINT) && \
+    defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPROFILE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.  A frame takes up to
+ * 48 characters when it is printed with its symbol name.
+ */
+
+#define MEMPROFILE_LINELEN (80 + 48 * CONFIG_MM_BACKTRACE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct memprofile_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[MEMPROFILE_LINELEN];  /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     memprofile_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     memprofile_close(FAR struct file *filep);
+static ssize_t memprofile_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t memprofile_write(FAR struct file *filep,
+                 FAR const char *buffer, size_t buflen);
+static int     memprofile_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     memprofile_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_memprofile_operations =
+{
+  memprofile_open,   /* open */
+  memprofile_close,  /* close */
+  memprofile_read,   /* read */
+  memprofile_write,  /* write */
+  memprofile_dup,    /* dup */
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+  memprofile_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memprofile_open
+ ****************************************************************************/
+
+static int memprofile_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct memprofile_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = kmm_zalloc(sizeof(struct memprofile_file_s));
+  if (procfile == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memprofile_close
+ ****************************************************************************/
+
+static int memprofile_close(FAR struct file *filep)
+{
+  FAR struct memprofile_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memprofile_site_line
+ *
+ * Description:
+ *   Format one call site as "site allocs frees bytes live frame...",
+ *   innermost frame first.
+ *
+ ****************************************************************************/
+
+static size_t memprofile_site_line(FAR struct memprofile_file_s *procfile,
+                                   FAR const struct mm_profile_site_s *site)
+{
+  size_t linesize;
+  int i;
+
+  /* Keep one byte for the newline */
+
+  linesize = procfs_snprintf(procfile->line, MEMPROFILE_LINELEN - 1,
+                             "site %" PRIu32 " %" PRIu32 " %" PRIu64
+                             " %" PRId64, site->allocs, site->frees,
+                             site->bytes, site->live);
+
+  for (i = 0; i < site->depth; i++)
+    {
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  MEMPROFILE_LINELEN - 1 - linesize,
+                                  " %pS", site->backtrace[i]);
+    }
+
+  procfile->line[linesize++] = '\n';
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: memprofile_read
+ ****************************************************************************/
+
+static ssize_t memprofile_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct memprofile_file_s *procfile;
+  struct mm_profile_sample_s sample;
+  struct mm_profile_site_s site;
+  uint32_t dropped;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+  int ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* The totals first, times are in milliseconds */
+
+  mm_profile_totals(&sample, &dropped);
+
+  linesize  = procfs_snprintf(procfile->line, MEMPROFILE_LINELEN,
+                              "# time %lu allocs %" PRIu32
+                              " frees %" PRIu32 " live %" PRId64
+                              " dropped %" PRIu32 "\n"
+                              "# history time allocs frees live\n",
+                              (unsigned long)TICK2MSEC(sample.time),
+                              sample.allocs, sample.frees, sample.live,
+                              dropped);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  /* Then the history of the totals, oldest first */
+
+  for (index = 0;
+       buflen > 0 && mm_profile_history(index, &sample) == OK;
+       index++)
+    {
+      linesize   = procfs_snprintf(procfile->line, MEMPROFILE_LINELEN,
+                                   "history %lu %" PRIu32 " %" PRIu32
+                                   " %" PRId64 "\n",
+                                   (unsigned long)TICK2MSEC(sample.time),
+                                   sample.allocs, sample.frees,
+                                   sample.live);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  /* And one line per call site */
+
+  if (buflen > 0)
+    {
+      linesize   = procfs_snprintf(procfile->line, MEMPROFILE_LINELEN,
+                                   "# site allocs frees bytes live "
+                                   "[caller...]\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  for (index = 0; buflen > 0; index++)
+    {
+      ret = mm_profile_site(index, &site);
+      if (ret == -EINVAL)
+        {
+          break;
+        }
+      else if (ret < 0)
+        {
+          continue;
+        }
+
+      linesize   = memprofile_site_line(procfile, &site);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: memprofile_write
+ *
+ * Description:
+ *   "reset" clears the counters and the history.
+ *
+ ****************************************************************************/
+
+static ssize_t memprofile_write(FAR struct file *filep,
+                                FAR const char *buffer, size_t buflen)
+{
+  size_t len = buflen;
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* Ignore a trailing newline, as written by echo */
+
+  while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r'))
+    {
+      len--;
+    }
+
+  if (len != 5 || strncmp(buffer, "reset", 5) != 0)
+    {
+      return -EINVAL;
+    }
+
+  mm_profile_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: memprofile_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int memprofile_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct memprofile_file_s *oldattr;
+  FAR struct memprofile_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct memprofile_file_s));
+  if (newattr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct memprofile_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memprofile_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int memprofile_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+#endif /* MM_PROFILE && !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_MEMPROFILE */
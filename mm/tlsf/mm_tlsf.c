@@ -42,6 +42,7 @@
 
 #include "tlsf/tlsf.h"
 #include "kasan/kasan.h"
+#include "mm_profile/mm_profile.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -157,10 +158,43 @@ static void memdump_backtrace(FAR struct mm_heap_s *heap,
           buf->backtrace[ret] = NULL;
         }
     }
+  else
+    {
+      buf->backtrace[0] = NULL;
+    }
 #  endif
 }
 #endif
 
+#ifdef MM_PROFILE
+/****************************************************************************
+ * Name: memprofile_alloc, memprofile_free
+ *
+ * Description:
+ *   Count a block in the allocation profiler.
+ *
+ ****************************************************************************/
+
+static void memprofile_alloc(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  size_t size = mm_malloc_size(heap, mem);
+  FAR struct memdump_backtrace_s *buf = mem + size;
+
+  mm_profile_alloc(buf->backtrace, size);
+}
+
+static void memprofile_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  size_t size = mm_malloc_size(heap, mem);
+  FAR struct memdump_backtrace_s *buf = mem + size;
+
+  mm_profile_free(buf->backtrace, size);
+}
+#else
+#  define memprofile_alloc(heap, mem)
+#  define memprofile_free(heap, mem)
+#endif
+
 /****************************************************************************
  * Name: add_delaylist
  ****************************************************************************/
@@ -700,6 +734,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 #endif
 
       kasan_poison(mem, mm_malloc_size(heap, mem));
+      memprofile_free(heap, mem);
 
       /* Pass, return to the tlsf pool */
 
@@ -1072,6 +1107,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct memdump_backtrace_s *buf = ret + mm_malloc_size(heap, ret);
 
       memdump_backtrace(heap, buf);
+      memprofile_alloc(heap, ret);
 #endif
       kasan_unpoison(ret, mm_malloc_size(heap, ret));
 
@@ -1130,6 +1166,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       FAR struct memdump_backtrace_s *buf = ret + mm_malloc_size(heap, ret);
 
       memdump_backtrace(heap, buf);
+      memprofile_alloc(heap, ret);
 #endif
       kasan_unpoison(ret, mm_malloc_size(heap, ret));
     }
@@ -1164,6 +1201,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
                      size_t size)
 {
   FAR void *newmem;
+#if defined(MM_PROFILE) && !defined(CONFIG_MM_KASAN)
+  struct memdump_backtrace_s oldbuf;
+  size_t oldsize;
+#endif
 
   /* If oldmem is NULL, then realloc is equivalent to malloc */
 
@@ -1220,6 +1261,13 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
   /* Allocate from the tlsf pool */
 
   DEBUGVERIFY(mm_lock(heap));
+#ifdef MM_PROFILE
+  /* The old call site is lost when the block moves */
+
+  oldsize = mm_malloc_size(heap, oldmem);
+  oldbuf  = *(FAR struct memdump_backtrace_s *)(oldmem + oldsize);
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
   newmem = tlsf_realloc(heap->mm_tlsf, oldmem, size +
                         sizeof(struct memdump_backtrace_s));
@@ -1235,6 +1283,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         newmem + mm_malloc_size(heap, newmem);
 
       memdump_backtrace(heap, buf);
+#ifdef MM_PROFILE
+      mm_profile_free(oldbuf.backtrace, oldsize);
+      memprofile_alloc(heap, newmem);
+#endif
     }
 #endif
 
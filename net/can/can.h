@@ -28,9 +28,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/time.h>
 #include <poll.h>
 
 #include <netpacket/can.h>
+#include <nuttx/queue.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/can.h>
 #include <nuttx/net/net.h>
@@ -56,6 +58,22 @@
 #define can_callback_free(dev,conn,cb) \
   devif_conn_callback_free(dev, cb, &conn->sconn.list, &conn->sconn.list_tail)
 
+/* Largest frame kept in a CAN_RAW_RX_RING entry */
+
+#ifdef CONFIG_NET_CAN_CANFD
+#  define CAN_RXRING_MTU CANFD_MTU
+#else
+#  define CAN_RXRING_MTU CAN_MTU
+#endif
+
+/* Number of frames waiting in the CAN_RAW_RX_RING of a connection */
+
+#ifdef CONFIG_NET_CAN_RXRING
+#  define CAN_RXRING_COUNT(c) ((uint16_t)((c)->rxring_head - (c)->rxring_tail))
+#else
+#  define CAN_RXRING_COUNT(c) 0
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -70,6 +88,29 @@ struct can_poll_s
   FAR struct devif_callback_s *cb; /* Needed to teardown the poll */
 };
 
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+/* An exact-ID receive filter of a connection, linked in the ID hash table */
+
+struct can_hnode_s
+{
+  sq_entry_t node;                     /* Link in the hash bucket */
+  canid_t key;                         /* Hashed CAN ID and EFF flag */
+  FAR struct can_conn_s *conn;         /* Connection owning the filter */
+  FAR const struct can_filter *filter; /* The filter in conn->filters[] */
+};
+#endif
+
+#ifdef CONFIG_NET_CAN_RXRING
+/* One frame held in a CAN_RAW_RX_RING with its time of arrival */
+
+struct can_rxring_entry_s
+{
+  struct timeval ts;                   /* Time the frame was received */
+  uint8_t len;                         /* Length of the frame */
+  uint8_t frame[CAN_RXRING_MTU];       /* The can_frame or canfd_frame */
+};
+#endif
+
 /* This "connection" structure describes the underlying state of the socket */
 
 struct can_conn_s
@@ -116,6 +157,33 @@ struct can_conn_s
 #ifdef CONFIG_NET_TIMESTAMP
   int32_t timestamp; /* Socket timestamp enabled/disabled */
 #endif
+
+  /* Receive dispatch: the connections accepting a frame are linked through
+   * rxnext, and rxseq avoids linking a connection twice for one frame.
+   */
+
+  FAR struct can_conn_s *rxnext;
+  uint32_t rxseq;
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+  dq_entry_t wnode;                  /* Link in the wildcard list */
+  bool wildcard;                     /* Has filters that cannot be hashed */
+  int32_t nhnodes;                   /* Number of hashed filters */
+  struct can_hnode_s hnodes[CONFIG_NET_CAN_RAW_FILTER_MAX];
+#endif
+
+#ifdef CONFIG_NET_CAN_RXRING
+  /* CAN_RAW_RX_RING: frames not taken by a waiting reader are kept here
+   * instead of the read-ahead IOB queue.  head and tail are free running
+   * and rxring_size is a power of two.
+   */
+
+  FAR struct can_rxring_entry_s *rxring;
+  uint16_t rxring_size;
+  uint16_t rxring_head;
+  uint16_t rxring_tail;
+  uint32_t rxring_drops;             /* Frames dropped on a full ring */
+#endif
 };
 
 /****************************************************************************
@@ -228,6 +296,114 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
 uint16_t can_datahandler(FAR struct net_driver_s *dev,
                          FAR struct can_conn_s *conn);
 
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check a CAN ID against the CAN_RAW_FILTER and CAN_RAW_ERR_FILTER
+ *   settings of a connection.
+ *
+ * Returned Value:
+ *   true if the connection accepts frames with this ID.
+ *
+ ****************************************************************************/
+
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id);
+
+/****************************************************************************
+ * Name: can_filter_lookup
+ *
+ * Description:
+ *   Find every connection that accepts a frame received on a device.
+ *
+ * Input Parameters:
+ *   dev - The device the frame was received on
+ *   id  - The CAN ID of the frame
+ *
+ * Returned Value:
+ *   The first accepting connection; the others follow through rxnext.
+ *   NULL if no connection accepts the frame.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct can_conn_s *can_filter_lookup(FAR struct net_driver_s *dev,
+                                         canid_t id);
+
+/****************************************************************************
+ * Name: can_filter_update and can_filter_remove
+ *
+ * Description:
+ *   Re-index the receive filters of a connection after they were changed,
+ *   or drop the connection from the index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+void can_filter_update(FAR struct can_conn_s *conn);
+void can_filter_remove(FAR struct can_conn_s *conn);
+#else
+#  define can_filter_update(conn)
+#  define can_filter_remove(conn)
+#endif
+
+/****************************************************************************
+ * Name: can_rxring_setup
+ *
+ * Description:
+ *   Allocate a CAN_RAW_RX_RING of nentries frames for a connection,
+ *   replacing any previous ring.  nentries is rounded up to a power of
+ *   two; zero frees the ring.
+ *
+ * Returned Value:
+ *   OK on success; a negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RXRING
+int can_rxring_setup(FAR struct can_conn_s *conn, int nentries);
+
+/****************************************************************************
+ * Name: can_rxring_put
+ *
+ * Description:
+ *   Store the frame in dev->d_iob in the ring of the connection, stamped
+ *   with the current time.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void can_rxring_put(FAR struct net_driver_s *dev,
+                    FAR struct can_conn_s *conn);
+
+/****************************************************************************
+ * Name: can_rxring_get
+ *
+ * Description:
+ *   Take the oldest frame from the ring of the connection.
+ *
+ * Input Parameters:
+ *   conn   - The CAN connection
+ *   buf    - Buffer receiving the frame
+ *   buflen - Size of buf
+ *   tv     - Location to return the time of arrival (may be NULL)
+ *
+ * Returned Value:
+ *   The number of bytes copied into buf, 0 if the ring is empty.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t can_rxring_get(FAR struct can_conn_s *conn, FAR void *buf,
+                       size_t buflen, FAR struct timeval *tv);
+#endif
+
 /****************************************************************************
  * Name: can_recvmsg
  *
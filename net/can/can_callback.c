@@ -133,6 +133,19 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
 
       if ((flags & CAN_NEWDATA) != 0)
         {
+#ifdef CONFIG_NET_CAN_RXRING
+          /* Keep the frame in the receive ring of the socket if it has
+           * one.  The IOB is left to the caller.
+           */
+
+          if (conn->rxring != NULL)
+            {
+              can_rxring_put(dev, conn);
+              dev->d_len = 0;
+              return flags & ~CAN_NEWDATA;
+            }
+#endif
+
 #ifdef CONFIG_NET_TIMESTAMP
           /* TIMESTAMP sockopt is activated,
            * create timestamp and copy to iob
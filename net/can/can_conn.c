@@ -158,6 +158,14 @@ FAR struct can_conn_s *can_alloc(void)
     }
 
   nxmutex_unlock(&g_free_lock);
+
+  /* Index the catch-all filter */
+
+  if (conn != NULL)
+    {
+      can_filter_update(conn);
+    }
+
   return conn;
 }
 
@@ -176,6 +184,17 @@ void can_free(FAR struct can_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+  /* Stop can_input() from finding the connection */
+
+  can_filter_remove(conn);
+
+#ifdef CONFIG_NET_CAN_RXRING
+  if (conn->rxring != NULL)
+    {
+      kmm_free(conn->rxring);
+    }
+#endif
+
   nxmutex_lock(&g_free_lock);
 
   /* Remove the connection from the active list */
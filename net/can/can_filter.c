@@ -0,0 +1,345 @@
+/****************************************************************************
+ * net/can/can_filter.c
+ * Receive filter matching and frame dispatch
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
+
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/queue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "can/can.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+#  ifndef CONFIG_NET_CAN_FILTER_HASH_SIZE
+#    define CONFIG_NET_CAN_FILTER_HASH_SIZE 32
+#  endif
+
+/* The ID bits that identify a frame: the EFF flag and the 11 or 29 bit
+ * identifier.
+ */
+
+#  define CAN_KEY_MASK(id) \
+     (CAN_EFF_FLAG | \
+      (((id) & CAN_EFF_FLAG) != 0 ? CAN_EFF_MASK : CAN_SFF_MASK))
+#  define CAN_KEY(id)    ((id) & CAN_KEY_MASK(id))
+#  define CAN_BUCKET(k) \
+     (((k) ^ ((k) >> 11) ^ ((k) >> 22)) % CONFIG_NET_CAN_FILTER_HASH_SIZE)
+
+#  define WNODE_CONN(e)  container_of(e, struct can_conn_s, wnode)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Sequence number of the frame being dispatched */
+
+static uint32_t g_can_rxseq;
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+/* Exact-ID filters of all connections, hashed by CAN ID */
+
+static sq_queue_t g_can_hash[CONFIG_NET_CAN_FILTER_HASH_SIZE];
+
+/* Connections with mask or inverted filters that are checked one by one */
+
+static dq_queue_t g_can_wildcard;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_filter_accept
+ *
+ * Description:
+ *   Add a connection to the list of receivers of the current frame unless
+ *   it is already in it.
+ *
+ ****************************************************************************/
+
+static void can_filter_accept(FAR struct can_conn_s *conn,
+                              FAR struct can_conn_s ***tail)
+{
+  if (conn->rxseq != g_can_rxseq)
+    {
+      conn->rxseq  = g_can_rxseq;
+      conn->rxnext = NULL;
+      **tail       = conn;
+      *tail        = &conn->rxnext;
+    }
+}
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+/****************************************************************************
+ * Name: can_filter_exact
+ *
+ * Description:
+ *   Check if a filter only accepts one CAN ID, so that it can be found
+ *   through the ID hash table.
+ *
+ ****************************************************************************/
+
+static bool can_filter_exact(FAR const struct can_filter *filter)
+{
+  canid_t need = CAN_KEY_MASK(filter->can_id);
+
+  return (filter->can_id & CAN_INV_FILTER) == 0 &&
+         (filter->can_mask & need) == need;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check a CAN ID against the CAN_RAW_FILTER and CAN_RAW_ERR_FILTER
+ *   settings of a connection.
+ *
+ * Returned Value:
+ *   true if the connection accepts frames with this ID.
+ *
+ ****************************************************************************/
+
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id)
+{
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+  int32_t i;
+
+#ifdef CONFIG_NET_CAN_ERRORS
+  /* error message frame */
+
+  if ((id & CAN_ERR_FLAG) != 0)
+    {
+      return (id & conn->err_mask) != 0;
+    }
+#endif
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      if (conn->filters[i].can_id & CAN_INV_FILTER)
+        {
+          if ((id & conn->filters[i].can_mask) !=
+                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
+                 conn->filters[i].can_mask))
+            {
+              return true;
+            }
+        }
+      else
+        {
+          if ((id & conn->filters[i].can_mask) ==
+                (conn->filters[i].can_id & conn->filters[i].can_mask))
+            {
+              return true;
+            }
+        }
+    }
+
+  return false;
+#else
+  return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: can_filter_lookup
+ *
+ * Description:
+ *   Find every connection that accepts a frame received on a device.
+ *
+ * Input Parameters:
+ *   dev - The device the frame was received on
+ *   id  - The CAN ID of the frame
+ *
+ * Returned Value:
+ *   The first accepting connection; the others follow through rxnext.
+ *   NULL if no connection accepts the frame.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct can_conn_s *can_filter_lookup(FAR struct net_driver_s *dev,
+                                         canid_t id)
+{
+  FAR struct can_conn_s *head = NULL;
+  FAR struct can_conn_s **tail = &head;
+  FAR struct can_conn_s *conn;
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+  FAR const struct can_filter *filter;
+  FAR struct can_hnode_s *hnode;
+  FAR dq_entry_t *entry;
+  canid_t key;
+#endif
+
+  g_can_rxseq++;
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+  /* Error frames are matched against the error mask of every connection */
+
+  if ((id & CAN_ERR_FLAG) == 0)
+    {
+      /* Connections with an exact filter for this ID */
+
+      key = CAN_KEY(id);
+      for (hnode = (FAR struct can_hnode_s *)
+                   sq_peek(&g_can_hash[CAN_BUCKET(key)]);
+           hnode != NULL;
+           hnode = (FAR struct can_hnode_s *)sq_next(&hnode->node))
+        {
+          conn   = hnode->conn;
+          filter = hnode->filter;
+
+          if (hnode->key == key &&
+              (conn->dev == NULL || conn->dev == dev) &&
+              (id & filter->can_mask) ==
+              (filter->can_id & filter->can_mask))
+            {
+              can_filter_accept(conn, &tail);
+            }
+        }
+
+      /* Connections whose filters have to be checked one by one */
+
+      for (entry = dq_peek(&g_can_wildcard); entry != NULL;
+           entry = dq_next(entry))
+        {
+          conn = WNODE_CONN(entry);
+          if ((conn->dev == NULL || conn->dev == dev) &&
+              can_filter_match(conn, id))
+            {
+              can_filter_accept(conn, &tail);
+            }
+        }
+
+      return head;
+    }
+#endif
+
+  for (conn = can_nextconn(NULL); conn != NULL; conn = can_nextconn(conn))
+    {
+      if ((conn->dev == NULL || conn->dev == dev) &&
+          can_filter_match(conn, id))
+        {
+          can_filter_accept(conn, &tail);
+        }
+    }
+
+  return head;
+}
+
+#ifdef CONFIG_NET_CAN_FILTER_HASH
+/****************************************************************************
+ * Name: can_filter_remove
+ *
+ * Description:
+ *   Drop the connection from the filter index.
+ *
+ ****************************************************************************/
+
+void can_filter_remove(FAR struct can_conn_s *conn)
+{
+  FAR struct can_hnode_s *hnode;
+  int i;
+
+  net_lock();
+
+  for (i = 0; i < conn->nhnodes; i++)
+    {
+      hnode = &conn->hnodes[i];
+      sq_rem(&hnode->node, &g_can_hash[CAN_BUCKET(hnode->key)]);
+    }
+
+  conn->nhnodes = 0;
+
+  if (conn->wildcard)
+    {
+      dq_rem(&conn->wnode, &g_can_wildcard);
+      conn->wildcard = false;
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: can_filter_update
+ *
+ * Description:
+ *   Re-index the receive filters of a connection after they were changed.
+ *   Exact-ID filters go to the hash table; any other filter puts the
+ *   connection in the wildcard list.
+ *
+ ****************************************************************************/
+
+void can_filter_update(FAR struct can_conn_s *conn)
+{
+  FAR const struct can_filter *filter;
+  FAR struct can_hnode_s *hnode;
+  int32_t i;
+
+  net_lock();
+
+  can_filter_remove(conn);
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      filter = &conn->filters[i];
+
+      if (can_filter_exact(filter))
+        {
+          hnode         = &conn->hnodes[conn->nhnodes++];
+          hnode->key    = CAN_KEY(filter->can_id);
+          hnode->conn   = conn;
+          hnode->filter = filter;
+
+          sq_addlast(&hnode->node, &g_can_hash[CAN_BUCKET(hnode->key)]);
+        }
+      else if (!conn->wildcard)
+        {
+          conn->wildcard = true;
+          dq_addlast(&conn->wnode, &g_can_wildcard);
+        }
+    }
+
+  net_unlock();
+}
+#endif /* CONFIG_NET_CAN_FILTER_HASH */
+
+#endif /* CONFIG_NET && CONFIG_NET_CAN */
@@ -234,6 +234,21 @@ int can_getsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_CAN_RXRING
+      case CAN_RAW_RX_RING:
+        if (*value_len < sizeof(int32_t))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            FAR int32_t *rxring = (FAR int32_t *)value;
+            *rxring             = conn->rxring_size;
+            *value_len          = sizeof(int32_t);
+          }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized RAW CAN socket option: %d\n", option);
         ret = -ENOPROTOOPT;
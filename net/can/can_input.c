@@ -26,9 +26,12 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
+#include <stdbool.h>
 #include <errno.h>
+#include <string.h>
 #include <debug.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/can.h>
 
@@ -128,9 +131,40 @@ const uint8_t len_to_can_dlc[65] =
 };
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: can_iob_clone
+ *
+ * Description:
+ *   Copy a received frame for one more receiving connection, keeping the
+ *   L2 guard in front of it like netdev_iob_prepare() does.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *can_iob_clone(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *clone;
+
+  clone = iob_tryalloc(false);
+  if (clone == NULL)
+    {
+      return NULL;
+    }
+
+  iob_reserve(clone, CONFIG_NET_LL_GUARDSIZE);
+
+  if (iob_clone_partial(iob, iob->io_pktlen, 0, clone, 0,
+                        false, false) < 0)
+    {
+      iob_free_chain(clone);
+      return NULL;
+    }
+
+  return clone;
+}
+
 /****************************************************************************
  * Name: can_in
  *
@@ -142,9 +176,9 @@ const uint8_t len_to_can_dlc[65] =
  *
  * Returned Value:
  *   OK     The packet has been processed  and can be deleted
- *  -EAGAIN There is a matching connection, but could not dispatch the packet
- *          yet.  Useful when a packet arrives before a recv call is in
- *          place.
+ *  -EAGAIN There are matching connections, but none of them could take the
+ *          packet yet.  Useful when a packet arrives before a recv call is
+ *          in place.
  *
  * Assumptions:
  *   This function can be called from an interrupt.
@@ -153,50 +187,102 @@ const uint8_t len_to_can_dlc[65] =
 
 static int can_in(struct net_driver_s *dev)
 {
-  FAR struct can_conn_s *conn = NULL;
-  int ret = OK;
+  FAR struct can_conn_s *conn;
+  FAR struct can_conn_s *next;
+  FAR struct iob_s *iob = dev->d_iob;
+  bool delivered = false;
+  bool refused = false;
   uint16_t buflen = dev->d_len;
+  canid_t can_id;
+
+  /* The receive filters are applied once here, so that only the
+   * connections accepting the frame see it.
+   */
+
+  memcpy(&can_id, dev->d_buf, sizeof(canid_t));
 
-  do
+  for (conn = can_filter_lookup(dev, can_id); conn != NULL; conn = next)
     {
-      conn = can_nextconn(conn);
+      uint16_t flags;
 
-      if (conn && (conn->dev == NULL || dev == conn->dev))
+      /* Every receiver but the last one gets its own copy of the frame,
+       * the last one gets the device buffer.
+       */
+
+      next = conn->rxnext;
+      if (next != NULL)
         {
-          uint16_t flags;
+          dev->d_iob = can_iob_clone(iob);
+          if (dev->d_iob == NULL)
+            {
+              nwarn("WARNING: No IOB to copy the frame\n");
+              dev->d_iob = iob;
+              continue;
+            }
+        }
+      else
+        {
+          dev->d_iob = iob;
+        }
+
+      /* Setup for the application callback */
+
+      dev->d_buf     = NETLLBUF;
+      dev->d_appdata = dev->d_buf;
+      dev->d_sndlen  = 0;
+      dev->d_len     = buflen;
 
-          /* Setup for the application callback */
+      /* Perform the application callback */
 
-          dev->d_appdata = dev->d_buf;
-          dev->d_sndlen  = 0;
-          dev->d_len     = buflen;
+      flags = can_callback(dev, conn, CAN_NEWDATA);
 
-          /* Perform the application callback */
+      /* If the operation was successful, the CAN_NEWDATA flag is removed
+       * and thus the packet can be deleted (OK will be returned).
+       */
 
-          flags = can_callback(dev, conn, CAN_NEWDATA);
+      if ((flags & CAN_NEWDATA) != 0)
+        {
+          /* No.. the packet was not processed now by this connection */
+
+           nwarn("WARNING: Packet not processed\n");
+           refused = true;
+        }
+      else
+        {
+          delivered = true;
+        }
 
-          /* If the operation was successful, the CAN_NEWDATA flag is removed
-           * and thus the packet can be deleted (OK will be returned).
-           */
+      /* Release what the connection did not take of its copy */
 
-          if ((flags & CAN_NEWDATA) != 0)
+      if (next != NULL)
+        {
+          if (dev->d_iob != NULL)
             {
-              /* No.. the packet was not processed now.  Return -EAGAIN so
-               * that the driver may retry again later.  We still need to
-               * set d_len to zero so that the driver is aware that there
-               * is nothing to be sent.
-               */
-
-               nwarn("WARNING: Packet not processed\n");
-               ret = -EAGAIN;
+              iob_free_chain(dev->d_iob);
             }
+
+          dev->d_iob = iob;
+          dev->d_buf = NETLLBUF;
         }
     }
-  while (conn);
 
-  return ret;
+  /* Return -EAGAIN so that the driver may retry again later only if no
+   * connection took the frame.  Once one did, a retry would give it the
+   * same frame twice, so the connections that did not take it lose it.
+   */
+
+  if (refused && !delivered)
+    {
+      return -EAGAIN;
+    }
+
+  return OK;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: can_input
  *
@@ -208,9 +294,9 @@ static int can_in(struct net_driver_s *dev)
  *
  * Returned Value:
  *   OK     The packet has been processed  and can be deleted
- *  -EAGAIN There is a matching connection, but could not dispatch the packet
- *          yet.  Useful when a packet arrives before a recv call is in
- *          place.
+ *  -EAGAIN There are matching connections, but none of them could take the
+ *          packet yet.  Useful when a packet arrives before a recv call is
+ *          in place.
  *
  * Assumptions:
  *   This function can be called from an interrupt.
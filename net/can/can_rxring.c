@@ -0,0 +1,212 @@
+/****************************************************************************
+ * net/can/can_rxring.c
+ * CAN_RAW_RX_RING receive ring
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_CAN_RXRING)
+
+#include <sys/param.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "can/can.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Largest ring, keeping the free running 16-bit indexes unambiguous */
+
+#define CAN_RXRING_MAX 32768
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_rxring_setup
+ *
+ * Description:
+ *   Allocate a CAN_RAW_RX_RING of nentries frames for a connection,
+ *   replacing any previous ring.  nentries is rounded up to a power of
+ *   two; zero frees the ring.
+ *
+ * Returned Value:
+ *   OK on success; a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int can_rxring_setup(FAR struct can_conn_s *conn, int nentries)
+{
+  FAR struct can_rxring_entry_s *ring = NULL;
+  FAR struct can_rxring_entry_s *old;
+  int size = 0;
+
+  if (nentries < 0 || nentries > CAN_RXRING_MAX)
+    {
+      return -EINVAL;
+    }
+
+  if (nentries > 0)
+    {
+      for (size = 1; size < nentries; size <<= 1)
+        {
+        }
+
+      ring = kmm_zalloc(size * sizeof(struct can_rxring_entry_s));
+      if (ring == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  /* Frames still in the old ring are dropped */
+
+  net_lock();
+
+  old                = conn->rxring;
+  conn->rxring       = ring;
+  conn->rxring_size  = size;
+  conn->rxring_head  = 0;
+  conn->rxring_tail  = 0;
+  conn->rxring_drops = 0;
+
+  net_unlock();
+
+  if (old != NULL)
+    {
+      kmm_free(old);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: can_rxring_put
+ *
+ * Description:
+ *   Store the frame in dev->d_iob in the ring of the connection, stamped
+ *   with the current time.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void can_rxring_put(FAR struct net_driver_s *dev,
+                    FAR struct can_conn_s *conn)
+{
+  FAR struct can_rxring_entry_s *entry;
+  struct timespec ts;
+  unsigned int offset;
+
+  /* Do not keep CAN FD frames for a legacy socket */
+
+  if (dev->d_len > CAN_RXRING_MTU
+#if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
+      || (!conn->fd_frames && dev->d_len > CAN_MTU)
+#endif
+     )
+    {
+      return;
+    }
+
+  if (CAN_RXRING_COUNT(conn) >= conn->rxring_size)
+    {
+      conn->rxring_drops++;
+      return;
+    }
+
+  entry = &conn->rxring[conn->rxring_head & (conn->rxring_size - 1)];
+
+  clock_systime_timespec(&ts);
+  entry->ts.tv_sec  = ts.tv_sec;
+  entry->ts.tv_usec = ts.tv_nsec / NSEC_PER_USEC;
+
+  offset     = (dev->d_appdata - dev->d_iob->io_data) -
+               dev->d_iob->io_offset;
+  entry->len = iob_copyout(entry->frame, dev->d_iob, dev->d_len, offset);
+
+  conn->rxring_head++;
+
+#ifdef CONFIG_NET_CAN_NOTIFIER
+  /* Provide notification(s) that additional CAN data is available. */
+
+  can_readahead_signal(conn);
+#endif
+}
+
+/****************************************************************************
+ * Name: can_rxring_get
+ *
+ * Description:
+ *   Take the oldest frame from the ring of the connection.
+ *
+ * Input Parameters:
+ *   conn   - The CAN connection
+ *   buf    - Buffer receiving the frame
+ *   buflen - Size of buf
+ *   tv     - Location to return the time of arrival (may be NULL)
+ *
+ * Returned Value:
+ *   The number of bytes copied into buf, 0 if the ring is empty.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t can_rxring_get(FAR struct can_conn_s *conn, FAR void *buf,
+                       size_t buflen, FAR struct timeval *tv)
+{
+  FAR struct can_rxring_entry_s *entry;
+  size_t len;
+
+  if (CAN_RXRING_COUNT(conn) == 0)
+    {
+      return 0;
+    }
+
+  entry = &conn->rxring[conn->rxring_tail & (conn->rxring_size - 1)];
+
+  len = MIN(buflen, entry->len);
+  memcpy(buf, entry->frame, len);
+
+  if (tv != NULL)
+    {
+      *tv = entry->ts;
+    }
+
+  conn->rxring_tail++;
+  return len;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_CAN_RXRING */
@@ -123,7 +123,10 @@ int can_setsockopt(FAR struct socket *psock, int level, int option,
       case CAN_RAW_FILTER:
         if (value_len == 0)
           {
+            net_lock();
             conn->filter_count = 0;
+            can_filter_update(conn);
+            net_unlock();
             ret = OK;
           }
         else if (value_len % sizeof(struct can_filter) != 0)
@@ -141,12 +144,21 @@ int can_setsockopt(FAR struct socket *psock, int level, int option,
 
             count = value_len / sizeof(struct can_filter);
 
+            /* can_input() reads the filters, so update them and their
+             * index with the network locked.
+             */
+
+            net_lock();
+
             for (i = 0; i < count; i++)
               {
                 conn->filters[i] = ((struct can_filter *)value)[i];
               }
 
             conn->filter_count = count;
+            can_filter_update(conn);
+
+            net_unlock();
 
             ret = OK;
           }
@@ -210,6 +222,17 @@ int can_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_CAN_RXRING
+      case CAN_RAW_RX_RING:
+        if (value_len != sizeof(int32_t))
+          {
+            return -EINVAL;
+          }
+
+        ret = can_rxring_setup(conn, *(FAR int32_t *)value);
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized CAN option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -416,7 +416,7 @@ static int can_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
 
       /* Check for read data availability now */
 
-      if (!IOB_QEMPTY(&conn->readahead))
+      if (!IOB_QEMPTY(&conn->readahead) || CAN_RXRING_COUNT(conn) > 0)
         {
           /* Normal data may be read without blocking. */
 
@@ -621,6 +621,98 @@ int netdev_input(FAR struct net_driver_s *dev,
 
 uint16_t devif_get_mtu(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: devif_pending_add
+ *
+ * Description:
+ *   Mark that a connection has output pending on a device by linking it
+ *   into the pending queue of that device.  devif_poll() will visit the
+ *   connection until a poll finds it idle.  Nothing happens if the
+ *   connection is already in the queue.
+ *
+ * Input Parameters:
+ *   pq   - The pending queue of the device (e.g. &dev->d_tcppend)
+ *   conn - The connection with output pending
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void devif_pending_add(FAR struct devif_pendq_s *pq,
+                       FAR struct socket_conn_s *conn);
+#else
+#  define devif_pending_add(pq, conn)
+#endif
+
+/****************************************************************************
+ * Name: devif_pending_remove
+ *
+ * Description:
+ *   Unlink a connection from the pending queue it is in, if any.  This must
+ *   be called before the connection is freed.
+ *
+ * Input Parameters:
+ *   conn - The connection to remove
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void devif_pending_remove(FAR struct socket_conn_s *conn);
+#else
+#  define devif_pending_remove(conn)
+#endif
+
+/****************************************************************************
+ * Name: devif_pending_first and devif_pending_next
+ *
+ * Description:
+ *   Walk a pending queue while polling.  The connection returned becomes
+ *   the current one (pq->cur).  If the current connection leaves the queue
+ *   while it is being polled (for example because it was freed),
+ *   pq->cur is reset to NULL and the walk continues with its successor.
+ *
+ * Input Parameters:
+ *   pq - The pending queue of the device
+ *
+ * Returned Value:
+ *   The connection to poll or NULL when the end of the queue is reached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+FAR struct socket_conn_s *devif_pending_first(FAR struct devif_pendq_s *pq);
+FAR struct socket_conn_s *devif_pending_next(FAR struct devif_pendq_s *pq);
+#endif
+
+/****************************************************************************
+ * Name: devif_pending_flush
+ *
+ * Description:
+ *   Unlink all connections from a pending queue.  Used when the device
+ *   goes away.
+ *
+ * Input Parameters:
+ *   pq - The pending queue of the device
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void devif_pending_flush(FAR struct devif_pendq_s *pq);
+#else
+#  define devif_pending_flush(pq)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
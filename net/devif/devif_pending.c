@@ -0,0 +1,189 @@
+/****************************************************************************
+ * net/devif/devif_pending.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "devif/devif.h"
+
+#ifdef CONFIG_NET_POLL_PENDING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PENDING_CONN(e) container_of(e, struct socket_conn_s, s_pendnode)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_pending_succ
+ *
+ * Description:
+ *   Return the connection following conn in its pending queue.
+ *
+ ****************************************************************************/
+
+static FAR struct socket_conn_s *
+devif_pending_succ(FAR struct socket_conn_s *conn)
+{
+  FAR dq_entry_t *next = dq_next(&conn->s_pendnode);
+
+  return next != NULL ? PENDING_CONN(next) : NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_pending_add
+ *
+ * Description:
+ *   Mark that a connection has output pending on a device by linking it
+ *   into the pending queue of that device.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void devif_pending_add(FAR struct devif_pendq_s *pq,
+                       FAR struct socket_conn_s *conn)
+{
+  DEBUGASSERT(pq != NULL && conn != NULL);
+
+  if (conn->s_pendq == pq)
+    {
+      return;
+    }
+
+  /* A connection may move to another device (e.g. after a route change) */
+
+  if (conn->s_pendq != NULL)
+    {
+      devif_pending_remove(conn);
+    }
+
+  dq_addlast(&conn->s_pendnode, &pq->queue);
+  conn->s_pendq = pq;
+}
+
+/****************************************************************************
+ * Name: devif_pending_remove
+ *
+ * Description:
+ *   Unlink a connection from the pending queue it is in, if any.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void devif_pending_remove(FAR struct socket_conn_s *conn)
+{
+  FAR struct devif_pendq_s *pq = conn->s_pendq;
+
+  if (pq == NULL)
+    {
+      return;
+    }
+
+  /* Keep the cursor of a poll in progress valid */
+
+  if (pq->next == conn)
+    {
+      pq->next = devif_pending_succ(conn);
+    }
+
+  if (pq->cur == conn)
+    {
+      pq->cur = NULL;
+    }
+
+  dq_rem(&conn->s_pendnode, &pq->queue);
+  conn->s_pendq = NULL;
+}
+
+/****************************************************************************
+ * Name: devif_pending_first and devif_pending_next
+ *
+ * Description:
+ *   Walk a pending queue while polling.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct socket_conn_s *devif_pending_first(FAR struct devif_pendq_s *pq)
+{
+  FAR dq_entry_t *head = dq_peek(&pq->queue);
+
+  pq->next = head != NULL ? PENDING_CONN(head) : NULL;
+  return devif_pending_next(pq);
+}
+
+FAR struct socket_conn_s *devif_pending_next(FAR struct devif_pendq_s *pq)
+{
+  FAR struct socket_conn_s *conn = pq->next;
+
+  pq->cur  = conn;
+  pq->next = conn != NULL ? devif_pending_succ(conn) : NULL;
+  return conn;
+}
+
+/****************************************************************************
+ * Name: devif_pending_flush
+ *
+ * Description:
+ *   Unlink all connections from a pending queue.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void devif_pending_flush(FAR struct devif_pendq_s *pq)
+{
+  FAR dq_entry_t *entry;
+
+  while ((entry = dq_remfirst(&pq->queue)) != NULL)
+    {
+      PENDING_CONN(entry)->s_pendq = NULL;
+    }
+
+  pq->next = NULL;
+  pq->cur  = NULL;
+}
+
+#endif /* CONFIG_NET_POLL_PENDING */
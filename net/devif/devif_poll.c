@@ -556,14 +556,27 @@ static inline int devif_poll_mld(FAR struct net_driver_s *dev,
 static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
                                       devif_poll_callback_t callback)
 {
+#ifdef CONFIG_NET_POLL_PENDING
+  FAR struct devif_pendq_s *pq = &dev->d_udppend;
+#endif
   FAR struct udp_conn_s *conn = NULL;
   int bstop = 0;
 
+#ifdef CONFIG_NET_POLL_PENDING
+  /* Traverse only the UDP connections that have output pending on this
+   * device.
+   */
+
+  conn = (FAR struct udp_conn_s *)devif_pending_first(pq);
+  for (; !bstop && conn != NULL;
+       conn = (FAR struct udp_conn_s *)devif_pending_next(pq))
+#else
   /* Traverse all of the allocated UDP connections and perform the poll
    * action.
    */
 
   while (!bstop && (conn = udp_nextconn(conn)))
+#endif
     {
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
       /* Skip UDP connections that are bound to other polling devices */
@@ -575,6 +588,17 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 
           udp_poll(dev, conn);
 
+#ifdef CONFIG_NET_POLL_PENDING
+          /* Drop the connection from the queue once it has nothing more
+           * to send.
+           */
+
+          if (pq->cur != NULL && dev->d_len == 0 && !udp_txpending(conn))
+            {
+              devif_pending_remove(&conn->sconn);
+            }
+#endif
+
           /* Perform any necessary conversions on outgoing packets */
 
           devif_packet_conversion(dev, DEVIF_UDP);
@@ -585,6 +609,10 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
         }
     }
 
+#ifdef CONFIG_NET_POLL_PENDING
+  pq->cur = NULL;
+#endif
+
   return bstop;
 }
 #endif /* NET_UDP_HAVE_STACK */
@@ -605,12 +633,25 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
                                              devif_poll_callback_t callback)
 {
+#ifdef CONFIG_NET_POLL_PENDING
+  FAR struct devif_pendq_s *pq = &dev->d_tcppend;
+#endif
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
 
+#ifdef CONFIG_NET_POLL_PENDING
+  /* Traverse only the TCP connections that have output pending on this
+   * device.
+   */
+
+  conn = (FAR struct tcp_conn_s *)devif_pending_first(pq);
+  for (; !bstop && conn != NULL;
+       conn = (FAR struct tcp_conn_s *)devif_pending_next(pq))
+#else
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
+#endif
     {
       /* Skip TCP connections that are bound to other polling devices */
 
@@ -620,6 +661,17 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 
           tcp_poll(dev, conn);
 
+#ifdef CONFIG_NET_POLL_PENDING
+          /* Drop the connection from the queue once it has nothing more
+           * to send.  pq->cur is NULL if the poll freed the connection.
+           */
+
+          if (pq->cur != NULL && dev->d_len == 0 && !tcp_txpending(conn))
+            {
+              devif_pending_remove(&conn->sconn);
+            }
+#endif
+
           /* Perform any necessary conversions on outgoing packets */
 
           devif_packet_conversion(dev, DEVIF_TCP);
@@ -630,6 +682,10 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
         }
     }
 
+#ifdef CONFIG_NET_POLL_PENDING
+  pq->cur = NULL;
+#endif
+
   return bstop;
 }
 #else
@@ -747,6 +747,21 @@ static int inet_get_socketlevel_option(FAR struct socket *psock, int option,
         }
 #endif
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Reports the receive busy poll time */
+        {
+          FAR struct socket_conn_s *conn = psock->s_conn;
+
+          if (*value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          *(FAR int *)value = (int)conn->s_busypoll;
+        }
+        break;
+#endif
+
       default:
         return -ENOPROTOOPT;
     }
@@ -794,6 +809,11 @@ static int inet_getsockopt(FAR struct socket *psock, int level, int option,
         return tcp_getsockopt(psock, option, value, value_len);
 #endif
 
+#ifdef CONFIG_NET_UDPPROTO_OPTIONS
+      case IPPROTO_UDP:
+        return udp_getsockopt(psock, option, value, value_len);
+#endif
+
 #ifdef CONFIG_NET_IPv4
       case IPPROTO_IP:/* IPv4 protocol socket options (see include/netinet/in.h) */
         return ipv4_getsockopt(psock, option, value, value_len);
@@ -907,6 +927,49 @@ static int inet_set_socketlevel_option(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Sets the receive busy poll time */
+        {
+          FAR struct socket_conn_s *conn = psock->s_conn;
+          int usec;
+
+          /* Verify that option is the size of an 'int'. */
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          usec = *(FAR int *)value;
+          if (usec < 0)
+            {
+              return -EINVAL;
+            }
+
+          /* Silently truncate the time to the limit of the system */
+
+          if (usec > CONFIG_NET_BUSY_POLL_MAX)
+            {
+              usec = CONFIG_NET_BUSY_POLL_MAX;
+            }
+
+          net_lock();
+
+          conn->s_busypoll = usec;
+          if (usec > 0)
+            {
+              _SO_SETOPT(conn->s_options, option);
+            }
+          else
+            {
+              _SO_CLROPT(conn->s_options, option);
+            }
+
+          net_unlock();
+        }
+        break;
+#endif
+
 #if CONFIG_NET_RECV_BUFSIZE > 0
       case SO_RCVBUF:     /* Sets receive buffer size */
         {
@@ -940,9 +1003,14 @@ static int inet_set_socketlevel_option(FAR struct socket *psock, int option,
             {
               FAR struct tcp_conn_s *tcp = psock->s_conn;
 
-              /* Save the receive buffer size */
+              /* Save the receive buffer size.  A size chosen by the
+               * application is not auto-tuned any more.
+               */
 
               tcp->rcv_bufs = buffersize;
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+              tcp->at_flags &= ~TCP_AUTOTUNE_RCVBUF;
+#endif
             }
           else
 #endif
@@ -1001,9 +1069,14 @@ static int inet_set_socketlevel_option(FAR struct socket *psock, int option,
             {
               FAR struct tcp_conn_s *tcp = psock->s_conn;
 
-              /* Save the send buffer size */
+              /* Save the send buffer size.  A size chosen by the
+               * application is not auto-tuned any more.
+               */
 
               tcp->snd_bufs = buffersize;
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+              tcp->at_flags &= ~TCP_AUTOTUNE_SNDBUF;
+#endif
             }
           else
 #endif
@@ -1150,7 +1223,7 @@ static int inet_listen(FAR struct socket *psock, int backlog)
 
           conn->lport = tcp_selectport(PF_INET,
                                 (FAR const union ip_addr_u *)
-                                &conn->u.ipv4.laddr, 0);
+                                &conn->u.ipv4.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1165,7 +1238,7 @@ static int inet_listen(FAR struct socket *psock, int backlog)
 
           conn->lport = tcp_selectport(PF_INET6,
                                 (FAR const union ip_addr_u *)
-                                conn->u.ipv6.laddr, 0);
+                                conn->u.ipv6.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv6 */
     }
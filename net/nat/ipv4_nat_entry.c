@@ -162,14 +162,14 @@ static uint16_t ipv4_nat_select_port(FAR struct net_driver_s *dev,
 
           int ret = tcp_selectport(PF_INET,
                         (FAR const union ip_addr_u *)&dev->d_ipaddr,
-                        local_port);
+                        local_port, 0);
 
           /* If failed, try select another unused port. */
 
           if (ret < 0)
             {
               ret = tcp_selectport(PF_INET,
-                        (FAR const union ip_addr_u *)&dev->d_ipaddr, 0);
+                        (FAR const union ip_addr_u *)&dev->d_ipaddr, 0, 0);
             }
 
           return ret > 0 ? ret : 0;
@@ -45,6 +45,7 @@
 #include "netlink/netlink.h"
 #include "route/route.h"
 #include "usrsock/usrsock.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Public Functions
@@ -75,6 +76,12 @@
 
 void net_initialize(void)
 {
+#ifdef CONFIG_SCHED_LOCKSTAT
+  /* Gather the contention statistics of the network lock */
+
+  net_lockstat_initialize();
+#endif
+
   /* Initialize the device interface layer */
 
   devif_initialize();
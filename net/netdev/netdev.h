@@ -29,14 +29,38 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <semaphore.h>
 
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/rcu.h>
 
 #ifdef CONFIG_NETDOWN_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The lookups by name or index walk the list of devices in RCU read-side
+ * sections, if RCU is enabled, so they do not serialize on the network
+ * lock.  The list is still changed with the network locked, and the link
+ * of a removed device is cleared only after the walks that may be on it
+ * are done.  The lookups by address check the state and the addresses of
+ * the devices, which the network lock protects, so they still take it.
+ */
+
+#ifdef CONFIG_SCHED_RCU
+#  define netdev_list_lock()     rcu_read_lock()
+#  define netdev_list_unlock()   rcu_read_unlock()
+#  define netdev_list_sync()     synchronize_rcu()
+#else
+#  define netdev_list_lock()     net_lock()
+#  define netdev_list_unlock()   net_unlock()
+#  define netdev_list_sync()
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -51,7 +75,8 @@ extern "C"
 #endif
 
 /* List of registered Ethernet device drivers.  You must have the network
- * locked in order to access this list.
+ * locked in order to change this list, or to access it without
+ * netdev_list_lock().
  *
  * NOTE that this duplicates a declaration in net/tcp/tcp.h
  */
@@ -359,6 +384,34 @@ void netdev_ipv6_txnotify(FAR const net_ipv6addr_t lipaddr,
 
 void netdev_txnotify_dev(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the receive path of the network device(s) in the context of the
+ *   caller until the semaphore posted by the receive callback becomes
+ *   available, until the busy poll time has elapsed or until a signal is
+ *   pending for the caller.
+ *
+ * Input Parameters:
+ *   dev  - The device to poll or NULL to poll all devices
+ *   sem  - The semaphore that is posted when the receive completes
+ *   usec - The maximum time to poll in microseconds
+ *
+ * Returned Value:
+ *   OK if the semaphore was taken; -ETIMEDOUT if the time elapsed first;
+ *   -EINTR if a signal is pending.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+int netdev_busypoll(FAR struct net_driver_s *dev, FAR sem_t *sem,
+                    uint32_t usec);
+#endif
+
 /****************************************************************************
  * Name: netdev_count
  *
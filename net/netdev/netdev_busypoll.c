@@ -0,0 +1,158 @@
+/****************************************************************************
+ * net/netdev/netdev_busypoll.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <sched.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_BUSY_POLL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll_callback
+ *
+ * Description:
+ *   Run the receive path of one device, if the driver supports it.
+ *
+ ****************************************************************************/
+
+static int netdev_busypoll_callback(FAR struct net_driver_s *dev,
+                                    FAR void *arg)
+{
+  FAR int *npackets = arg;
+
+  if (dev->d_busypoll != NULL && IFF_IS_UP(dev->d_flags))
+    {
+      *npackets += dev->d_busypoll(dev);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the receive path of the network device(s) in the context of the
+ *   caller until the semaphore that the receive callback posts becomes
+ *   available, until the busy poll time has elapsed or until a signal is
+ *   pending for the caller.
+ *
+ * Input Parameters:
+ *   dev  - The device to poll or NULL to poll all devices
+ *   sem  - The semaphore that is posted when the receive completes
+ *   usec - The maximum time to poll in microseconds
+ *
+ * Returned Value:
+ *   OK if the semaphore was taken; -ETIMEDOUT if the time elapsed first,
+ *   the caller then has to wait for the semaphore as usual; -EINTR if a
+ *   signal is pending.
+ *
+ * Assumptions:
+ *   The network is locked.  The lock is released briefly whenever a poll
+ *   found nothing, so that other threads can make progress.
+ *
+ ****************************************************************************/
+
+int netdev_busypoll(FAR struct net_driver_s *dev, FAR sem_t *sem,
+                    uint32_t usec)
+{
+  FAR struct tcb_s *rtcb = nxsched_self();
+  unsigned long freq = perf_getfreq();
+  unsigned int count;
+  uint64_t elapsed = 0;
+  uint64_t budget;
+  clock_t last;
+  clock_t now;
+  int npackets;
+
+  /* Without a performance counter the time cannot be measured at the
+   * needed resolution, so poll once only.  The time is summed up in 64
+   * bits, since the budget may not fit in a 32-bit clock_t and the
+   * counter may wrap around meanwhile.
+   */
+
+  budget = (uint64_t)usec * freq / USEC_PER_SEC;
+  last   = perf_gettime();
+
+  for (; ; )
+    {
+      npackets = 0;
+      if (dev != NULL)
+        {
+          netdev_busypoll_callback(dev, &npackets);
+        }
+      else
+        {
+          netdev_foreach(netdev_busypoll_callback, &npackets);
+        }
+
+      if (nxsem_trywait(sem) == OK)
+        {
+          return OK;
+        }
+
+      /* Leave the signal to the caller, as a sleeping reader would */
+
+      if (!sq_empty(&rtcb->sigpendactionq))
+        {
+          return -EINTR;
+        }
+
+      now      = perf_gettime();
+      elapsed += (clock_t)(now - last);
+      last     = now;
+
+      if (elapsed >= budget)
+        {
+          return -ETIMEDOUT;
+        }
+
+      if (npackets == 0 && net_breaklock(&count) >= 0)
+        {
+          sched_yield();
+          net_restorelock(count);
+        }
+    }
+}
+
+#endif /* CONFIG_NET_BUSY_POLL */
@@ -55,8 +55,9 @@ int netdev_count(void)
   struct net_driver_s *dev;
   int ndev;
 
-  net_lock();
-  for (dev = g_netdevices, ndev = 0; dev; dev = dev->flink, ndev++);
-  net_unlock();
+  netdev_list_lock();
+  for (dev = rcu_dereference(g_netdevices), ndev = 0; dev;
+       dev = rcu_dereference(dev->flink), ndev++);
+  netdev_list_unlock();
   return ndev;
 }
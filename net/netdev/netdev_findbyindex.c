@@ -70,7 +70,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 
 #endif
 
-  net_lock();
+  netdev_list_lock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
   /* Check if this index has been assigned */
@@ -79,12 +79,13 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     {
       /* This index has not been assigned */
 
-      net_unlock();
+      netdev_list_unlock();
       return NULL;
     }
 #endif
 
-  for (dev = g_netdevices; dev; dev = dev->flink)
+  for (dev = rcu_dereference(g_netdevices); dev;
+       dev = rcu_dereference(dev->flink))
     {
 #ifdef CONFIG_NETDEV_IFINDEX
       /* Check if the index matches the index assigned when the device was
@@ -102,12 +103,12 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
       if (++i == ifindex)
 #endif
         {
-          net_unlock();
+          netdev_list_unlock();
           return dev;
         }
     }
 
-  net_unlock();
+  netdev_list_unlock();
   return NULL;
 }
 
@@ -451,7 +451,11 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       snprintf(dev->d_ifname, IFNAMSIZ, devfmt, devnum);
 
-      /* Add the device to the list of known network devices */
+      /* Add the device to the list of known network devices.  It is
+       * published last, when the lookups may see it.
+       */
+
+      dev->flink = NULL;
 
       last = &g_netdevices;
       while (*last)
@@ -459,9 +463,7 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
           last = &((*last)->flink);
         }
 
-      *last = dev;
-
-      dev->flink = NULL;
+      rcu_assign_pointer(*last, dev);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
@@ -36,6 +36,7 @@
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
+#include "devif/devif.h"
 #include "netdev/netdev.h"
 
 /****************************************************************************
@@ -133,23 +134,43 @@ int netdev_unregister(FAR struct net_driver_s *dev)
             {
               /* The entry was in the middle or at the end of the list */
 
-              prev->flink = curr->flink;
+              rcu_assign_pointer(prev->flink, curr->flink);
             }
           else
             {
               /* The entry was at the beginning of the list */
 
-              g_netdevices = curr->flink;
+              rcu_assign_pointer(g_netdevices, curr->flink);
             }
-
-          curr->flink = NULL;
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
+
+      /* Forget the connections waiting to be polled on this device */
+
+#ifdef CONFIG_NET_POLL_PENDING
+#  ifdef CONFIG_NET_TCP
+      devif_pending_flush(&dev->d_tcppend);
+#  endif
+#  ifdef CONFIG_NET_UDP
+      devif_pending_flush(&dev->d_udppend);
+#  endif
+#endif
+
       net_unlock();
 
+      if (curr)
+        {
+          /* The lookups that are on the device still follow its link.  Wait
+           * for them without the network lock, which they may need.
+           */
+
+          netdev_list_sync();
+          curr->flink = NULL;
+        }
+
 #ifdef CONFIG_NET_ETHERNET
       ninfo("Unregistered MAC: %02x:%02x:%02x:%02x:%02x:%02x as dev: %s\n",
             dev->d_mac.ether.ether_addr_octet[0],
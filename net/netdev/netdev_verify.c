@@ -53,8 +53,9 @@ bool netdev_verify(FAR struct net_driver_s *dev)
 
   /* Search the list of registered devices */
 
-  net_lock();
-  for (chkdev = g_netdevices; chkdev != NULL; chkdev = chkdev->flink)
+  netdev_list_lock();
+  for (chkdev = rcu_dereference(g_netdevices); chkdev != NULL;
+       chkdev = rcu_dereference(chkdev->flink))
     {
       /* Is the network device that we are looking for? */
 
@@ -67,6 +68,6 @@ bool netdev_verify(FAR struct net_driver_s *dev)
         }
     }
 
-  net_unlock();
+  netdev_list_unlock();
   return valid;
 }
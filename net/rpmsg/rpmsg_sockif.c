@@ -81,6 +81,17 @@ begin_packed_struct struct rpmsg_socket_data_s
   char                           data[0];
 } end_packed_struct;
 
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+/* An RX buffer kept in the rpmsg ring instead of being copied to recvbuf */
+
+struct rpmsg_socket_hold_s
+{
+  FAR void                       *rxbuf;  /* Buffer passed to the ept cb */
+  FAR const uint8_t              *data;   /* Next byte to read */
+  uint32_t                       len;     /* Bytes left to read */
+};
+#endif
+
 struct rpmsg_socket_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -107,6 +118,14 @@ struct rpmsg_socket_conn_s
   uint32_t                       recvlen;
   FAR struct circbuf_s           recvbuf;
 
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+  /* Held RX buffers, their data is read before recvbuf */
+
+  struct rpmsg_socket_hold_s     hold[CONFIG_NET_RPMSG_RXHOLD];
+  uint8_t                        holdhead;
+  uint8_t                        nhold;
+#endif
+
   FAR struct rpmsg_socket_conn_s *next;
 
   /* server listen-scoket listening: backlog > 0;
@@ -300,6 +319,124 @@ static inline uint32_t rpmsg_socket_get_space(
   return conn->sendsize - (conn->sendpos - conn->ackpos);
 }
 
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+static bool rpmsg_socket_hold(FAR struct rpmsg_socket_conn_s *conn,
+                              FAR void *rxbuf, FAR const uint8_t *data,
+                              uint32_t len)
+{
+  FAR struct rpmsg_socket_hold_s *hold;
+
+  /* Data in recvbuf must be read first, so only hold while it is empty.
+   * The number of held buffers is bounded since the ring is shared with
+   * the other endpoints.
+   */
+
+  if (conn->nhold >= CONFIG_NET_RPMSG_RXHOLD ||
+      !circbuf_is_empty(&conn->recvbuf))
+    {
+      return false;
+    }
+
+  hold = &conn->hold[(conn->holdhead + conn->nhold) %
+                     CONFIG_NET_RPMSG_RXHOLD];
+  hold->rxbuf = rxbuf;
+  hold->data  = data;
+  hold->len   = len;
+  conn->nhold++;
+
+  rpmsg_hold_rx_buffer(&conn->ept, rxbuf);
+  return true;
+}
+
+static void rpmsg_socket_unhold(FAR struct rpmsg_socket_conn_s *conn)
+{
+  rpmsg_release_rx_buffer(&conn->ept, conn->hold[conn->holdhead].rxbuf);
+  conn->holdhead = (conn->holdhead + 1) % CONFIG_NET_RPMSG_RXHOLD;
+  conn->nhold--;
+}
+
+static void rpmsg_socket_unhold_all(FAR struct rpmsg_socket_conn_s *conn)
+{
+  while (conn->nhold > 0)
+    {
+      rpmsg_socket_unhold(conn);
+    }
+}
+#else
+#  define rpmsg_socket_unhold_all(conn)
+#endif
+
+/* Bytes waiting to be read: held RX buffers plus recvbuf */
+
+static size_t rpmsg_socket_readable(FAR struct rpmsg_socket_conn_s *conn)
+{
+  size_t len = circbuf_used(&conn->recvbuf);
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+  int i;
+
+  for (i = 0; i < conn->nhold; i++)
+    {
+      len += conn->hold[(conn->holdhead + i) %
+                        CONFIG_NET_RPMSG_RXHOLD].len;
+    }
+#endif
+
+  return len;
+}
+
+/* Read (or skip if buf is NULL) received data, held buffers first */
+
+static ssize_t rpmsg_socket_read(FAR struct rpmsg_socket_conn_s *conn,
+                                 FAR void *buf, size_t len)
+{
+  size_t nread = 0;
+  ssize_t ret;
+
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+  while (conn->nhold > 0 && nread < len)
+    {
+      FAR struct rpmsg_socket_hold_s *hold = &conn->hold[conn->holdhead];
+      uint32_t chunk = MIN(len - nread, hold->len);
+
+      if (buf != NULL)
+        {
+          memcpy((FAR uint8_t *)buf + nread, hold->data, chunk);
+        }
+
+      hold->data += chunk;
+      hold->len  -= chunk;
+      nread      += chunk;
+
+      if (hold->len == 0)
+        {
+          rpmsg_socket_unhold(conn);
+        }
+    }
+
+  if (nread == len)
+    {
+      return nread;
+    }
+#endif
+
+  if (buf != NULL)
+    {
+      ret = circbuf_read(&conn->recvbuf, (FAR uint8_t *)buf + nread,
+                         len - nread);
+    }
+  else
+    {
+      ret = circbuf_skip(&conn->recvbuf, len - nread);
+    }
+
+  if (ret < 0)
+    {
+      return nread > 0 ? nread : ret;
+    }
+
+  return nread + ret;
+}
+
 static int rpmsg_socket_ept_cb(FAR struct rpmsg_endpoint *ept,
                                FAR void *data, size_t len, uint32_t src,
                                FAR void *priv)
@@ -379,7 +516,21 @@ static int rpmsg_socket_ept_cb(FAR struct rpmsg_endpoint *ept,
             {
               ssize_t written;
 
-              written = circbuf_write(&conn->recvbuf, buf, len);
+#if CONFIG_NET_RPMSG_RXHOLD > 0
+              /* Keep the data in the ring, recvmsg copies it to the user
+               * buffer directly.
+               */
+
+              if (rpmsg_socket_hold(conn, data, buf, len))
+                {
+                  written = len;
+                }
+              else
+#endif
+                {
+                  written = circbuf_write(&conn->recvbuf, buf, len);
+                }
+
               if (written != len)
                 {
                   nerr("circbuf_write overflow, %zu, %zu\n", written, len);
@@ -415,6 +566,7 @@ static inline void rpmsg_socket_destroy_ept(
           conn->backlog = -1;
         }
 
+      rpmsg_socket_unhold_all(conn);
       rpmsg_destroy_ept(&conn->ept);
       rpmsg_socket_post(&conn->sendsem);
       rpmsg_socket_post(&conn->recvsem);
@@ -924,7 +1076,7 @@ static int rpmsg_socket_poll(FAR struct socket *psock,
 
           nxmutex_lock(&conn->recvlock);
 
-          if (!circbuf_is_empty(&conn->recvbuf))
+          if (rpmsg_socket_readable(conn) > 0)
             {
               eventset |= POLLIN;
             }
@@ -1209,12 +1361,23 @@ static ssize_t rpmsg_socket_sendmsg(FAR struct socket *psock,
 
   if (psock->s_type == SOCK_STREAM)
     {
-      return rpmsg_socket_send_continuous(psock, buf, len, nonblock);
+      ret = rpmsg_socket_send_continuous(psock, buf, len, nonblock);
     }
   else
     {
-      return rpmsg_socket_send_single(psock, buf, len, nonblock);
+      ret = rpmsg_socket_send_single(psock, buf, len, nonblock);
+    }
+
+  /* Unless the caller has more to send, let the peer see the data now
+   * instead of waiting for the coalesced kick.
+   */
+
+  if ((flags & MSG_MORE) == 0)
+    {
+      rpmsg_flush(&conn->ept);
     }
+
+  return ret;
 }
 
 static ssize_t rpmsg_socket_recvmsg(FAR struct socket *psock,
@@ -1248,13 +1411,13 @@ static ssize_t rpmsg_socket_recvmsg(FAR struct socket *psock,
     {
       uint32_t datalen;
 
-      ret = circbuf_read(&conn->recvbuf, &datalen, sizeof(uint32_t));
+      ret = rpmsg_socket_read(conn, &datalen, sizeof(uint32_t));
       if (ret > 0)
         {
-          ret = circbuf_read(&conn->recvbuf, buf, MIN(datalen, len));
+          ret = rpmsg_socket_read(conn, buf, MIN(datalen, len));
           if (ret > 0 && datalen > ret)
             {
-              circbuf_skip(&conn->recvbuf, datalen - ret);
+              rpmsg_socket_read(conn, NULL, datalen - ret);
             }
 
           conn->recvpos += datalen + sizeof(uint32_t);
@@ -1262,7 +1425,7 @@ static ssize_t rpmsg_socket_recvmsg(FAR struct socket *psock,
     }
   else
     {
-      ret = circbuf_read(&conn->recvbuf, buf, len);
+      ret = rpmsg_socket_read(conn, buf, len);
       conn->recvpos +=  ret > 0 ? ret : 0;
     }
 
@@ -1389,7 +1552,9 @@ static int rpmsg_socket_ioctl(FAR struct socket *psock,
   switch (cmd)
     {
       case FIONREAD:
-        *(FAR int *)((uintptr_t)arg) = circbuf_used(&conn->recvbuf);
+        nxmutex_lock(&conn->recvlock);
+        *(FAR int *)((uintptr_t)arg) = rpmsg_socket_readable(conn);
+        nxmutex_unlock(&conn->recvlock);
         break;
 
       case FIONSPACE:
@@ -0,0 +1,211 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives multiple messages from a socket in one call.
+ *   This is an internal OS interface.  It is functionally equivalent to
+ *   recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   For the families that support it, the network stays locked across the
+ *   whole vector, so datagrams queued in the read-ahead buffers are drained
+ *   with one lock acquisition and one wake-up of the caller.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Array of messages to receive
+ *   vlen      Number of entries in msgvec
+ *   flags     Receive flags, MSG_WAITFORONE turns on MSG_DONTWAIT after
+ *             the first message has been received
+ *   timeout   Optional timeout for the whole operation.  As on Linux, it
+ *             is only checked after each received message.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received; msg_len of each
+ *   entry is set to the number of bytes received.  If no message could be
+ *   received, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  sclock_t ticks;
+  unsigned int i;
+  bool netlock;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL || vlen == 0)
+    {
+      return -EINVAL;
+    }
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_nsec < 0 || timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      clock_time2ticks(timeout, &ticks);
+      deadline = clock_systime_ticks() + ticks;
+    }
+
+  netlock = _SO_BATCH_NETLOCK(psock);
+  if (netlock)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - deadline) >= 0)
+        {
+          i++;
+          break;
+        }
+    }
+
+  if (netlock)
+    {
+      net_unlock();
+    }
+
+  /* Report what has been received so far.  An error that ended a partial
+   * batch is kept as the pending error of the socket, to be read with
+   * SO_ERROR, as Linux does.
+   */
+
+  if (i > 0)
+    {
+      if (ret < 0 && ret != -EAGAIN)
+        {
+          _SO_SETERRNO(psock, -ret);
+        }
+
+      return (int)i;
+    }
+
+  return (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives multiple messages from a socket using a single
+ *   system call.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Array of messages to receive
+ *   vlen     Number of entries in msgvec
+ *   flags    Receive flags
+ *   timeout  Optional timeout for the receive operation
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set appropriately (see recvmsg()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -63,10 +63,12 @@
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
 #define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
 #define _SO_BINDTODEVICE _SO_BIT(SO_BINDTODEVICE)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
+#define _SO_BUSY_POLL    _SO_BIT(SO_BUSY_POLL)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (18)
+#define _SO_MAXOPT       (20)
 
 /* Macros to set, test, clear options */
 
@@ -91,6 +93,15 @@
 #  define _SO_TIMEOUT(t) (UINT_MAX)
 #endif /* CONFIG_NET_SOCKOPTS */
 
+/* The batched recvmmsg()/sendmmsg() paths keep the network locked across
+ * the whole vector.  That is only safe for the families which release the
+ * network lock while blocked (net_sem_wait() and friends).
+ */
+
+#define _SO_BATCH_NETLOCK(s) \
+  ((s)->s_domain == PF_INET || (s)->s_domain == PF_INET6 || \
+   (s)->s_domain == PF_PACKET || (s)->s_domain == PF_CAN)
+
 /* Macro to set socket errors */
 
 #ifdef CONFIG_NET_SOCKOPTS
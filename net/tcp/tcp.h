@@ -108,6 +108,16 @@
 #define TCP_SACK              0x02U /* Selective ACKs enabled */
 #define TCP_CLOSE_ARRANGED    0x04U /* Connection is arranged to be freed */
 
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+/* The buffer auto-tuning flags (at_flags) */
+
+#define TCP_AUTOTUNE_RCVBUF   0x01U /* Receive buffer is auto-tuned */
+#define TCP_AUTOTUNE_SNDBUF   0x02U /* Send buffer is auto-tuned */
+#define TCP_AUTOTUNE_ROUND    0x04U /* A receive RTT measurement is running */
+#define TCP_AUTOTUNE_COUNTED  0x08U /* Counted in the IOB budget sharing */
+
+#endif
+
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
 /* The TCP flags for congestion control */
 
@@ -228,7 +238,13 @@ struct tcp_conn_s
                            * variable */
   uint8_t  rto;           /* Retransmission time-out */
   uint8_t  tcpstateflags; /* TCP state and flags */
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+  dq_entry_t tmnode;      /* Link in the slot of the TCP timer wheel */
+  uint32_t tmexpiry;      /* Wheel position of the expiration */
+  bool     tmarmed;       /* True: linked in the TCP timer wheel */
+#else
   struct   work_s work;   /* TCP timer handle */
+#endif
   bool     timeout;       /* Trigger from timer expiry */
   uint8_t  timer;         /* The retransmission timer (units: half-seconds) */
   uint8_t  nrtx;          /* The number of retransmissions for the last
@@ -273,6 +289,16 @@ struct tcp_conn_s
   int32_t  snd_bufs;      /* Maximum amount of bytes queued in send */
   sem_t    snd_sem;       /* Semaphore signals send completion */
 #endif
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+  uint8_t  at_flags;      /* Buffer auto-tuning flags, see TCP_AUTOTUNE_* */
+  uint32_t at_seq;        /* rcvseq at the start of the RTT measurement */
+  uint32_t at_edge;       /* Window edge that ends the RTT measurement */
+  clock_t  at_time;       /* Start of the RTT measurement (perf_gettime) */
+  clock_t  at_rtt;        /* Shortest receive RTT seen (0: none yet) */
+  clock_t  at_copytime;   /* Start of the current RTT of reads */
+  uint32_t at_copied;     /* Bytes read by the application in that RTT */
+  uint32_t at_space;      /* Most bytes read by the application in one RTT */
+#endif
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) || \
     defined(CONFIG_NET_TCP_WINDOW_SCALE)
   uint32_t tx_unacked;    /* Number bytes sent but not yet ACKed */
@@ -631,7 +657,8 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
  * Description:
  *   If the port number is zero; select an unused port for the connection.
  *   If the port number is non-zero, verify that no other connection has
- *   been created with this port number.
+ *   been created with this port number, unless both connections set
+ *   SO_REUSEPORT in their socket options (opt).
  *
  * Returned Value:
  *   Selected or verified port number in network order on success, a negated
@@ -644,7 +671,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
 int tcp_selectport(uint8_t domain,
                    FAR const union ip_addr_u *ipaddr,
-                   uint16_t portno);
+                   uint16_t portno, sockopt_t opt);
 
 /****************************************************************************
  * Name: tcp_bind
@@ -931,6 +958,51 @@ void tcp_nextsequence(void);
 
 void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_poll_pending
+ *
+ * Description:
+ *   Queue a TCP connection on the pending output queue of its device so
+ *   that the next devif_poll() visits it.  Called together with the TX
+ *   notification of the device.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection with output pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void tcp_poll_pending(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_poll_pending(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Return true if the TCP connection still has output to do after a poll
+ *   that did not produce a packet, i.e. it must stay in the pending output
+ *   queue of its device.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection to check
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+bool tcp_txpending(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_timer
  *
@@ -1042,7 +1114,10 @@ void tcp_stop_timer(FAR struct tcp_conn_s *conn);
  * Name: tcp_findlistener
  *
  * Description:
- *   Return the connection listener for connections on this port (if any)
+ *   Return the connection listener for connections on this port (if any).
+ *   If several sockets listen on the port with SO_REUSEPORT, the remote
+ *   address in uaddr and rport select one of them; a zero rport returns
+ *   any listener.
  *
  * Assumptions:
  *   The network is locked
@@ -1051,11 +1126,11 @@ void tcp_stop_timer(FAR struct tcp_conn_s *conn);
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno,
+                                        uint16_t portno, uint16_t rport,
                                         uint8_t domain);
 #else
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno);
+                                        uint16_t portno, uint16_t rport);
 #endif
 
 /****************************************************************************
@@ -1721,6 +1796,94 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
 
 bool tcp_should_send_recvwindow(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_autotune_rcvrtt
+ *
+ * Description:
+ *   Estimate the round trip time of the connection from the receiver side,
+ *   for the receive buffer auto-tuning.  Called when new in-order data was
+ *   received.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE) && CONFIG_NET_RECV_BUFSIZE > 0
+void tcp_autotune_rcvrtt(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_autotune_rcvrtt(c)
+#endif
+
+/****************************************************************************
+ * Name: tcp_rcvbuf_autotune
+ *
+ * Description:
+ *   Grow the receive buffer of the connection towards twice the amount of
+ *   data that the application reads in one round trip, within the fair
+ *   share of the IOB budget.  Called when the application read data.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *   len  - The number of bytes read.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE) && CONFIG_NET_RECV_BUFSIZE > 0
+void tcp_rcvbuf_autotune(FAR struct tcp_conn_s *conn, size_t len);
+#else
+#  define tcp_rcvbuf_autotune(c,l)
+#endif
+
+/****************************************************************************
+ * Name: tcp_sndbuf_autotune
+ *
+ * Description:
+ *   Grow the send buffer of the connection to twice the window that the
+ *   peer (and the congestion control) allows, when the send buffer is full
+ *   and so limits the transfer, within the fair share of the IOB budget.
+ *   Called when an ACK was received.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_AUTOTUNE) && CONFIG_NET_SEND_BUFSIZE > 0
+void tcp_sndbuf_autotune(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_sndbuf_autotune(c)
+#endif
+
+/****************************************************************************
+ * Name: tcp_autotune_release
+ *
+ * Description:
+ *   Remove a connection that is being freed from the IOB budget sharing.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+void tcp_autotune_release(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_autotune_release(c)
+#endif
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
@@ -0,0 +1,373 @@
+/****************************************************************************
+ * net/tcp/tcp_autotune.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <debug.h>
+
+#include <sys/param.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The part of the IOB pool that all auto-tuned buffers may use together.
+ * The throttled IOBs are reserved for other consumers anyway.
+ */
+
+#define TCP_AUTOTUNE_BUDGET \
+  ((uint32_t)(CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE) * \
+   CONFIG_IOB_BUFSIZE / 100 * CONFIG_NET_TCP_AUTOTUNE_BUDGET)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The number of connections that found their buffers too small at least
+ * once and share the budget.
+ */
+
+static unsigned int g_tcp_autotune_nconns;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_autotune_share
+ *
+ * Description:
+ *   Return the largest size that one buffer of the connection may have.
+ *   The budget is split evenly between the connections that wanted to
+ *   grow their buffers; each one gets half of its share per direction.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_autotune_share(FAR struct tcp_conn_s *conn,
+                                   uint32_t maxsize)
+{
+  uint32_t share;
+
+  /* Join the sharing before the first increase */
+
+  if ((conn->at_flags & TCP_AUTOTUNE_COUNTED) == 0)
+    {
+      conn->at_flags |= TCP_AUTOTUNE_COUNTED;
+      g_tcp_autotune_nconns++;
+    }
+
+  share = TCP_AUTOTUNE_BUDGET / g_tcp_autotune_nconns / 2;
+  if (maxsize > 0 && share > maxsize)
+    {
+      share = maxsize;
+    }
+
+  return share;
+}
+
+/****************************************************************************
+ * Name: tcp_autotune_trim
+ *
+ * Description:
+ *   Shrink the auto-tuned buffers of a sharing connection to its current
+ *   share.  The share gets smaller when more connections join, and the
+ *   buffers that grew before would otherwise keep more than the budget
+ *   together.  Called on every receive and acknowledgment, so a busy
+ *   connection gives back the excess right away; an idle one holds no
+ *   IOBs beyond what it has already queued.
+ *
+ ****************************************************************************/
+
+static void tcp_autotune_trim(FAR struct tcp_conn_s *conn)
+{
+  int32_t share;
+
+  if ((conn->at_flags & TCP_AUTOTUNE_COUNTED) == 0)
+    {
+      return;
+    }
+
+  share = TCP_AUTOTUNE_BUDGET / g_tcp_autotune_nconns / 2;
+
+#if CONFIG_NET_RECV_BUFSIZE > 0
+  if ((conn->at_flags & TCP_AUTOTUNE_RCVBUF) != 0 &&
+      conn->rcv_bufs > share)
+    {
+      conn->rcv_bufs = MAX(share, CONFIG_NET_RECV_BUFSIZE);
+    }
+#endif
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  if ((conn->at_flags & TCP_AUTOTUNE_SNDBUF) != 0 &&
+      conn->snd_bufs > share)
+    {
+      conn->snd_bufs = MAX(share, CONFIG_NET_SEND_BUFSIZE);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_autotune_size
+ *
+ * Description:
+ *   Return the new size of a buffer that wants to grow to 'target', given
+ *   its current and default size and the share limit.  The buffer never
+ *   shrinks below its default size.
+ *
+ ****************************************************************************/
+
+static int32_t tcp_autotune_size(int32_t cursize, int32_t defsize,
+                                 uint32_t target, uint32_t share)
+{
+  uint32_t size = MAX((uint32_t)cursize, target);
+
+  size = MIN(size, share);
+  return MAX((int32_t)size, defsize);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_autotune_rcvrtt
+ *
+ * Description:
+ *   Estimate the round trip time of the connection from the receiver side,
+ *   for the receive buffer auto-tuning.  Called when new in-order data was
+ *   received, which also shrinks the buffers to the current share.
+ *
+ *   A measurement starts at the current receive sequence and ends when the
+ *   peer has sent up to the right window edge advertised at that time,
+ *   which takes at least one round trip.  The shortest measurement is
+ *   kept.  perf_gettime() is used, since a round trip is often shorter
+ *   than a system tick.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_RECV_BUFSIZE > 0
+void tcp_autotune_rcvrtt(FAR struct tcp_conn_s *conn)
+{
+  uint32_t rcvseq = tcp_getsequence(conn->rcvseq);
+  clock_t elapsed;
+  clock_t now;
+
+  tcp_autotune_trim(conn);
+
+  if ((conn->at_flags & TCP_AUTOTUNE_RCVBUF) == 0)
+    {
+      return;
+    }
+
+  now = perf_gettime();
+  if ((conn->at_flags & TCP_AUTOTUNE_ROUND) != 0)
+    {
+      if (TCP_SEQ_LT(rcvseq, conn->at_edge))
+        {
+          return;
+        }
+
+      /* The measurement is complete */
+
+      elapsed = MAX(now - conn->at_time, 1);
+      if (conn->at_rtt == 0 || elapsed < conn->at_rtt)
+        {
+          conn->at_rtt = elapsed;
+        }
+    }
+
+  /* Start the next measurement */
+
+  conn->at_flags |= TCP_AUTOTUNE_ROUND;
+  conn->at_seq    = rcvseq;
+  conn->at_time   = now;
+  conn->at_edge   = TCP_SEQ_GT(conn->rcv_adv, rcvseq) ?
+                    conn->rcv_adv : TCP_SEQ_ADD(rcvseq, conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_rcvbuf_autotune
+ *
+ * Description:
+ *   Grow the receive buffer of the connection towards twice the amount of
+ *   data that the application reads in one round trip, within the fair
+ *   share of the IOB budget.  Called when the application read data.
+ *
+ *   Like the dynamic right-sizing of Linux, the buffer only grows when the
+ *   application read more in the last round trip than in any before:  A
+ *   sender limited by itself, by the path or by a slow reader does not
+ *   make the buffer grow, a window limited one does.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *   len  - The number of bytes read.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_rcvbuf_autotune(FAR struct tcp_conn_s *conn, size_t len)
+{
+  uint32_t copied;
+  int32_t rcv_bufs;
+  clock_t now;
+
+  if ((conn->at_flags & TCP_AUTOTUNE_RCVBUF) == 0 || conn->at_rtt == 0)
+    {
+      return;
+    }
+
+  now = perf_gettime();
+  conn->at_copied += len;
+
+  if (now - conn->at_copytime < conn->at_rtt)
+    {
+      return;
+    }
+
+  /* One round trip of reads is complete */
+
+  copied = conn->at_copied;
+  conn->at_copied   = 0;
+  conn->at_copytime = now;
+
+  if (copied <= conn->at_space)
+    {
+      return;
+    }
+
+  conn->at_space = copied;
+  if (2 * copied <= (uint32_t)conn->rcv_bufs)
+    {
+      return;
+    }
+
+  rcv_bufs = tcp_autotune_size(conn->rcv_bufs, CONFIG_NET_RECV_BUFSIZE,
+                               2 * copied,
+                               tcp_autotune_share(conn,
+                                 CONFIG_NET_MAX_RECV_BUFSIZE));
+  if (rcv_bufs != conn->rcv_bufs)
+    {
+      ninfo("rcv_bufs %" PRId32 " -> %" PRId32 " (read %" PRIu32
+            " in one RTT)\n", conn->rcv_bufs, rcv_bufs, copied);
+      conn->rcv_bufs = rcv_bufs;
+    }
+}
+#endif /* CONFIG_NET_RECV_BUFSIZE > 0 */
+
+/****************************************************************************
+ * Name: tcp_sndbuf_autotune
+ *
+ * Description:
+ *   Grow the send buffer of the connection to twice the window that the
+ *   peer (and the congestion control) allows, when the send buffer is full
+ *   and so limits the transfer, within the fair share of the IOB budget.
+ *   Called when an ACK was received, which also shrinks the buffers to the
+ *   current share.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+void tcp_sndbuf_autotune(FAR struct tcp_conn_s *conn)
+{
+  uint32_t window;
+  int32_t snd_bufs;
+
+  tcp_autotune_trim(conn);
+
+  if ((conn->at_flags & TCP_AUTOTUNE_SNDBUF) == 0 ||
+      tcp_wrbuffer_inqueue_size(conn) < conn->snd_bufs)
+    {
+      return;
+    }
+
+  window = conn->snd_wnd;
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+  window = MIN(window, conn->cwnd);
+#endif
+
+  snd_bufs = tcp_autotune_size(conn->snd_bufs, CONFIG_NET_SEND_BUFSIZE,
+                               2 * window,
+                               tcp_autotune_share(conn,
+                                 CONFIG_NET_MAX_SEND_BUFSIZE));
+  if (snd_bufs != conn->snd_bufs)
+    {
+      ninfo("snd_bufs %" PRId32 " -> %" PRId32 " (window %" PRIu32 ")\n",
+            conn->snd_bufs, snd_bufs, window);
+      conn->snd_bufs = snd_bufs;
+    }
+}
+#endif /* CONFIG_NET_SEND_BUFSIZE > 0 */
+
+/****************************************************************************
+ * Name: tcp_autotune_release
+ *
+ * Description:
+ *   Remove a connection that is being freed from the IOB budget sharing.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_autotune_release(FAR struct tcp_conn_s *conn)
+{
+  if ((conn->at_flags & TCP_AUTOTUNE_COUNTED) != 0)
+    {
+      DEBUGASSERT(g_tcp_autotune_nconns > 0);
+      g_tcp_autotune_nconns--;
+    }
+
+  conn->at_flags = 0;
+}
+
+#endif /* CONFIG_NET_TCP_AUTOTUNE */
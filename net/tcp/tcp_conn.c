@@ -70,6 +70,19 @@
 #include "icmpv6/icmpv6.h"
 #include "nat/nat.h"
 #include "netdev/netdev.h"
+#include "socket/socket.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The socket options that decide whether a local port may be shared */
+
+#ifdef CONFIG_NET_SOCKOPTS
+#  define TCP_SOCKOPTS(c) ((c)->sconn.s_options)
+#else
+#  define TCP_SOCKOPTS(c) 0
+#endif
 
 /****************************************************************************
  * Private Data
@@ -103,18 +116,33 @@ static dq_queue_t g_active_tcp_connections;
  *   Primary uses: (1) to determine if a port number is available, (2) to
  *   To identify the socket that will accept new connections on a local port.
  *
+ *   opt holds the socket options of the connection that wants the port:
+ *   connections that set SO_REUSEPORT as well do not conflict with it.
+ *
  ****************************************************************************/
 
 static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
-               uint16_t portno)
+               uint16_t portno, sockopt_t opt)
 {
   FAR struct tcp_conn_s *conn = NULL;
+#ifdef CONFIG_NET_SOCKOPTS
+  bool reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
   while ((conn = tcp_nextconn(conn)) != NULL)
     {
+#ifdef CONFIG_NET_SOCKOPTS
+      /* Sockets that all set SO_REUSEPORT may share the port */
+
+      if (reuseport && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          continue;
+        }
+#endif
+
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
        */
@@ -360,7 +388,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET,
                        (FAR const union ip_addr_u *)&addr->sin_addr.s_addr,
-                       addr->sin_port);
+                       addr->sin_port, TCP_SOCKOPTS(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -461,7 +489,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET6,
                 (FAR const union ip_addr_u *)addr->sin6_addr.in6_u.u6_addr16,
-                addr->sin6_port);
+                addr->sin6_port, TCP_SOCKOPTS(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -559,6 +587,8 @@ static FAR struct tcp_conn_s *tcp_alloc_conn(void)
  * Input Parameters:
  *   portno -- the selected port number in network order. Zero means no port
  *     selected.
+ *   opt -- the socket options of the connection.  A non-zero port may be
+ *     shared with other connections if all of them set SO_REUSEPORT.
  *
  * Returned Value:
  *   Selected or verified port number in network order on success, a negated
@@ -576,7 +606,7 @@ static FAR struct tcp_conn_s *tcp_alloc_conn(void)
 
 int tcp_selectport(uint8_t domain,
                    FAR const union ip_addr_u *ipaddr,
-                   uint16_t portno)
+                   uint16_t portno, sockopt_t opt)
 {
   static uint16_t g_last_tcp_port;
   ssize_t ret;
@@ -628,7 +658,7 @@ int tcp_selectport(uint8_t domain,
 
           portno = HTONS(g_last_tcp_port);
         }
-      while (tcp_listener(domain, ipaddr, portno)
+      while (tcp_listener(domain, ipaddr, portno, 0)
 #if defined(CONFIG_NET_NAT) && defined(CONFIG_NET_IPv4)
              || (domain == PF_INET &&
                  ipv4_nat_port_inuse(IP_PROTO_TCP, ipaddr->ipv4, portno))
@@ -641,7 +671,7 @@ int tcp_selectport(uint8_t domain,
        * connection is using this local port.
        */
 
-      if (tcp_listener(domain, ipaddr, portno)
+      if (tcp_listener(domain, ipaddr, portno, opt)
 #if defined(CONFIG_NET_NAT) && defined(CONFIG_NET_IPv4)
           || (domain == PF_INET &&
               ipv4_nat_port_inuse(IP_PROTO_TCP, ipaddr->ipv4, portno))
@@ -820,6 +850,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
       nxsem_init(&conn->snd_sem, 0, 0);
 #endif
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+      conn->at_flags      = TCP_AUTOTUNE_RCVBUF | TCP_AUTOTUNE_SNDBUF;
+#endif
 
       /* Set the default value of mss to max, this field will changed when
        * receive SYN.
@@ -924,6 +957,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   tcp_stop_monitor(conn, TCP_CLOSE);
 
+  /* Give back the share of the buffer budget */
+
+  tcp_autotune_release(conn);
+
   /* Free remaining callbacks, actually there should be only the send
    * callback for CONFIG_NET_TCP_WRITE_BUFFERS is left.
    */
@@ -945,6 +982,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
     }
 
+  /* Stop polling the connection for output */
+
+  devif_pending_remove(&conn->sconn);
+
   tcp_free_rx_buffers(conn);
 
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
@@ -1187,6 +1228,12 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 #ifdef CONFIG_NET_SOCKOPTS
       conn->sconn.s_rcvtimeo = listener->sconn.s_rcvtimeo;
       conn->sconn.s_sndtimeo = listener->sconn.s_sndtimeo;
+
+      /* Accepted connections keep sharing the port with the other
+       * members of a SO_REUSEPORT group.
+       */
+
+      conn->sconn.s_options |= listener->sconn.s_options & _SO_REUSEPORT;
 #  ifdef CONFIG_NET_BINDTODEVICE
       conn->sconn.s_boundto  = listener->sconn.s_boundto;
 #  endif
@@ -1201,6 +1248,10 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->snd_bufs         = listener->snd_bufs;
 #endif
       conn->mss              = listener->mss;
+#ifdef CONFIG_NET_TCP_AUTOTUNE
+      conn->at_flags         = listener->at_flags &
+                               (TCP_AUTOTUNE_RCVBUF | TCP_AUTOTUNE_SNDBUF);
+#endif
 
       /* Fill in the necessary fields for the new connection. */
 
@@ -1368,7 +1419,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET,
                                 (FAR const union ip_addr_u *)
-                                &conn->u.ipv4.laddr, 0);
+                                &conn->u.ipv4.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1383,7 +1434,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET6,
                                 (FAR const union ip_addr_u *)
-                                conn->u.ipv6.laddr, 0);
+                                conn->u.ipv6.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -127,4 +127,69 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: tcp_poll_pending
+ *
+ * Description:
+ *   Queue a TCP connection on the pending output queue of its device.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection with output pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void tcp_poll_pending(FAR struct tcp_conn_s *conn)
+{
+  /* The connection is polled through the device it is bound to */
+
+  if (conn->dev != NULL)
+    {
+      devif_pending_add(&conn->dev->d_tcppend, &conn->sconn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Return true if the TCP connection still has output to do.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection to check
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+bool tcp_txpending(FAR struct tcp_conn_s *conn)
+{
+  /* A timer expiration is handled on the next poll */
+
+  if (conn->timeout)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  /* Buffered data that could not be sent yet, e.g. because the window of
+   * the peer is full or no IOB was available.
+   */
+
+  return !sq_empty(&conn->write_q);
+#else
+  /* Unbuffered senders are kicked again by the ACK of the data in flight */
+
+  return false;
+#endif
+}
+#endif /* CONFIG_NET_POLL_PENDING */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -776,6 +776,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 #  endif
         {
           net_ipv6addr_copy(&uaddr.ipv6.laddr, IPv6BUF->destipaddr);
+          net_ipv6addr_copy(&uaddr.ipv6.raddr, IPv6BUF->srcipaddr);
         }
 #endif
 
@@ -786,14 +787,21 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
         {
           net_ipv4addr_copy(uaddr.ipv4.laddr,
                             net_ip4addr_conv32(IPv4BUF->destipaddr));
+          net_ipv4addr_copy(uaddr.ipv4.raddr,
+                            net_ip4addr_conv32(IPv4BUF->srcipaddr));
         }
 #endif
 
+      /* The remote address and port select the listener if several
+       * sockets share this port with SO_REUSEPORT.
+       */
+
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if ((conn = tcp_findlistener(&uaddr, tmp16, domain)) != NULL)
+      conn = tcp_findlistener(&uaddr, tmp16, tcp->srcport, domain);
 #else
-      if ((conn = tcp_findlistener(&uaddr, tmp16)) != NULL)
+      conn = tcp_findlistener(&uaddr, tmp16, tcp->srcport);
 #endif
+      if (conn != NULL)
         {
           if (!tcp_backlogavailable(conn))
             {
@@ -907,31 +915,16 @@ found:
           conn->tcpstateflags = TCP_CLOSED;
           nwarn("WARNING: RESET in TCP_SYN_RCVD\n");
 
-          /* Notify the listener for the connection of the reset event */
-
-#ifdef CONFIG_NET_IPv6
-#  ifdef CONFIG_NET_IPv4
-          if (domain == PF_INET6)
-#  endif
-            {
-              net_ipv6addr_copy(&uaddr.ipv6.laddr, IPv6BUF->destipaddr);
-            }
-#endif
-
-#ifdef CONFIG_NET_IPv4
-#  ifdef CONFIG_NET_IPv6
-          if (domain == PF_INET)
-#  endif
-            {
-              net_ipv4addr_copy(uaddr.ipv4.laddr,
-                                net_ip4addr_conv32(IPv4BUF->destipaddr));
-            }
-#endif
+          /* Notify the listener for the connection of the reset event.
+           * The connection holds the addresses of the handshake, so the
+           * same listener that received the SYN is found.
+           */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-          listener = tcp_findlistener(&uaddr, conn->lport, domain);
+          listener = tcp_findlistener(&conn->u, conn->lport, conn->rport,
+                                      domain);
 #else
-          listener = tcp_findlistener(&uaddr, conn->lport);
+          listener = tcp_findlistener(&conn->u, conn->lport, conn->rport);
 #endif
 
           /* We must free this TCP connection structure; this connection
@@ -1544,6 +1537,22 @@ found:
 
             result = tcp_callback(dev, conn, flags);
 
+            /* Measure the round trip time for the receive buffer tuning */
+
+            if ((flags & TCP_NEWDATA) != 0)
+              {
+                tcp_autotune_rcvrtt(conn);
+              }
+
+            /* Acknowledged data may let the sender queue more output than
+             * fits in this response, have the next poll visit it.
+             */
+
+            if ((flags & TCP_ACKDATA) != 0)
+              {
+                tcp_poll_pending(conn);
+              }
+
             /* Send the response, ACKing the data or not, as appropriate */
 
             tcp_appsend(dev, conn, result);
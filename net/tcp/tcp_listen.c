@@ -53,7 +53,9 @@
 
 #include "devif/devif.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Data
@@ -68,83 +70,254 @@ static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
  ****************************************************************************/
 
 /****************************************************************************
- * Name: tcp_findlistener
+ * Name: tcp_listenermatch
  *
  * Description:
- *   Return the connection listener for connections on this port (if any)
- *
- * Assumptions:
- *   This function is called from network logic with the network locked.
+ *   Return true if the listener connection accepts connections to this
+ *   local address and port.
  *
  ****************************************************************************/
 
+static bool tcp_listenermatch(FAR struct tcp_conn_s *conn,
+                              FAR union ip_binding_u *uaddr,
+                              uint16_t portno, uint8_t domain)
+{
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno,
-                                        uint8_t domain)
+  if (conn == NULL || conn->lport != portno || conn->domain != domain)
 #else
-FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno)
+  if (conn == NULL || conn->lport != portno)
 #endif
-{
-  int ndx;
+    {
+      return false;
+    }
 
-  /* Examine each connection structure in each slot of the listener list */
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (domain == PF_INET6)
+#  endif
+    {
+      return net_ipv6addr_cmp(conn->u.ipv6.laddr, uaddr->ipv6.laddr) ||
+             net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr);
+    }
+#endif
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
     {
-      /* Is this slot assigned?  If so, does the connection have the same
-       * local port number?
-       */
+      return net_ipv4addr_cmp(conn->u.ipv4.laddr, uaddr->ipv4.laddr) ||
+             net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY);
+    }
+#endif
+}
 
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
+/****************************************************************************
+ * Name: tcp_reuseport
+ *
+ * Description:
+ *   Return true if the connection was created with SO_REUSEPORT and may
+ *   share its local port with other listeners.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static inline bool tcp_reuseport(FAR struct tcp_conn_s *conn)
+{
+  return _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT);
+}
 #else
-      if (conn && conn->lport == portno)
+#  define tcp_reuseport(c) false
 #endif
-        {
+
+/****************************************************************************
+ * Name: tcp_flowhash
+ *
+ * Description:
+ *   Hash the remote end of a connection request so that all segments of
+ *   one handshake are steered to the same SO_REUSEPORT listener.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static uint32_t tcp_flowhash(FAR union ip_binding_u *uaddr,
+                             uint16_t rport, uint8_t domain)
+{
 #ifdef CONFIG_NET_IPv6
 #  ifdef CONFIG_NET_IPv4
-          if (domain == PF_INET6)
+  if (domain == PF_INET6)
 #  endif
-            {
-              if (net_ipv6addr_cmp(conn->u.ipv6.laddr, uaddr->ipv6.laddr) ||
-                  net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
-                {
-                  /* Yes.. we found a listener on this port */
-
-                  return conn;
-                }
-            }
+    {
+      return net_flowhash(uaddr->ipv6.raddr, sizeof(net_ipv6addr_t),
+                          rport);
+    }
 #endif
 
 #ifdef CONFIG_NET_IPv4
 #  ifdef CONFIG_NET_IPv6
-          if (domain == PF_INET)
+  else
 #  endif
+    {
+      return net_flowhash(&uaddr->ipv4.raddr, sizeof(in_addr_t), rport);
+    }
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_selectlistener
+ *
+ * Description:
+ *   Return the connection listener for connections on this port (if any).
+ *   If several sockets listen on the port with SO_REUSEPORT, one of them
+ *   is selected by the flow hash of the remote address and port.  A zero
+ *   remote port just returns the first listener found.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *
+tcp_selectlistener(FAR union ip_binding_u *uaddr, uint16_t portno,
+                   uint16_t rport, uint8_t domain)
+{
+  FAR struct tcp_conn_s *first = NULL;
+#ifdef CONFIG_NET_SOCKOPTS
+  unsigned int nlisteners = 0;
+  unsigned int select;
+#endif
+  int ndx;
+
+  /* Examine each connection structure in each slot of the listener list */
+
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+
+      if (tcp_listenermatch(conn, uaddr, portno, domain))
+        {
+          if (first == NULL)
             {
-              if (net_ipv4addr_cmp(conn->u.ipv4.laddr, uaddr->ipv4.laddr) ||
-                  net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
-                {
-                  /* Yes.. we found a listener on this port */
+              /* Yes.. we found a listener on this port.  Done unless it is
+               * one of a SO_REUSEPORT group and we have a flow to steer.
+               */
 
+              first = conn;
+              if (rport == 0 || !tcp_reuseport(conn))
+                {
                   return conn;
                 }
             }
+
+#ifdef CONFIG_NET_SOCKOPTS
+          if (tcp_reuseport(conn))
+            {
+              nlisteners++;
+            }
 #endif
         }
     }
 
-  /* No listener for this port */
+#ifdef CONFIG_NET_SOCKOPTS
+  if (nlisteners > 1)
+    {
+      /* Pick the n-th member of the group.  The listener table is only
+       * modified with the network locked, so the group is the same on the
+       * second pass.
+       */
+
+      select = tcp_flowhash(uaddr, rport, domain) % nlisteners;
+      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+        {
+          FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+
+          if (tcp_listenermatch(conn, uaddr, portno, domain) &&
+              tcp_reuseport(conn) && select-- == 0)
+            {
+              return conn;
+            }
+        }
+    }
+#endif
+
+  return first;
+}
+
+/****************************************************************************
+ * Name: tcp_listenconflict
+ *
+ * Description:
+ *   Return true if some other socket already listens on the local address
+ *   and port of this connection and the two may not share it.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool tcp_listenconflict(FAR struct tcp_conn_s *conn)
+{
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  uint8_t domain = conn->domain;
+#elif defined(CONFIG_NET_IPv4)
+  uint8_t domain = PF_INET;
+#else
+  uint8_t domain = PF_INET6;
+#endif
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      FAR struct tcp_conn_s *listener = tcp_listenports[ndx];
+
+      if (tcp_listenermatch(listener, &conn->u, conn->lport, domain) &&
+          (!tcp_reuseport(listener) || !tcp_reuseport(conn)))
+        {
+          return true;
+        }
+    }
 
-  return NULL;
+  return false;
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_findlistener
+ *
+ * Description:
+ *   Return the connection listener for connections on this port (if any).
+ *   rport (and the raddr field of uaddr) identify the remote end of the
+ *   connection and are used to choose among SO_REUSEPORT listeners; pass
+ *   a zero rport to get any listener.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
+                                        uint16_t portno, uint16_t rport,
+                                        uint8_t domain)
+{
+  return tcp_selectlistener(uaddr, portno, rport, domain);
+}
+#else
+FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
+                                        uint16_t portno, uint16_t rport)
+{
+#ifdef CONFIG_NET_IPv4
+  return tcp_selectlistener(uaddr, portno, rport, PF_INET);
+#else
+  return tcp_selectlistener(uaddr, portno, rport, PF_INET6);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_unlisten
  *
@@ -198,13 +371,12 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
   net_lock();
 
-  /* First, check if there is already a socket listening on this port */
+  /* First, check if there is already a socket listening on this port.
+   * Several sockets may listen on the same port only if all of them set
+   * SO_REUSEPORT.
+   */
 
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  if (tcp_islistener(&conn->u, conn->lport, conn->domain))
-#else
-  if (tcp_islistener(&conn->u, conn->lport))
-#endif
+  if (tcp_listenconflict(conn))
     {
       /* Yes, then we must refuse this request */
 
@@ -254,12 +426,12 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 bool tcp_islistener(FAR union ip_binding_u *uaddr, uint16_t portno,
                     uint8_t domain)
 {
-  return tcp_findlistener(uaddr, portno, domain) != NULL;
+  return tcp_findlistener(uaddr, portno, 0, domain) != NULL;
 }
 #else
 bool tcp_islistener(FAR union ip_binding_u *uaddr, uint16_t portno)
 {
-  return tcp_findlistener(uaddr, portno) != NULL;
+  return tcp_findlistener(uaddr, portno, 0) != NULL;
 }
 #endif
 
@@ -286,9 +458,10 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
    */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  listener = tcp_findlistener(&conn->u, portno, conn->domain);
+  listener = tcp_findlistener(&conn->u, portno, conn->rport,
+                              conn->domain);
 #else
-  listener = tcp_findlistener(&conn->u, portno);
+  listener = tcp_findlistener(&conn->u, portno, conn->rport);
 #endif
   if (listener != NULL)
     {
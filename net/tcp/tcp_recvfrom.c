@@ -727,11 +727,27 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
            * received.
            */
 
-          ret = net_sem_timedwait(&state.ir_sem,
-                               _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+#ifdef CONFIG_NET_BUSY_POLL
+          /* With SO_BUSY_POLL, first run the receive path of the driver
+           * ourselves for a while instead of waiting for it to be scheduled.
+           */
+
+          ret = -ETIMEDOUT;
+          if (conn->sconn.s_busypoll > 0)
+            {
+              ret = netdev_busypoll(conn->dev, &state.ir_sem,
+                                    conn->sconn.s_busypoll);
+            }
+
           if (ret == -ETIMEDOUT)
+#endif
             {
-              ret = -EAGAIN;
+              ret = net_sem_timedwait(&state.ir_sem,
+                                   _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+              if (ret == -ETIMEDOUT)
+                {
+                  ret = -EAGAIN;
+                }
             }
 
           /* Make sure that no further events are processed */
@@ -745,6 +761,13 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
         }
     }
 
+  /* Let the receive buffer follow what the application reads per RTT */
+
+  if (ret > 0)
+    {
+      tcp_rcvbuf_autotune(conn, ret);
+    }
+
   /* Receive additional data from read-ahead buffer, send the ACK timely.
    *
    * Revisit: Because IOBs are system-wide resources, consuming the read
@@ -754,6 +777,7 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   if (tcp_should_send_recvwindow(conn))
     {
+      tcp_poll_pending(conn);
       netdev_txnotify_dev(conn->dev);
     }
 
@@ -938,6 +938,13 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
     }
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
+  /* Let the send buffer follow the window of the peer */
+
+  if ((flags & TCP_ACKDATA) != 0)
+    {
+      tcp_sndbuf_autotune(conn);
+    }
+
   /* Notify the send buffer available if wrbbuffer drained */
 
   tcp_sendbuffer_notify(conn);
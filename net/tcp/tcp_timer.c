@@ -52,6 +52,7 @@
 #include <time.h>
 #include <stdlib.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -77,6 +78,41 @@
 
 #define ACK_DELAY (1)
 
+/* The TCP timer wheel: slots of half a second each */
+
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+#  define TCP_WHEEL_SLOTS  CONFIG_NET_TCP_TIMER_WHEEL_SLOTS
+#  define TCP_WHEEL_MASK   (TCP_WHEEL_SLOTS - 1)
+#  define TCP_WHEEL_TICKS  MAX(HSEC2TICK(1), 1)
+
+#  if (TCP_WHEEL_SLOTS & TCP_WHEEL_MASK) != 0
+#    error CONFIG_NET_TCP_TIMER_WHEEL_SLOTS must be a power of two
+#  endif
+
+#  define TCP_WHEEL_CONN(e) container_of(e, struct tcp_conn_s, tmnode)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+/* Slot (pos & TCP_WHEEL_MASK) holds the connections whose timer expires at
+ * wheel position pos, pos + TCP_WHEEL_SLOTS, pos + 2 * TCP_WHEEL_SLOTS...
+ * A wheel position is the system time in half-seconds.
+ */
+
+static dq_queue_t g_tcp_wheel[TCP_WHEEL_SLOTS];
+
+/* The single work item serving all expirations */
+
+static struct work_s g_tcp_wheel_work;
+
+static uint32_t g_tcp_wheel_done;       /* Last position served */
+static uint32_t g_tcp_wheel_next;       /* Position the work is queued for */
+static unsigned int g_tcp_wheel_narmed; /* Number of armed timers */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -117,6 +153,204 @@ static int tcp_get_timeout(FAR struct tcp_conn_s *conn)
   return timeout;
 }
 
+/****************************************************************************
+ * Name: tcp_wheel_pos
+ *
+ * Description:
+ *   Convert a system time to a position of the TCP timer wheel
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+static inline uint32_t tcp_wheel_pos(clock_t ticks)
+{
+  return (uint32_t)(ticks / TCP_WHEEL_TICKS);
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_schedule
+ *
+ * Description:
+ *   Make sure that the wheel work runs no later than at position pos.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_expiry(FAR void *arg);
+
+static void tcp_wheel_schedule(uint32_t pos)
+{
+  clock_t now;
+  sclock_t delay;
+
+  if (!work_available(&g_tcp_wheel_work) &&
+      (int32_t)(pos - g_tcp_wheel_next) >= 0)
+    {
+      /* Already queued for this position or an earlier one */
+
+      return;
+    }
+
+  now   = clock_systime_ticks();
+  delay = (sclock_t)(int32_t)(pos - tcp_wheel_pos(now)) * TCP_WHEEL_TICKS -
+          (sclock_t)(now % TCP_WHEEL_TICKS);
+
+  g_tcp_wheel_next = pos;
+  work_queue(LPWORK, &g_tcp_wheel_work, tcp_wheel_expiry, NULL,
+             delay > 0 ? delay : 0);
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_remove
+ *
+ * Description:
+ *   Unlink the timer of a TCP connection from the wheel
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_remove(FAR struct tcp_conn_s *conn)
+{
+  if (conn->tmarmed)
+    {
+      dq_rem(&conn->tmnode, &g_tcp_wheel[conn->tmexpiry & TCP_WHEEL_MASK]);
+      conn->tmarmed = false;
+
+      if (--g_tcp_wheel_narmed == 0)
+        {
+          work_cancel(LPWORK, &g_tcp_wheel_work);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_insert
+ *
+ * Description:
+ *   (Re-)arm the timer of a TCP connection to expire after delay ticks.
+ *   The expiration is rounded up to the next slot boundary.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_insert(FAR struct tcp_conn_s *conn, clock_t delay)
+{
+  clock_t now = clock_systime_ticks();
+  uint32_t expiry = tcp_wheel_pos(now + delay + TCP_WHEEL_TICKS - 1);
+
+  if (conn->tmarmed)
+    {
+      if (conn->tmexpiry == expiry)
+        {
+          return;
+        }
+
+      tcp_wheel_remove(conn);
+    }
+
+  /* Start serving from the current position if the wheel was idle */
+
+  if (g_tcp_wheel_narmed++ == 0)
+    {
+      g_tcp_wheel_done = tcp_wheel_pos(now);
+    }
+
+  conn->tmexpiry = expiry;
+  conn->tmarmed  = true;
+  dq_addlast(&conn->tmnode, &g_tcp_wheel[expiry & TCP_WHEEL_MASK]);
+
+  tcp_wheel_schedule(expiry);
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_expiry
+ *
+ * Description:
+ *   Serve all the slots of the TCP timer wheel passed since the last run:
+ *   mark the expired connections for the next device poll, then queue the
+ *   work for the next non-empty slot.
+ *
+ * Input Parameters:
+ *   arg - Not used
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_expiry(FAR void *arg)
+{
+  FAR struct net_driver_s *dev = NULL;
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *next;
+  uint32_t now;
+  uint32_t pos;
+  uint32_t n;
+
+  net_lock();
+
+  now = tcp_wheel_pos(clock_systime_ticks());
+  n   = MIN(now - g_tcp_wheel_done, TCP_WHEEL_SLOTS);
+
+  for (pos = g_tcp_wheel_done + 1; n > 0; pos++, n--)
+    {
+      for (entry = dq_peek(&g_tcp_wheel[pos & TCP_WHEEL_MASK]);
+           entry != NULL; entry = next)
+        {
+          next = dq_next(entry);
+          conn = TCP_WHEEL_CONN(entry);
+
+          /* Entries of the later revolutions stay in the slot */
+
+          if ((int32_t)(conn->tmexpiry - now) > 0)
+            {
+              continue;
+            }
+
+          tcp_wheel_remove(conn);
+          conn->timeout = true;
+          tcp_poll_pending(conn);
+
+          /* Connections expiring together are usually on the same device,
+           * notify it once for the batch.
+           */
+
+          if (conn->dev != dev)
+            {
+              dev = conn->dev;
+              netdev_txnotify_dev(dev);
+            }
+        }
+    }
+
+  g_tcp_wheel_done = now;
+
+  /* Sleep until the next slot that holds a timer */
+
+  if (g_tcp_wheel_narmed > 0)
+    {
+      for (pos = now + 1; pos != now + TCP_WHEEL_SLOTS; pos++)
+        {
+          if (!dq_empty(&g_tcp_wheel[pos & TCP_WHEEL_MASK]))
+            {
+              break;
+            }
+        }
+
+      tcp_wheel_schedule(pos);
+    }
+
+  net_unlock();
+}
+#else
+
 /****************************************************************************
  * Name: tcp_timer_expiry
  *
@@ -147,6 +381,7 @@ static void tcp_timer_expiry(FAR void *arg)
       if (conn == arg)
         {
           conn->timeout = true;
+          tcp_poll_pending(conn);
           netdev_txnotify_dev(conn->dev);
           break;
         }
@@ -154,6 +389,7 @@ static void tcp_timer_expiry(FAR void *arg)
 
   net_unlock();
 }
+#endif /* CONFIG_NET_TCP_TIMER_WHEEL */
 
 /****************************************************************************
  * Name: tcp_xmit_probe
@@ -246,16 +482,20 @@ void tcp_update_timer(FAR struct tcp_conn_s *conn)
         }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+      tcp_wheel_insert(conn, HSEC2TICK(timeout));
+#else
       if (work_available(&conn->work) ||
           TICK2HSEC(work_timeleft(&conn->work)) != timeout)
         {
           work_queue(LPWORK, &conn->work, tcp_timer_expiry,
                      conn, HSEC2TICK(timeout));
         }
+#endif
     }
   else
     {
-      work_cancel(LPWORK, &conn->work);
+      tcp_stop_timer(conn);
     }
 }
 
@@ -333,7 +573,11 @@ void tcp_update_keeptimer(FAR struct tcp_conn_s *conn, int timeout)
 
 void tcp_stop_timer(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+  tcp_wheel_remove(conn);
+#else
   work_cancel(LPWORK, &conn->work);
+#endif
 }
 
 /****************************************************************************
@@ -531,9 +775,10 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
                   listener = tcp_findlistener(&conn->u, conn->lport,
-                                              conn->domain);
+                                              conn->rport, conn->domain);
 #else
-                  listener = tcp_findlistener(&conn->u, conn->lport);
+                  listener = tcp_findlistener(&conn->u, conn->lport,
+                                              conn->rport);
 #endif
                   if (listener != NULL)
                     {
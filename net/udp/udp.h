@@ -147,6 +147,10 @@ struct udp_conn_s
   FAR struct devif_callback_s *sndcb;
 #endif
 
+#ifdef CONFIG_NET_UDP_GSO
+  uint16_t gso_size;      /* UDP_SEGMENT datagram size, 0: disabled */
+#endif
+
 #if defined(CONFIG_NET_IGMP) || defined(CONFIG_NET_MLD)
   struct ip_mreqn mreq;
 #endif
@@ -370,6 +374,51 @@ void udp_ipv6_select(FAR struct net_driver_s *dev);
 
 void udp_poll(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_poll_pending
+ *
+ * Description:
+ *   Queue a UDP connection on the pending output queue of a device so that
+ *   the next devif_poll() of that device visits it.
+ *
+ * Input Parameters:
+ *   dev  - The device that will send the data
+ *   conn - The UDP connection with output pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void udp_poll_pending(FAR struct net_driver_s *dev,
+                      FAR struct udp_conn_s *conn);
+#else
+#  define udp_poll_pending(dev, conn)
+#endif
+
+/****************************************************************************
+ * Name: udp_txpending
+ *
+ * Description:
+ *   Return true if the UDP connection still has queued output after a poll
+ *   that did not produce a packet.
+ *
+ * Input Parameters:
+ *   conn - The UDP connection to check
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+bool udp_txpending(FAR struct udp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_cansend
  *
@@ -440,6 +489,35 @@ int udp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len);
 #endif
 
+/****************************************************************************
+ * Name: udp_getsockopt
+ *
+ * Description:
+ *   udp_getsockopt() retrieves the value for the UDP-protocol option
+ *   specified by the 'option' argument for the socket specified by the
+ *   'psock' argument.
+ *
+ *   See <netinet/udp.h> for the a complete list of values of UDP protocol
+ *   options.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to query
+ *   option    identifies the option to get
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_getsockopt() for
+ *   the complete list of appropriate return error codes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDPPROTO_OPTIONS
+int udp_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len);
+#endif
+
 /****************************************************************************
  * Name: udp_wrbuffer_initialize
  *
@@ -69,6 +69,7 @@
 #include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Data
@@ -105,6 +106,8 @@ static dq_queue_t g_active_udp_connections;
  *   portno - The port to use in the lookup
  *   opt    - The option from another conn to match the conflict conn
  *              SO_REUSEADDR: If both sockets have this, they never confilct.
+ *              SO_REUSEPORT: Likewise, the datagrams are then distributed
+ *                            among the sockets by udp_active().
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -118,6 +121,7 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   FAR struct udp_conn_s *conn = NULL;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
 #endif
 
   /* Now search each connection structure. */
@@ -133,6 +137,13 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
         {
           continue;
         }
+
+      /* Neither do sockets that all set SO_REUSEPORT */
+
+      if (skip_reuseport && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          continue;
+        }
 #endif
 
       /* If the port local port number assigned to the connections matches
@@ -454,6 +465,109 @@ static inline FAR struct udp_conn_s *
 }
 #endif /* CONFIG_NET_IPv6 */
 
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   conn is the first unconnected socket matching a received datagram and
+ *   has SO_REUSEPORT set.  Select one member of its SO_REUSEPORT group,
+ *   i.e. of the unconnected sockets bound to the same local address and
+ *   port, by the flow hash of the source address and port so that all
+ *   datagrams of one flow are received by the same socket.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static bool udp_reuseport_member(FAR struct udp_conn_s *conn,
+                                 FAR struct udp_conn_s *first)
+{
+  if (!_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) ||
+      _UDP_ISCONNECTMODE(conn->flags) || conn->lport != first->lport ||
+      conn->domain != first->domain)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return net_ipv6addr_cmp(conn->u.ipv6.laddr, first->u.ipv6.laddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return net_ipv4addr_cmp(conn->u.ipv4.laddr, first->u.ipv4.laddr);
+    }
+#endif
+}
+
+static FAR struct udp_conn_s *
+  udp_reuseport_select(FAR struct net_driver_s *dev,
+                       FAR struct udp_hdr_s *udp,
+                       FAR struct udp_conn_s *first)
+{
+  FAR struct udp_conn_s *conn;
+  unsigned int nmembers = 0;
+  unsigned int select;
+  uint32_t hash;
+
+  /* Members of the group can only follow the first match in the list */
+
+  for (conn = first; conn != NULL; conn = udp_nextconn(conn))
+    {
+      if (udp_reuseport_member(conn, first))
+        {
+          nmembers++;
+        }
+    }
+
+  if (nmembers <= 1)
+    {
+      return first;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      hash = net_flowhash(IPv6BUF->srcipaddr, sizeof(net_ipv6addr_t),
+                          udp->srcport);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      hash = net_flowhash(IPv4BUF->srcipaddr, sizeof(in_addr_t),
+                          udp->srcport);
+    }
+#endif
+
+  select = hash % nmembers;
+  for (conn = first; conn != NULL; conn = udp_nextconn(conn))
+    {
+      if (udp_reuseport_member(conn, first) && select-- == 0)
+        {
+          break;
+        }
+    }
+
+  return conn;
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
 /****************************************************************************
  * Name: udp_alloc_conn
  *
@@ -691,6 +805,10 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   dq_rem(&conn->sconn.node, &g_active_udp_connections);
 
+  /* Stop polling the connection for output */
+
+  devif_pending_remove(&conn->sconn);
+
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
 
   iob_free_chain(conn->readahead);
@@ -748,12 +866,14 @@ void udp_free(FAR struct udp_conn_s *conn)
 FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
                                   FAR struct udp_hdr_s *udp)
 {
+  FAR struct udp_conn_s *conn;
+
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
 #endif
     {
-      return udp_ipv6_active(dev, udp);
+      conn = udp_ipv6_active(dev, udp);
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -762,9 +882,23 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
   else
 #endif
     {
-      return udp_ipv4_active(dev, udp);
+      conn = udp_ipv4_active(dev, udp);
     }
 #endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_SOCKOPTS
+  /* Spread the flows over all sockets sharing the port with
+   * SO_REUSEPORT.
+   */
+
+  if (conn != NULL && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+      !_UDP_ISCONNECTMODE(conn->flags))
+    {
+      conn = udp_reuseport_select(dev, udp, conn);
+    }
+#endif
+
+  return conn;
 }
 
 /****************************************************************************
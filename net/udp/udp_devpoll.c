@@ -114,4 +114,53 @@ void udp_poll(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn)
   dev->d_len   = 0;
 }
 
+/****************************************************************************
+ * Name: udp_poll_pending
+ *
+ * Description:
+ *   Queue a UDP connection on the pending output queue of a device.
+ *
+ * Input Parameters:
+ *   dev  - The device that will send the data
+ *   conn - The UDP connection with output pending
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_POLL_PENDING
+void udp_poll_pending(FAR struct net_driver_s *dev,
+                      FAR struct udp_conn_s *conn)
+{
+  devif_pending_add(&dev->d_udppend, &conn->sconn);
+}
+
+/****************************************************************************
+ * Name: udp_txpending
+ *
+ * Description:
+ *   Return true if the UDP connection still has queued output.
+ *
+ * Input Parameters:
+ *   conn - The UDP connection to check
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+bool udp_txpending(FAR struct udp_conn_s *conn)
+{
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+  return !sq_empty(&conn->write_q);
+#else
+  return false;
+#endif
+}
+#endif /* CONFIG_NET_POLL_PENDING */
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
@@ -659,11 +659,27 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
            * received.
            */
 
-          ret = net_sem_timedwait(&state.ir_sem,
-                              _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+#ifdef CONFIG_NET_BUSY_POLL
+          /* With SO_BUSY_POLL, first run the receive path of the driver(s)
+           * ourselves for a while instead of waiting for it to be scheduled.
+           */
+
+          ret = -ETIMEDOUT;
+          if (conn->sconn.s_busypoll > 0)
+            {
+              ret = netdev_busypoll(dev, &state.ir_sem,
+                                    conn->sconn.s_busypoll);
+            }
+
           if (ret == -ETIMEDOUT)
+#endif
             {
-              ret = -EAGAIN;
+              ret = net_sem_timedwait(&state.ir_sem,
+                                  _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+              if (ret == -ETIMEDOUT)
+                {
+                  ret = -EAGAIN;
+                }
             }
 
           /* Make sure that no further events are processed */
@@ -36,6 +36,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/param.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -45,6 +46,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <netinet/udp.h>
+
 #include <arch/irq.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
@@ -329,6 +332,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
 
   /* Notify the device driver of the availability of TX data */
 
+  udp_poll_pending(dev, conn);
   netdev_txnotify_dev(dev);
   return OK;
 }
@@ -496,6 +500,73 @@ static unsigned int udp_send_gettimeout(clock_t start, unsigned int timeout)
   return timeout;
 }
 
+/****************************************************************************
+ * Name: udp_sendto_segments
+ *
+ * Description:
+ *   Split one send buffer into UDP_SEGMENT sized datagrams (the last one
+ *   may be shorter).  The network stays locked while the datagrams are
+ *   queued so that they are not interleaved with other senders and are
+ *   drained by the same driver poll.
+ *
+ *   A datagram that cannot be queued (no write buffer with MSG_DONTWAIT,
+ *   a timeout, the connection going down) ends the send.  Like a short
+ *   write, the datagrams queued before it stay queued and are reported,
+ *   the rest of the buffer is not sent and the error is dropped; the
+ *   caller sends the rest again and then gets the error.
+ *
+ * Returned Value:
+ *   The number of bytes of the datagrams that were queued, a multiple of
+ *   the UDP_SEGMENT size, if at least one was queued.  Otherwise the
+ *   negated errno value of the first datagram.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_GSO
+static ssize_t udp_sendto_segments(FAR struct socket *psock,
+                                   FAR const void *buf, size_t len,
+                                   int flags,
+                                   FAR const struct sockaddr *to,
+                                   socklen_t tolen)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  FAR const uint8_t *ptr = buf;
+  size_t gso_size = conn->gso_size;
+  size_t nsent = 0;
+  ssize_t ret = OK;
+
+  if (len > 65535 || len > gso_size * UDP_MAX_SEGMENTS)
+    {
+      return -EMSGSIZE;
+    }
+
+  net_lock();
+
+  while (nsent < len)
+    {
+      ret = psock_udp_sendto(psock, ptr + nsent,
+                             MIN(gso_size, len - nsent), flags, to, tolen);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      nsent += ret;
+    }
+
+  net_unlock();
+
+  /* Report the error only if nothing went out */
+
+  if (nsent == 0)
+    {
+      return ret;
+    }
+
+  return nsent;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -542,6 +613,15 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   conn = psock->s_conn;
 
+#ifdef CONFIG_NET_UDP_GSO
+  /* Let UDP_SEGMENT split large buffers into multiple datagrams */
+
+  if (conn->gso_size > 0 && len > conn->gso_size)
+    {
+      return udp_sendto_segments(psock, buf, len, flags, to, tolen);
+    }
+#endif
+
   /* The length of a datagram to be up to 65,535 octets */
 
   if (len > 65535)
@@ -74,7 +74,46 @@
 int udp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-  return -ENOPROTOOPT;
+  FAR struct udp_conn_s *conn;
+  int ret = -ENOPROTOOPT;
+
+  DEBUGASSERT(psock != NULL && psock->s_conn != NULL);
+  conn = psock->s_conn;
+
+  switch (option)
+    {
+#ifdef CONFIG_NET_UDP_GSO
+      case UDP_SEGMENT: /* Datagram size for segmentation offload */
+        if (value_len != sizeof(int))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            int gso_size = *(FAR const int *)value;
+
+            if (gso_size < 0 || gso_size > UINT16_MAX)
+              {
+                nerr("ERROR: UDP_SEGMENT value out of range: %d\n",
+                     gso_size);
+                ret = -EINVAL;
+              }
+            else
+              {
+                conn->gso_size = gso_size;
+                ret = OK;
+              }
+          }
+        break;
+#endif
+
+      default:
+        nerr("ERROR: Unrecognized UDP option: %d\n", option);
+        UNUSED(conn);
+        break;
+    }
+
+  return ret;
 }
 
 #endif /* CONFIG_NET_UDPPROTO_OPTIONS */
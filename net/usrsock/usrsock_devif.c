@@ -642,6 +642,18 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
   FAR struct usrsock_req_s *req = &g_usrsock_req;
   int ret;
 
+#ifdef CONFIG_DEBUG_ASSERTIONS
+  int sval;
+
+  /* conn->resp holds the xid and the result of a single request, so the
+   * caller must own the connection's request semaphore, taken by
+   * usrsock_setup_request_callback() and released only after the response
+   * was matched or the link was aborted.
+   */
+
+  DEBUGASSERT(nxsem_get_value(&conn->resp.sem, &sval) >= 0 && sval <= 0);
+#endif
+
   /* Get exchange id. */
 
   req_head = iov[0].iov_base;
@@ -664,7 +676,20 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
   req->ackxid = req_head->xid;
 
   ret = usrsock_request(iov, iovcnt);
-  if (ret >= 0)
+  if (ret == USRSOCK_REQUEST_QUEUED)
+    {
+      /* The request was copied out by the transport, so there is no need
+       * to hold the request line until the daemon fetched it.  Response
+       * processing also takes net_lock, which is still held here, so it
+       * cannot have consumed the ackxid yet.  The connection stays
+       * serialized by conn->resp.sem until its response arrives, so no
+       * other request can overwrite conn->resp.xid meanwhile.
+       */
+
+      req->ackxid = 0;
+      ret = OK;
+    }
+  else if (ret >= 0)
     {
       /* Wait ack for request. */
 
@@ -0,0 +1,72 @@
+/****************************************************************************
+ * net/utils/net_flowhash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/hashtable.h>
+
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_flowhash
+ *
+ * Description:
+ *   Compute a hash over the remote end of a flow.  The result is only
+ *   used to spread flows over a group of equivalent sockets, so it has to
+ *   be cheap and stable for the life of the flow, not cryptographically
+ *   strong.
+ *
+ * Input Parameters:
+ *   raddr - The remote IP address (network order)
+ *   len   - The length of the address in bytes (4 or 16)
+ *   rport - The remote port number (network order)
+ *
+ * Returned Value:
+ *   The 32-bit flow hash.
+ *
+ ****************************************************************************/
+
+uint32_t net_flowhash(FAR const void *raddr, unsigned int len,
+                      uint16_t rport)
+{
+  FAR const uint8_t *ptr = raddr;
+  uint32_t hash = rport;
+  uint32_t word;
+
+  for (; len >= sizeof(word); len -= sizeof(word), ptr += sizeof(word))
+    {
+      memcpy(&word, ptr, sizeof(word));
+      hash  = (hash ^ word) * GOLDEN_RATIO_32;
+      hash ^= hash >> 16;
+    }
+
+  return hash;
+}
@@ -33,6 +33,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/clock.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/sched.h>
 #include <nuttx/mm/iob.h>
@@ -116,6 +117,21 @@ _net_timedwait(sem_t *sem, bool interruptible, unsigned int timeout)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_lockstat_initialize
+ *
+ * Description:
+ *   Gather the contention statistics of the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+void net_lockstat_initialize(void)
+{
+  lockstat_bind_sem(&g_netlock.mutex.sem, "net_lock");
+}
+#endif
+
 /****************************************************************************
  * Name: net_lock
  *
@@ -87,6 +87,18 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_lockstat_initialize
+ *
+ * Description:
+ *   Gather the contention statistics of the network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+void net_lockstat_initialize(void);
+#endif
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
@@ -356,6 +368,19 @@ uint16_t icmpv6_chksum(FAR struct net_driver_s *dev, unsigned int iplen);
 FAR void *cmsg_append(FAR struct msghdr *msg, int level, int type,
                       FAR void *value, int value_len);
 
+/****************************************************************************
+ * Name: net_flowhash
+ *
+ * Description:
+ *   Compute a hash over the remote address and port of a flow.  Used by
+ *   SO_REUSEPORT to pick one socket out of a group bound to the same
+ *   local address and port.
+ *
+ ****************************************************************************/
+
+uint32_t net_flowhash(FAR const void *raddr, unsigned int len,
+                      uint16_t rport);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
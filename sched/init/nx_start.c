@@ -62,9 +62,11 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-/* This set of all CPUs */
+/* CPU0 starts the system, so it cannot be isolated */
 
-#define SCHED_ALL_CPUS           ((1 << CONFIG_SMP_NCPUS) - 1)
+#if defined(CONFIG_SMP) && (CONFIG_SMP_ISOLATED_CPUSET & 1) != 0
+#  error CPU0 cannot be in CONFIG_SMP_ISOLATED_CPUSET
+#endif
 
 /****************************************************************************
  * Public Data
@@ -377,11 +379,12 @@ void nx_start(void)
        * enforced by the TCB_FLAG_CPU_LOCKED which overrides the affinity
        * mask.  This is essential because all tasks inherit the affinity
        * mask from their parent and, ultimately, the parent of all tasks is
-       * the IDLE task.
+       * the IDLE task.  The isolated CPUs are left out so that only the
+       * threads bound to them later run there.
        */
 
       g_idletcb[i].cmn.affinity =
-        (cpu_set_t)(CONFIG_SMP_DEFAULT_CPUSET & SCHED_ALL_CPUS);
+        (cpu_set_t)(CONFIG_SMP_DEFAULT_CPUSET & SCHED_HOUSEKEEPING_CPUS);
 #else
       g_idletcb[i].cmn.flags = (TCB_FLAG_TTYPE_KERNEL |
                                 TCB_FLAG_NONCANCELABLE);
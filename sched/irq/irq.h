@@ -44,6 +44,12 @@
 #  error CONFIG_ARCH_NUSER_INTERRUPTS is not defined
 #endif
 
+/* Interrupts can be routed to sets of CPUs */
+
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAVE_IRQAFFINITY)
+#  define HAVE_IRQAFFINITY 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -63,6 +69,9 @@ struct irq_info_s
   clock_t time;      /* Maximum execution time on this IRQ */
   uint32_t count;    /* Number of interrupts on this IRQ */
 #endif
+#ifdef HAVE_IRQAFFINITY
+  cpu_set_t affinity; /* CPUs the IRQ is routed to, zero if not set */
+#endif
 };
 
 #ifdef CONFIG_SCHED_IRQMONITOR
@@ -213,6 +222,22 @@ bool is_irqchain(int ndx, xcpt_t isr);
 int irqchain_attach(int ndx, xcpt_t isr, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: irq_affinity_attach
+ *
+ * Description:
+ *   Route the interrupt 'irq', of index 'ndx' in g_irqvector[], as it is
+ *   attached: to the CPUs set with irq_affinity(), or else to those that
+ *   are not isolated.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_IRQAFFINITY
+void irq_affinity_attach(int irq, int ndx);
+#else
+#  define irq_affinity_attach(irq, ndx)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * sched/irq/irq_affinity.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef HAVE_IRQAFFINITY
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_index
+ *
+ * Description:
+ *   Return the index of 'irq' in g_irqvector[], or a negated errno value.
+ *
+ ****************************************************************************/
+
+static int irq_index(int irq)
+{
+  int ndx;
+
+  if ((unsigned)irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+  ndx = g_irqmap[irq];
+  if ((unsigned)ndx >= CONFIG_ARCH_NUSER_INTERRUPTS)
+    {
+      return -EINVAL;
+    }
+#else
+  ndx = irq;
+#endif
+
+  return ndx;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_affinity
+ *
+ * Description:
+ *   Route the interrupt 'irq' to the CPUs of 'cpuset'.
+ *
+ ****************************************************************************/
+
+int irq_affinity(int irq, cpu_set_t cpuset)
+{
+  irqstate_t flags;
+  int ndx;
+
+  cpuset &= SCHED_ALL_CPUS;
+  ndx     = irq_index(irq);
+  if (ndx < 0 || cpuset == 0)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  g_irqvector[ndx].affinity = cpuset;
+  up_affinity_irq(irq, cpuset);
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: irq_affinity_attach
+ *
+ * Description:
+ *   Route the interrupt 'irq' being attached to the CPUs set for it with
+ *   irq_affinity(), or else away from the isolated CPUs.  The routing set
+ *   by the architecture is left alone when no CPU is isolated.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void irq_affinity_attach(int irq, int ndx)
+{
+  cpu_set_t cpuset = g_irqvector[ndx].affinity;
+
+  if (cpuset == 0 && SCHED_HOUSEKEEPING_CPUS != SCHED_ALL_CPUS)
+    {
+      cpuset = SCHED_HOUSEKEEPING_CPUS;
+      g_irqvector[ndx].affinity = cpuset;
+    }
+
+  if (cpuset != 0)
+    {
+      up_affinity_irq(irq, cpuset);
+    }
+}
+
+#endif /* HAVE_IRQAFFINITY */
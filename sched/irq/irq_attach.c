@@ -95,6 +95,12 @@ int irq_attach(int irq, xcpt_t isr, FAR void *arg)
           isr = irq_unexpected_isr;
           arg = NULL;
         }
+      else
+        {
+          /* Route the interrupt before it is enabled */
+
+          irq_affinity_attach(irq, ndx);
+        }
 
 #ifdef CONFIG_IRQCHAIN
       /* Save the new ISR and its argument in the table.
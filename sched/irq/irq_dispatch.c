@@ -54,14 +54,9 @@
 #endif
 
 #ifdef CONFIG_SCHED_IRQMONITOR
-#  define CALL_VECTOR(ndx, vector, irq, context, arg) \
+#  define IRQ_MONITOR(ndx, vector, irq, elapsed) \
      do \
        { \
-         clock_t start; \
-         clock_t elapsed; \
-         start = perf_gettime(); \
-         vector(irq, context, arg); \
-         elapsed = perf_gettime() - start; \
          if (ndx < NUSER_IRQS) \
            { \
              g_irqvector[ndx].count++; \
@@ -79,9 +74,32 @@
        } \
      while (0)
 #else
+#  define IRQ_MONITOR(ndx, vector, irq, elapsed)
+#endif /* CONFIG_SCHED_IRQMONITOR */
+
+#ifdef CONFIG_SCHED_LATENCY
+#  define IRQ_LATENCY(ndx, elapsed) nxsched_latency_irq(ndx, elapsed)
+#else
+#  define IRQ_LATENCY(ndx, elapsed)
+#endif
+
+#if defined(CONFIG_SCHED_IRQMONITOR) || defined(CONFIG_SCHED_LATENCY)
+#  define CALL_VECTOR(ndx, vector, irq, context, arg) \
+     do \
+       { \
+         clock_t start; \
+         clock_t elapsed; \
+         start = perf_gettime(); \
+         vector(irq, context, arg); \
+         elapsed = perf_gettime() - start; \
+         IRQ_MONITOR(ndx, vector, irq, elapsed); \
+         IRQ_LATENCY(ndx, elapsed); \
+       } \
+     while (0)
+#else
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      vector(irq, context, arg)
-#endif /* CONFIG_SCHED_IRQMONITOR */
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -26,6 +26,8 @@
 
 #include <sys/stat.h>
 #include <stdio.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <string.h>
 #include <assert.h>
@@ -47,26 +49,36 @@
 
 /* Output format:
  *
- *            1111111111222222222233333333334444444444
- *   1234567890123456789012345678901234567890123456789
+ *            111111111122222222223333333333444444444455555555556
+ *   123456789012345678901234567890123456789012345678901234567890
  *
- *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME
- *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD
+ *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME AFFINITY
+ *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD XXXXXXXX
+ *
+ * The AFFINITY column, the set of CPUs the interrupt is routed to, is
+ * present only if the interrupts can be routed.  It is zero if the routing
+ * was left to the architecture.  Writing "<irq> <cpuset>", the set in hex,
+ * to the file routes an interrupt, as irq_affinity() does.
  *
  * NOTE:  This assumes that an address can be represented in 32-bits.  In
  * the typical configuration where CONFIG_HAVE_LONG_LONG=y, the COUNT field
  * may not be wide enough.
  */
 
-#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
-#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#ifdef HAVE_IRQAFFINITY
+#  define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME AFFINITY\n"
+#  define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu %08lx\n"
+#else
+#  define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
+#  define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#endif
 
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic (plus a couple of
  * bytes).
  */
 
-#define IRQ_LINELEN 50
+#define IRQ_LINELEN 60
 
 /****************************************************************************
  * Private Types
@@ -100,6 +112,10 @@ static int     irq_open(FAR struct file *filep, FAR const char *relpath,
 static int     irq_close(FAR struct file *filep);
 static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef HAVE_IRQAFFINITY
+static ssize_t irq_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+#endif
 static int     irq_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     irq_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -118,7 +134,11 @@ const struct procfs_operations g_irq_operations =
   irq_open,       /* open */
   irq_close,      /* close */
   irq_read,       /* read */
+#ifdef HAVE_IRQAFFINITY
+  irq_write,      /* write */
+#else
   NULL,           /* write */
+#endif
 
   irq_dup,        /* dup */
 
@@ -233,12 +253,22 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
 
   /* Output information about this interrupt */
 
+#ifdef HAVE_IRQAFFINITY
+  linesize = snprintf(irqfile->line, IRQ_LINELEN, IRQ_FMT,
+                      (unsigned int)irq,
+                      (unsigned long)((uintptr_t)copy.handler),
+                      (unsigned long)((uintptr_t)copy.arg),
+                      count, intpart, fracpart,
+                      (unsigned long)delta.tv_nsec / 1000,
+                      (unsigned long)copy.affinity);
+#else
   linesize = snprintf(irqfile->line, IRQ_LINELEN, IRQ_FMT,
                       (unsigned int)irq,
                       (unsigned long)((uintptr_t)copy.handler),
                       (unsigned long)((uintptr_t)copy.arg),
                       count, intpart, fracpart,
                       (unsigned long)delta.tv_nsec / 1000);
+#endif
 
   copysize  = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                             irqfile->remaining, &irqfile->offset);
@@ -272,6 +302,7 @@ static int irq_open(FAR struct file *filep, FAR const char *relpath,
 
   finfo("Open '%s'\n", relpath);
 
+#ifndef HAVE_IRQAFFINITY
   /* This PROCFS file is read-only.  Any attempt to open with write access
    * is not permitted.
    */
@@ -281,6 +312,7 @@ static int irq_open(FAR struct file *filep, FAR const char *relpath,
       ferr("ERROR: Only O_RDONLY supported\n");
       return -EACCES;
     }
+#endif
 
   /* Allocate a container to hold the file attributes */
 
@@ -364,6 +396,45 @@ static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
   return irqfile->ncopied;
 }
 
+/****************************************************************************
+ * Name: irq_write
+ *
+ * Description:
+ *   Route the interrupt of a "<irq> <cpuset>" line.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_IRQAFFINITY
+static ssize_t irq_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t buflen)
+{
+  char line[IRQ_LINELEN];
+  FAR char *ptr;
+  FAR char *end;
+  unsigned long irq;
+  unsigned long cpuset;
+  int ret;
+
+  if (buflen >= IRQ_LINELEN)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(line, buffer, buflen);
+  line[buflen] = '\0';
+
+  irq = strtoul(line, &ptr, 10);
+  cpuset = strtoul(ptr, &end, 16);
+  if (ptr == line || end == ptr || irq > INT_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ret = irq_affinity((int)irq, (cpu_set_t)cpuset);
+  return ret < 0 ? ret : buflen;
+}
+#endif
+
 /****************************************************************************
  * Name: irq_dup
  *
@@ -412,10 +483,15 @@ static int irq_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 static int irq_stat(const char *relpath, struct stat *buf)
 {
-  /* "irqs" is the name for a read-only file */
+  /* "irqs" is the name for a read-only file, unless the interrupts can be
+   * routed through it.
+   */
 
   memset(buf, 0, sizeof(struct stat));
   buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+#ifdef HAVE_IRQAFFINITY
+  buf->st_mode |= S_IWUSR;
+#endif
   return OK;
 }
 
@@ -56,6 +56,16 @@ static volatile uint8_t g_irq_rwspin_count[CONFIG_SMP_NCPUS];
 
 #endif
 
+#ifdef CONFIG_MCS_SPINLOCK
+/* The queue nodes of mcs_lock_irqsave(), for each CPU and nesting level */
+
+#define MCS_NESTING 4
+
+static struct mcs_node_s g_irq_mcsnode[CONFIG_SMP_NCPUS][MCS_NESTING];
+static uint8_t g_irq_mcsnode_count[CONFIG_SMP_NCPUS];
+
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -418,4 +428,63 @@ void write_unlock_irqrestore(rwlock_t *lock, irqstate_t flags)
   up_irq_restore(flags);
 }
 #endif /* CONFIG_RW_SPINLOCK */
+
+#ifdef CONFIG_MCS_SPINLOCK
+
+/****************************************************************************
+ * Name: mcs_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts and lock the queued spinlock with the next
+ *   free node of this CPU.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to mcs_lock_irqsave(lock);
+ *
+ ****************************************************************************/
+
+irqstate_t mcs_lock_irqsave(FAR mcs_lock_t *lock)
+{
+  irqstate_t ret;
+  int me;
+
+  ret = up_irq_save();
+  me  = this_cpu();
+
+  DEBUGASSERT(g_irq_mcsnode_count[me] < MCS_NESTING);
+  mcs_lock(lock, &g_irq_mcsnode[me][g_irq_mcsnode_count[me]++]);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mcs_unlock_irqrestore
+ *
+ * Description:
+ *   Release the queued spinlock locked last on this CPU and restore the
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to mcs_lock_irqsave(lock);
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mcs_unlock_irqrestore(FAR mcs_lock_t *lock, irqstate_t flags)
+{
+  int me = this_cpu();
+
+  DEBUGASSERT(g_irq_mcsnode_count[me] > 0);
+  mcs_unlock(lock, &g_irq_mcsnode[me][--g_irq_mcsnode_count[me]]);
+  up_irq_restore(flags);
+}
+
+#endif /* CONFIG_MCS_SPINLOCK */
 #endif /* CONFIG_SMP */
@@ -203,6 +203,17 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
           default_attr.priority = parent->sched_priority;
         }
 
+#ifdef CONFIG_SCHED_DEADLINE
+      /* The priority of a deadline thread is only valid along with its
+       * budget, so the new thread inherits both.
+       */
+
+      if ((parent->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+        {
+          default_attr.inheritsched = PTHREAD_INHERIT_SCHED;
+        }
+#endif
+
       attr = &default_attr;
     }
 
@@ -446,6 +457,36 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
         ptcb->cmn.flags    |= TCB_FLAG_SCHED_SPORADIC;
         break;
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          irqstate_t flags;
+
+          /* A thread inheriting deadline scheduling gets the parameters of
+           * the parent, but a budget and a bandwidth of its own, so it
+           * goes through the admission control as sched_setscheduler()
+           * does.  As on Linux, it is not created if that would exceed the
+           * utilization admitted.
+           */
+
+          flags = enter_critical_section();
+          ret = nxsched_start_deadline(&ptcb->cmn, &param);
+          if (ret >= 0)
+            {
+              ptcb->cmn.flags |= TCB_FLAG_SCHED_DEADLINE;
+            }
+
+          leave_critical_section(flags);
+
+          if (ret < 0)
+            {
+              errcode = ret == -EBUSY ? EAGAIN : -ret;
+              goto errout_with_tcb;
+            }
+        }
+        break;
+#endif
     }
 
 #ifdef CONFIG_CANCELLATION_POINTS
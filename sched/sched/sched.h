@@ -103,6 +103,43 @@
 #  define CRITMONITOR_PANIC(fmt, ...) _alert(fmt, ##__VA_ARGS__)
 #endif
 
+/* Deadline threads of the same priority are ordered by their deadlines.
+ * nxsched_runs_before(a, b) is true if the thread a goes ahead of the
+ * thread b in a prioritized list.
+ */
+
+#ifdef CONFIG_SCHED_DEADLINE
+#  define nxsched_deadline_before(a, b) \
+     (((a)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      ((b)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      (sclock_t)((a)->deadline->absdeadline - \
+                 (b)->deadline->absdeadline) < 0)
+#  define nxsched_runs_before(a, b) \
+     ((a)->sched_priority > (b)->sched_priority || \
+      ((a)->sched_priority == (b)->sched_priority && \
+       nxsched_deadline_before(a, b)))
+#else
+#  define nxsched_runs_before(a, b) \
+     ((a)->sched_priority > (b)->sched_priority)
+#endif
+
+/* The isolated CPUs run only the threads bound to them.  The others, the
+ * housekeeping CPUs, run the system threads and take the interrupts.
+ * A round robin thread that has no peer of its priority on an isolated
+ * CPU is not time sliced, so that the timer leaves the CPU alone, see
+ * nxsched_nohz_cpu().
+ */
+
+#ifdef CONFIG_SMP
+#  define SCHED_ALL_CPUS         ((cpu_set_t)((1 << CONFIG_SMP_NCPUS) - 1))
+#  define SCHED_HOUSEKEEPING_CPUS \
+     ((cpu_set_t)(SCHED_ALL_CPUS & ~CONFIG_SMP_ISOLATED_CPUSET))
+#  define nxsched_isolated_cpu(cpu) \
+     ((CONFIG_SMP_ISOLATED_CPUSET & (1 << (cpu))) != 0)
+#else
+#  define nxsched_nohz_cpu(cpu, tcb) (false)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -362,6 +399,9 @@ void nxsched_reassess_timer(void);
 #if CONFIG_RR_INTERVAL > 0
 uint32_t nxsched_process_roundrobin(FAR struct tcb_s *tcb, uint32_t ticks,
                                     bool noswitches);
+#  ifdef CONFIG_SMP
+bool nxsched_nohz_cpu(int cpu, FAR struct tcb_s *tcb);
+#  endif
 #endif
 
 #ifdef CONFIG_SCHED_SPORADIC
@@ -376,6 +416,16 @@ uint32_t nxsched_process_sporadic(FAR struct tcb_s *tcb, uint32_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb,
+                            FAR const struct sched_param *param);
+int  nxsched_stop_deadline(FAR struct tcb_s *tcb);
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb);
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches);
+void nxsched_deplete_deadline(FAR struct tcb_s *tcb);
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 #endif
@@ -413,6 +463,22 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+/* Latency histograms */
+
+#ifdef CONFIG_SCHED_LATENCY
+void nxsched_latency_irq(int ndx, clock_t elapsed);
+void nxsched_latency_ready(FAR struct tcb_s *tcb);
+void nxsched_resume_latency(FAR struct tcb_s *tcb);
+void nxsched_suspend_latency(FAR struct tcb_s *tcb);
+#endif
+
+/* Per-thread hardware event counts */
+
+#ifdef CONFIG_SCHED_PMU
+void nxsched_resume_pmu(FAR struct tcb_s *tcb);
+void nxsched_suspend_pmu(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -66,19 +66,20 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 {
   FAR struct tcb_s *next;
   FAR struct tcb_s *prev;
-  uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
 
   /* Lets do a sanity check before we get started. */
 
-  DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
+  DEBUGASSERT(tcb->sched_priority >= SCHED_PRIORITY_MIN);
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * Deadline threads of the same priority are in ascending deadline
+   * order.
    */
 
   for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+       (next && !nxsched_runs_before(tcb, next));
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
@@ -70,13 +70,32 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_LATENCY
+  /* The wakeup-to-run latency starts here */
+
+  nxsched_latency_ready(btcb);
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* A deadline thread that wakes up may need a new deadline before it is
+   * placed in the list.
+   */
+
+  if ((btcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+      btcb->task_state >= FIRST_BLOCKED_STATE &&
+      btcb->task_state <= LAST_BLOCKED_STATE)
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
    * also disabled.
    */
 
-  if (rtcb->lockcount > 0 && rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->lockcount > 0 && nxsched_runs_before(btcb, rtcb))
     {
       /* Yes.  Preemption would occur!  Add the new ready-to-run task to the
        * g_pendingtasks task list for now.
@@ -159,6 +178,25 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   int cpu;
   int me;
 
+#ifdef CONFIG_SCHED_LATENCY
+  /* The wakeup-to-run latency starts here */
+
+  nxsched_latency_ready(btcb);
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* A deadline thread that wakes up may need a new deadline before it is
+   * placed in the list.
+   */
+
+  if ((btcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+      btcb->task_state >= FIRST_BLOCKED_STATE &&
+      btcb->task_state <= LAST_BLOCKED_STATE)
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
@@ -186,7 +224,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    * required.
    */
 
-  if (rtcb->sched_priority < btcb->sched_priority)
+  if (nxsched_runs_before(btcb, rtcb))
     {
       task_state = TSTATE_TASK_RUNNING;
     }
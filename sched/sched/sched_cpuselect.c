@@ -48,7 +48,8 @@
  *
  * Description:
  *   Return the index to the CPU with the lowest priority running task,
- *   possibly its IDLE task.
+ *   possibly its IDLE task.  The isolated CPUs are chosen only if the
+ *   thread is not permitted to run on any other CPU.
  *
  * Input Parameters:
  *   affinity - The set of CPUs on which the thread is permitted to run.
@@ -70,6 +71,13 @@ int nxsched_select_cpu(cpu_set_t affinity)
   minprio = SCHED_PRIORITY_MAX;
   cpu     = IMPOSSIBLE_CPU;
 
+  /* Keep off the isolated CPUs if the thread may run elsewhere */
+
+  if ((affinity & SCHED_HOUSEKEEPING_CPUS) != 0)
+    {
+      affinity &= SCHED_HOUSEKEEPING_CPUS;
+    }
+
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
       /* Is the thread permitted to run on this CPU? */
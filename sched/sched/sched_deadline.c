@@ -0,0 +1,507 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <sys/param.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wdog.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The bandwidth of a thread, runtime / period, is a fraction of
+ * DEADLINE_BW_ONE.  The sum for all deadline threads may not exceed
+ * CONFIG_SCHED_DEADLINE_UTILIZATION percent of all CPUs.
+ */
+
+#define DEADLINE_BW_SHIFT  20
+#define DEADLINE_BW_ONE    (UINT32_C(1) << DEADLINE_BW_SHIFT)
+#define DEADLINE_BW_LIMIT \
+  ((uint32_t)((uint64_t)DEADLINE_BW_ONE * CONFIG_SMP_NCPUS * \
+              CONFIG_SCHED_DEADLINE_UTILIZATION / 100))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The bandwidth reserved by all deadline threads */
+
+static uint32_t g_deadline_bw;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_set_priority
+ *
+ * Description:
+ *   Move the thread to a new priority, or to its place among the deadline
+ *   threads of the same priority if its deadline changed.
+ *
+ * Input Parameters:
+ *   tcb      - TCB of the thread whose priority will be modified
+ *   priority - The new priority
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void deadline_set_priority(FAR struct tcb_s *tcb, int priority)
+{
+  int ret;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* A thread whose priority is boosted keeps running at the boosted
+   * priority.  It returns to the new one when the boost ends.
+   */
+
+  if (tcb->sched_priority > tcb->base_priority)
+    {
+      tcb->base_priority = priority;
+      return;
+    }
+#endif
+
+  ret = nxsched_reprioritize(tcb, priority);
+  if (ret < 0)
+    {
+      serr("ERROR: nxsched_reprioritize failed: %d\n", ret);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_replenish
+ *
+ * Description:
+ *   Start the next period of the thread with a full budget.
+ *
+ * Input Parameters:
+ *   tcb - TCB of the thread to replenish
+ *   now - The current time in ticks
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void deadline_replenish(FAR struct tcb_s *tcb, clock_t now)
+{
+  FAR struct deadline_s *deadline = tcb->deadline;
+
+  /* A thread that fell behind by more than a period starts over from now,
+   * it may not use the bandwidth of the periods it missed.
+   */
+
+  deadline->absdeadline += deadline->period;
+  if ((sclock_t)(deadline->absdeadline - now) <= 0)
+    {
+      deadline->absdeadline = now + deadline->deadline;
+    }
+
+  deadline->throttled = false;
+  tcb->timeslice      = deadline->runtime;
+
+  /* Take the place of the new deadline in the deadline priority band */
+
+  deadline_set_priority(tcb, CONFIG_SCHED_DEADLINE_PRIORITY);
+}
+
+/****************************************************************************
+ * Name: deadline_replenish_expire
+ *
+ * Description:
+ *   Handles the expiration of the replenishment timer of a throttled
+ *   thread.
+ *
+ * Input Parameters:
+ *   arg - The TCB of the throttled thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The timer is canceled before the deadline scheduling of the thread is
+ *   stopped.
+ *
+ ****************************************************************************/
+
+static void deadline_replenish_expire(wdparm_t arg)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)arg;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  deadline_replenish(tcb, clock_systime_ticks());
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Called to start deadline scheduling on a given thread, or to restart it
+ *   with new parameters.  The thread gets a full budget and a deadline
+ *   relative to now.  The caller moves it to the deadline priority band.
+ *
+ *     - When establishing deadline scheduling policy via
+ *       sched_setscheduler()
+ *     - When the deadline scheduling parameters are changed via
+ *       sched_setparam().
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread that is beginning deadline scheduling.
+ *   param - The runtime, deadline and period of the thread.  A zero period
+ *           is the deadline.
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *
+ *   EINVAL The parameters do not satisfy runtime <= deadline <= period.
+ *   EBUSY  The new bandwidth would exceed the utilization admitted.
+ *   ENOMEM The deadline scheduling data could not be allocated.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb,
+                           FAR const struct sched_param *param)
+{
+  FAR struct deadline_s *deadline;
+  sclock_t runtime_ticks;
+  sclock_t deadline_ticks;
+  sclock_t period_ticks;
+  uint32_t bandwidth;
+  uint32_t oldbw;
+
+  DEBUGASSERT(tcb != NULL && param != NULL);
+
+  /* Convert timespec values to system clock ticks */
+
+  clock_time2ticks(&param->sched_dl_runtime, &runtime_ticks);
+  clock_time2ticks(&param->sched_dl_deadline, &deadline_ticks);
+  clock_time2ticks(&param->sched_dl_period, &period_ticks);
+
+  if (period_ticks == 0)
+    {
+      period_ticks = deadline_ticks;
+    }
+
+  if (runtime_ticks < 1 || deadline_ticks < runtime_ticks ||
+      period_ticks < deadline_ticks || period_ticks > INT32_MAX)
+    {
+      return -EINVAL;
+    }
+
+  /* Admission control: the threads must not be promised more time than
+   * the CPUs have, otherwise no deadline is guaranteed.
+   */
+
+  bandwidth = ((uint64_t)runtime_ticks << DEADLINE_BW_SHIFT) /
+              period_ticks;
+
+  deadline  = tcb->deadline;
+  oldbw     = deadline != NULL ? deadline->bandwidth : 0;
+
+  if (g_deadline_bw - oldbw + bandwidth > DEADLINE_BW_LIMIT)
+    {
+      return -EBUSY;
+    }
+
+  if (deadline == NULL)
+    {
+      /* Allocate the deadline add-on data structure that will hold the
+       * deadline scheduling parameters and state data.
+       */
+
+      deadline = kmm_zalloc(sizeof(struct deadline_s));
+      if (deadline == NULL)
+        {
+          serr("ERROR: Failed to allocate deadline data structure\n");
+          return -ENOMEM;
+        }
+
+      tcb->deadline = deadline;
+    }
+  else
+    {
+      /* Forget the period in progress */
+
+      wd_cancel(&deadline->timer);
+    }
+
+  g_deadline_bw          = g_deadline_bw - oldbw + bandwidth;
+
+  deadline->throttled    = false;
+  deadline->bandwidth    = bandwidth;
+  deadline->runtime      = runtime_ticks;
+  deadline->deadline     = deadline_ticks;
+  deadline->period       = period_ticks;
+  deadline->absdeadline  = clock_systime_ticks() + deadline_ticks;
+  tcb->timeslice         = runtime_ticks;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Called to terminate deadline scheduling on a given thread, to give
+ *   back its bandwidth and to free all resources associated with the
+ *   policy.  This function is called in the following circumstances:
+ *
+ *     - When any thread exits with deadline scheduling active.
+ *     - When any thread using deadline scheduling is changed to use
+ *       some other scheduling policy via sched_setscheduler()
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is ending deadline scheduling.
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+int nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+
+  wd_cancel(&tcb->deadline->timer);
+  g_deadline_bw -= tcb->deadline->bandwidth;
+
+  kmm_free(tcb->deadline);
+  tcb->deadline = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_deadline
+ *
+ * Description:
+ *   Called when a thread using deadline scheduling wakes up, before it is
+ *   added to the ready-to-run list.  This is the wakeup rule of the
+ *   constant bandwidth server: the thread keeps its deadline only if the
+ *   rest of its budget can be used before that deadline without exceeding
+ *   the bandwidth reserved, that is if
+ *
+ *     budget / (deadline - now) <= runtime / period
+ *
+ *   Otherwise a new period with a full budget starts now.  A thread that
+ *   sleeps can then not save up its budget to delay the others.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that wakes up.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *deadline;
+  clock_t now;
+  sclock_t left;
+  uint32_t budget;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  deadline = tcb->deadline;
+
+  /* The replenishment timer starts the next period of a throttled thread */
+
+  if (deadline->throttled)
+    {
+      return;
+    }
+
+  now    = clock_systime_ticks();
+  left   = deadline->absdeadline - now;
+  budget = MAX(tcb->timeslice, 0);
+
+  if (left <= 0 ||
+      (uint64_t)budget * deadline->period >
+      (uint64_t)left * deadline->runtime)
+    {
+      deadline->absdeadline = now + deadline->deadline;
+      tcb->timeslice        = deadline->runtime;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_process_deadline
+ *
+ * Description:
+ *   Process the elapsed time interval.  Called from the timer interrupt
+ *   handler while the thread with deadline scheduling is running.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the thread using deadline scheduling.
+ *   ticks      - The number of elapsed ticks since the last time this
+ *                function was called.
+ *   noswitches - We are running in a context where context switching is
+ *                not permitted.
+ *
+ * Returned Value:
+ *   The number if ticks remaining until the budget is exhausted.  Zero is
+ *   returned if the thread is throttled.
+ *
+ *   The value one may returned when the budget is exhausted but
+ *   noswitches == true.  The thread is then throttled at the next timer
+ *   expiration.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The thread uses the deadline scheduling policy
+ *
+ ****************************************************************************/
+
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches)
+{
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+
+  /* A throttled thread runs only when there is nothing else to run, until
+   * the replenishment timer gives it its next budget.  A negative budget
+   * means that the thread will be throttled by sched_unlock().
+   */
+
+  if (tcb->deadline->throttled || tcb->timeslice < 0)
+    {
+      return 0;
+    }
+
+  /* Charge the elapsed time to the budget */
+
+  if ((uint32_t)tcb->timeslice > ticks)
+    {
+      tcb->timeslice -= ticks;
+      return tcb->timeslice;
+    }
+
+  tcb->timeslice = 0;
+
+  /* The budget is exhausted.  A thread with the scheduler locked cannot be
+   * throttled now.
+   */
+
+  if (nxsched_islocked_tcb(tcb))
+    {
+      tcb->timeslice = -1;
+      return 0;
+    }
+
+  /* We will also suppress context switches if we were called via one of
+   * the unusual cases handled by nxsched_reassess_timer().  Return one so
+   * that the timer will expire as soon as possible.
+   */
+
+  if (noswitches)
+    {
+      return 1;
+    }
+
+  nxsched_deplete_deadline(tcb);
+  return tcb->deadline->throttled ? 0 : tcb->timeslice;
+}
+
+/****************************************************************************
+ * Name: nxsched_deplete_deadline
+ *
+ * Description:
+ *   Handle a thread that used up the budget of its period.  If its next
+ *   period has not started yet, the thread is throttled to the lowest
+ *   priority until it does.  Otherwise the next period starts now.
+ *   Called from:
+ *
+ *   - nxsched_process_deadline() when the budget is exhausted.
+ *   - sched_unlock().  When the budget was exhausted while the thread had
+ *     the scheduler locked.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread whose budget is exhausted.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The thread uses the deadline scheduling policy
+ *
+ ****************************************************************************/
+
+void nxsched_deplete_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *deadline;
+  clock_t now;
+  clock_t next;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  deadline = tcb->deadline;
+
+  now  = clock_systime_ticks();
+  next = deadline->absdeadline - deadline->deadline + deadline->period;
+
+  tcb->timeslice = 0;
+
+  if ((sclock_t)(next - now) > 0)
+    {
+      deadline->throttled = true;
+      wd_start(&deadline->timer, next - now, deadline_replenish_expire,
+               (wdparm_t)tcb);
+
+      deadline_set_priority(tcb, SCHED_PRIORITY_MIN);
+    }
+  else
+    {
+      deadline_replenish(tcb, now);
+    }
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
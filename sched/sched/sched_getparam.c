@@ -34,6 +34,40 @@
 #include "clock/clock.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_get_deadline
+ *
+ * Description:
+ *   Return the parameters associated with SCHED_DEADLINE, zero if tcb does
+ *   not use the deadline scheduling policy.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+static void nxsched_get_deadline(FAR struct tcb_s *tcb,
+                                 FAR struct sched_param *param)
+{
+  FAR struct deadline_s *deadline = NULL;
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      deadline = tcb->deadline;
+      DEBUGASSERT(deadline != NULL);
+    }
+
+  clock_ticks2time(deadline ? (sclock_t)deadline->runtime : 0,
+                   &param->sched_dl_runtime);
+  clock_ticks2time(deadline ? (sclock_t)deadline->deadline : 0,
+                   &param->sched_dl_deadline);
+  clock_ticks2time(deadline ? (sclock_t)deadline->period : 0,
+                   &param->sched_dl_period);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -85,6 +119,10 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
       /* Return the priority if the calling task. */
 
       param->sched_priority = (int)rtcb->sched_priority;
+
+#ifdef CONFIG_SCHED_DEADLINE
+      nxsched_get_deadline(rtcb, param);
+#endif
     }
 
   /* This PID is not for the calling task, we will have to look it up */
@@ -135,6 +173,10 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
               param->sched_ss_init_budget.tv_nsec = 0;
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          nxsched_get_deadline(tcb, param);
+#endif
         }
 
       sched_unlock();
@@ -0,0 +1,338 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched_latency.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+#  define NUSER_IRQS CONFIG_ARCH_NUSER_INTERRUPTS
+#else
+#  define NUSER_IRQS NR_IRQS
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The histograms of one CPU.  They are only updated by that CPU with its
+ * interrupts disabled, so no lock is needed; readers may see a histogram
+ * that is being updated.
+ */
+
+struct latency_cpu_s
+{
+  FAR struct tcb_s *switch_tcb;     /* Thread suspended last */
+  clock_t switch_start;             /* Time it was suspended */
+  uint32_t dropped;                 /* Wakeups with no priority histogram */
+  uint16_t nprio;                   /* Priority histograms in use */
+  uint8_t prio[CONFIG_SCHED_LATENCY_NPRIORITIES];
+  struct latency_hist_s cswitch;
+  struct latency_hist_s wake[CONFIG_SCHED_LATENCY_NPRIORITIES];
+#if NUSER_IRQS > 0
+  struct latency_hist_s irq[NUSER_IRQS];
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct latency_cpu_s g_latency[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_record
+ *
+ * Description:
+ *   Count a duration in its log2 bucket.
+ *
+ * Assumptions:
+ *   Interrupts are disabled on this CPU.
+ *
+ ****************************************************************************/
+
+static void latency_record(FAR struct latency_hist_s *hist, clock_t elapsed)
+{
+  int index = flsll((long long)elapsed);
+
+  if (index >= CONFIG_SCHED_LATENCY_NBUCKETS)
+    {
+      index = CONFIG_SCHED_LATENCY_NBUCKETS - 1;
+    }
+
+  hist->bucket[index]++;
+  hist->count++;
+
+  if (elapsed > hist->max)
+    {
+      hist->max = elapsed;
+    }
+}
+
+/****************************************************************************
+ * Name: latency_wakehist
+ *
+ * Description:
+ *   Find the wakeup histogram of a priority on this CPU, claiming a free
+ *   one for a priority not seen before.
+ *
+ ****************************************************************************/
+
+static FAR struct latency_hist_s *
+latency_wakehist(FAR struct latency_cpu_s *cpu, uint8_t priority)
+{
+  int i;
+
+  for (i = 0; i < cpu->nprio; i++)
+    {
+      if (cpu->prio[i] == priority)
+        {
+          return &cpu->wake[i];
+        }
+    }
+
+  if (cpu->nprio < CONFIG_SCHED_LATENCY_NPRIORITIES)
+    {
+      cpu->prio[cpu->nprio] = priority;
+      return &cpu->wake[cpu->nprio++];
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_irq
+ *
+ * Description:
+ *   Count the duration of an interrupt handler.
+ *
+ * Input Parameters:
+ *   ndx     - Index of the IRQ in g_irqvector[]
+ *   elapsed - Duration of the handler in perf_gettime() counts
+ *
+ ****************************************************************************/
+
+void nxsched_latency_irq(int ndx, clock_t elapsed)
+{
+#if NUSER_IRQS > 0
+  irqstate_t flags;
+
+  if ((unsigned int)ndx < NUSER_IRQS)
+    {
+      /* Handlers may nest on some architectures */
+
+      flags = up_irq_save();
+      latency_record(&g_latency[this_cpu()].irq[ndx], elapsed);
+      up_irq_restore(flags);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_ready
+ *
+ * Description:
+ *   Note the time a thread was made ready-to-run.  A thread that is made
+ *   ready-to-run again before it runs keeps the first time.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_ready(FAR struct tcb_s *tcb)
+{
+  if (tcb->ready_start == 0)
+    {
+      tcb->ready_start = perf_gettime();
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_suspend_latency
+ *
+ * Description:
+ *   Called when the thread tcb is suspended on this CPU.  The context
+ *   switch cost is measured from here to the following resume.
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_latency(FAR struct tcb_s *tcb)
+{
+  FAR struct latency_cpu_s *cpu = &g_latency[this_cpu()];
+
+  /* A thread that is still running is not waiting for a wakeup */
+
+  tcb->ready_start  = 0;
+
+  cpu->switch_tcb   = tcb;
+  cpu->switch_start = perf_gettime();
+}
+
+/****************************************************************************
+ * Name: nxsched_resume_latency
+ *
+ * Description:
+ *   Called when the thread tcb is resumed on this CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_resume_latency(FAR struct tcb_s *tcb)
+{
+  FAR struct latency_cpu_s *cpu = &g_latency[this_cpu()];
+  FAR struct latency_hist_s *hist;
+  clock_t now = perf_gettime();
+
+  /* A thread resumed after a pause of its CPU did not switch */
+
+  if (cpu->switch_start != 0 && cpu->switch_tcb != tcb)
+    {
+      latency_record(&cpu->cswitch, now - cpu->switch_start);
+    }
+
+  cpu->switch_start = 0;
+
+  if (tcb->ready_start != 0)
+    {
+      hist = latency_wakehist(cpu, tcb->sched_priority);
+      if (hist != NULL)
+        {
+          latency_record(hist, now - tcb->ready_start);
+        }
+      else
+        {
+          cpu->dropped++;
+        }
+
+      tcb->ready_start = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_irqhist
+ ****************************************************************************/
+
+int nxsched_latency_irqhist(int cpu, int irq,
+                            FAR struct latency_hist_s *hist)
+{
+  int ndx = irq;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS || irq < 0 || irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+  ndx = g_irqmap[irq];
+#endif
+
+  if (ndx >= NUSER_IRQS)
+    {
+      return -ENOENT;
+    }
+
+#if NUSER_IRQS > 0
+  *hist = g_latency[cpu].irq[ndx];
+#endif
+  return hist->count > 0 ? OK : -ENOENT;
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_wakehist
+ ****************************************************************************/
+
+int nxsched_latency_wakehist(int cpu, int index, FAR uint8_t *priority,
+                             FAR struct latency_hist_s *hist)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS ||
+      index < 0 || index >= g_latency[cpu].nprio)
+    {
+      return -EINVAL;
+    }
+
+  *priority = g_latency[cpu].prio[index];
+  *hist     = g_latency[cpu].wake[index];
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_switchhist
+ ****************************************************************************/
+
+int nxsched_latency_switchhist(int cpu, FAR struct latency_hist_s *hist,
+                               FAR uint32_t *dropped)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  *hist    = g_latency[cpu].cswitch;
+  *dropped = g_latency[cpu].dropped;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_reset
+ ****************************************************************************/
+
+void nxsched_latency_reset(void)
+{
+  FAR struct latency_cpu_s *cpu;
+
+  /* Samples taken on other CPUs while clearing may survive the reset */
+
+  for (cpu = g_latency; cpu < g_latency + CONFIG_SMP_NCPUS; cpu++)
+    {
+      cpu->dropped = 0;
+      cpu->nprio   = 0;
+      memset(&cpu->cswitch, 0, sizeof(cpu->cswitch));
+      memset(cpu->wake, 0, sizeof(cpu->wake));
+#if NUSER_IRQS > 0
+      memset(cpu->irq, 0, sizeof(cpu->irq));
+#endif
+    }
+}
+
+#endif /* CONFIG_SCHED_LATENCY */
@@ -105,7 +105,7 @@ bool nxsched_merge_pending(void)
            */
 
           for (;
-               (rtcb && ptcb->sched_priority <= rtcb->sched_priority);
+               (rtcb && !nxsched_runs_before(ptcb, rtcb));
                rtcb = rtcb->flink)
             {
             }
@@ -222,7 +222,7 @@ bool nxsched_merge_pending(void)
        * end up in the g_readytorun list.
        */
 
-      while (ptcb->sched_priority > rtcb->sched_priority)
+      while (nxsched_runs_before(ptcb, rtcb))
         {
           /* Remove the task from the pending task list */
 
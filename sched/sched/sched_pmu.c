@@ -0,0 +1,169 @@
+/****************************************************************************
+ * sched/sched/sched_pmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/pmu.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PMU
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The counters of a CPU are free running.  The counts of the thread that
+ * runs on it are the differences from the values read when it was resumed.
+ * Only the CPU itself updates this, with its interrupts disabled.
+ */
+
+struct pmu_cpu_s
+{
+  FAR struct tcb_s *tcb;            /* Thread resumed last */
+  uint64_t start[PMU_NEVENTS];      /* Counters when it was resumed */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct pmu_cpu_s g_pmu[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pmu_elapsed
+ *
+ * Description:
+ *   Add the counts since tcb was resumed on this CPU to counts.
+ *
+ ****************************************************************************/
+
+static void pmu_elapsed(FAR struct pmu_cpu_s *cpu,
+                        FAR struct pmu_counts_s *counts)
+{
+  uint64_t now[PMU_NEVENTS];
+  int i;
+
+  up_pmu_read(now);
+
+  for (i = 0; i < PMU_NEVENTS; i++)
+    {
+      counts->count[i] += now[i] - cpu->start[i];
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_suspend_pmu
+ *
+ * Description:
+ *   Called when the thread tcb is suspended on this CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_pmu(FAR struct tcb_s *tcb)
+{
+  FAR struct pmu_cpu_s *cpu = &g_pmu[this_cpu()];
+
+  /* The threads that ran before the first resume are not counted */
+
+  if (cpu->tcb == tcb)
+    {
+      pmu_elapsed(cpu, &tcb->pmu);
+      cpu->tcb = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_resume_pmu
+ *
+ * Description:
+ *   Called when the thread tcb is resumed on this CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_resume_pmu(FAR struct tcb_s *tcb)
+{
+  FAR struct pmu_cpu_s *cpu = &g_pmu[this_cpu()];
+
+  up_pmu_read(cpu->start);
+  cpu->tcb = tcb;
+}
+
+/****************************************************************************
+ * Name: pmu_events
+ ****************************************************************************/
+
+uint32_t pmu_events(void)
+{
+  return up_pmu_events();
+}
+
+/****************************************************************************
+ * Name: pmu_read
+ ****************************************************************************/
+
+int pmu_read(pid_t pid, FAR struct pmu_counts_s *counts)
+{
+  FAR struct pmu_cpu_s *cpu;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  DEBUGASSERT(counts != NULL);
+
+  /* Keep the thread from being switched or deleted while it is read */
+
+  flags = enter_critical_section();
+
+  tcb = pid == 0 ? this_task() : nxsched_get_tcb(pid);
+  if (tcb == NULL)
+    {
+      leave_critical_section(flags);
+      return -ESRCH;
+    }
+
+  *counts = tcb->pmu;
+
+  cpu = &g_pmu[this_cpu()];
+  if (cpu->tcb == tcb)
+    {
+      pmu_elapsed(cpu, counts);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_PMU */
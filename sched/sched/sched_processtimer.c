@@ -35,6 +35,10 @@
 #  include <nuttx/board.h>
 #endif
 
+#ifdef CONFIG_SCHED_PROFILE
+#  include <nuttx/sched_profile.h>
+#endif
+
 #include "sched/sched.h"
 #include "wdog/wdog.h"
 #include "clock/clock.h"
@@ -58,15 +62,19 @@
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void nxsched_cpu_scheduler(int cpu)
 {
   FAR struct tcb_s *rtcb = current_task(cpu);
 
 #if CONFIG_RR_INTERVAL > 0
-  /* Check if the currently executing task uses round robin scheduling. */
+  /* Check if the currently executing task uses round robin scheduling
+   * and has to share the CPU.
+   */
 
-  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR)
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR &&
+      !nxsched_nohz_cpu(cpu, rtcb))
     {
       /* Yes, check if the currently executing task has exceeded its
        * timeslice.
@@ -88,6 +96,17 @@ static inline void nxsched_cpu_scheduler(int cpu)
       nxsched_process_sporadic(rtcb, 1, false);
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, charge the tick to its budget */
+
+      nxsched_process_deadline(rtcb, 1, false);
+    }
+#endif
 }
 #endif
 
@@ -106,7 +125,8 @@ static inline void nxsched_cpu_scheduler(int cpu)
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void nxsched_process_scheduler(void)
 {
 #ifdef CONFIG_SMP
@@ -142,42 +162,6 @@ static inline void nxsched_process_scheduler(void)
 #  define nxsched_process_scheduler()
 #endif
 
-/****************************************************************************
- * Name: nxsched_process_wdtimer
- *
- * Description:
- *   Wdog timer process, should with critical_section when SMP mode.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   None
- *
- ****************************************************************************/
-
-#ifdef CONFIG_SMP
-static inline void nxsched_process_wdtimer(void)
-{
-  irqstate_t flags;
-
-  /* We are in an interrupt handler and, as a consequence, interrupts are
-   * disabled.  But in the SMP case, interrupts MAY be disabled only on
-   * the local CPU since most architectures do not permit disabling
-   * interrupts on other CPUS.
-   *
-   * Hence, we must follow rules for critical sections even here in the
-   * SMP case.
-   */
-
-  flags = enter_critical_section();
-  wd_timer();
-  leave_critical_section(flags);
-}
-#else
-#  define nxsched_process_wdtimer() wd_timer()
-#endif
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -228,15 +212,23 @@ void nxsched_process_timer(void)
   nxsched_process_cpuload();
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_SCHED_PROFILE_ONESHOT)
+  /* Sample the interrupted context, again before any context switch */
+
+  nxsched_process_profile();
+#endif
+
   /* Check if the currently executing task has exceeded its
    * timeslice.
    */
 
   nxsched_process_scheduler();
 
-  /* Process watchdogs */
+  /* Process watchdogs.  Their list has its own lock, and wd_timer() takes
+   * the critical section only to call the functions of expired watchdogs.
+   */
 
-  nxsched_process_wdtimer();
+  wd_timer();
 
 #ifdef CONFIG_SYSTEMTICK_HOOK
   /* Call out to a user-provided function in order to perform board-specific,
@@ -0,0 +1,398 @@
+/****************************************************************************
+ * sched/sched/sched_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/sched_profile.h>
+#include <nuttx/timers/oneshot.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_TICKLESS) && !defined(CONFIG_SCHED_PROFILE_ONESHOT)
+#  error CONFIG_SCHED_TICKLESS needs CONFIG_SCHED_PROFILE_ONESHOT
+#endif
+
+/* Slots probed for a stack before the sample is counted as dropped */
+
+#define PROFILE_PROBES  8
+
+/* Room for the frames of the interrupt handler that the unwinder returns
+ * ahead of the interrupted code.
+ */
+
+#define PROFILE_BTEXTRA 16
+
+#if CONFIG_SCHED_PROFILE_DEPTH > 1 && defined(CONFIG_ARCH_HAVE_BACKTRACE)
+#  define PROFILE_BACKTRACE
+#endif
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+#  define PROFILE_INTERVAL (USEC_PER_SEC / CONFIG_SCHED_PROFILE_FREQUENCY)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct profile_cpu_s
+{
+  spinlock_t lock;                  /* Protects the fields below */
+  struct profile_stats_s stats;     /* Sampling statistics */
+  struct profile_entry_s entries[CONFIG_SCHED_PROFILE_NENTRIES];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct profile_cpu_s g_profile[CONFIG_SMP_NCPUS];
+static volatile bool g_profile_running;
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+static FAR struct oneshot_lowerhalf_s *g_profile_oneshot;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_hash
+ ****************************************************************************/
+
+static uint32_t profile_hash(pid_t pid, FAR const uintptr_t *pc,
+                             uint8_t depth)
+{
+  uint32_t hash = (uint32_t)pid;
+  int i;
+
+  for (i = 0; i < depth; i++)
+    {
+      hash = (hash ^ (uint32_t)pc[i]) * 2654435761u;
+    }
+
+  return hash ^ (hash >> 16);
+}
+
+/****************************************************************************
+ * Name: profile_record
+ *
+ * Description:
+ *   Count a sample against its stack, claiming a free slot for a stack not
+ *   seen before.
+ *
+ * Assumptions:
+ *   The lock of the CPU is held.
+ *
+ ****************************************************************************/
+
+static void profile_record(FAR struct profile_cpu_s *cpu, pid_t pid,
+                           FAR const uintptr_t *pc, uint8_t depth)
+{
+  FAR struct profile_entry_s *entry;
+  uint32_t index = profile_hash(pid, pc, depth);
+  int i;
+
+  cpu->stats.samples++;
+
+  for (i = 0; i < PROFILE_PROBES; i++, index++)
+    {
+      entry = &cpu->entries[index % CONFIG_SCHED_PROFILE_NENTRIES];
+
+      if (entry->count == 0)
+        {
+          entry->pid   = pid;
+          entry->depth = depth;
+          entry->count = 1;
+          memcpy(entry->pc, pc, depth * sizeof(uintptr_t));
+
+          cpu->stats.nentries++;
+          return;
+        }
+
+      if (entry->pid == pid && entry->depth == depth &&
+          memcmp(entry->pc, pc, depth * sizeof(uintptr_t)) == 0)
+        {
+          entry->count++;
+          return;
+        }
+    }
+
+  cpu->stats.dropped++;
+}
+
+/****************************************************************************
+ * Name: profile_backtrace
+ *
+ * Description:
+ *   Add the callers of the interrupted code after pc[0].  The unwinder
+ *   starts in the interrupt handler, so the frames up to the interrupted
+ *   PC are skipped.
+ *
+ * Returned Value:
+ *   The number of valid entries in pc[].
+ *
+ ****************************************************************************/
+
+#ifdef PROFILE_BACKTRACE
+static uint8_t profile_backtrace(FAR uintptr_t *pc)
+{
+  FAR void *frames[CONFIG_SCHED_PROFILE_DEPTH + PROFILE_BTEXTRA];
+  uint8_t depth = 1;
+  int nframes;
+  int i;
+
+  nframes = up_backtrace(NULL, frames, nitems(frames), 0);
+
+  for (i = 0; i < nframes; i++)
+    {
+      if ((uintptr_t)frames[i] == pc[0])
+        {
+          break;
+        }
+    }
+
+  for (i++; i < nframes && depth < CONFIG_SCHED_PROFILE_DEPTH; i++)
+    {
+      pc[depth++] = (uintptr_t)frames[i];
+    }
+
+  return depth;
+}
+#endif
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+static void profile_oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                                     FAR void *arg);
+
+/****************************************************************************
+ * Name: profile_oneshot_start
+ ****************************************************************************/
+
+static void profile_oneshot_start(void)
+{
+  struct timespec ts;
+
+  ts.tv_sec  = PROFILE_INTERVAL / USEC_PER_SEC;
+  ts.tv_nsec = (PROFILE_INTERVAL % USEC_PER_SEC) * NSEC_PER_USEC;
+
+  DEBUGVERIFY(ONESHOT_START(g_profile_oneshot, profile_oneshot_callback,
+                            NULL, &ts));
+}
+
+/****************************************************************************
+ * Name: profile_oneshot_callback
+ ****************************************************************************/
+
+static void profile_oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                                     FAR void *arg)
+{
+  nxsched_process_profile();
+
+  if (g_profile_running)
+    {
+      profile_oneshot_start();
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_process_profile
+ *
+ * Description:
+ *   Take one sample of the context interrupted on this CPU.
+ *
+ * Assumptions:
+ *   Called from a timer interrupt handler.
+ *
+ ****************************************************************************/
+
+void nxsched_process_profile(void)
+{
+  FAR struct profile_cpu_s *cpu;
+  uintptr_t pc[CONFIG_SCHED_PROFILE_DEPTH];
+  FAR void *regs = (FAR void *)CURRENT_REGS;
+  irqstate_t flags;
+  uint8_t depth = 1;
+
+  if (!g_profile_running || regs == NULL)
+    {
+      return;
+    }
+
+  pc[0] = up_getusrpc(regs);
+
+#ifdef PROFILE_BACKTRACE
+  depth = profile_backtrace(pc);
+#endif
+
+  cpu   = &g_profile[this_cpu()];
+  flags = spin_lock_irqsave(&cpu->lock);
+  profile_record(cpu, running_task()->pid, pc, depth);
+  spin_unlock_irqrestore(&cpu->lock, flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_start
+ ****************************************************************************/
+
+void nxsched_profile_start(void)
+{
+  irqstate_t flags = enter_critical_section();
+
+  if (!g_profile_running)
+    {
+      g_profile_running = true;
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+      if (g_profile_oneshot != NULL)
+        {
+          profile_oneshot_start();
+        }
+#endif
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_stop
+ ****************************************************************************/
+
+void nxsched_profile_stop(void)
+{
+  /* A pending oneshot expires once more and is not restarted */
+
+  g_profile_running = false;
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_reset
+ ****************************************************************************/
+
+void nxsched_profile_reset(void)
+{
+  FAR struct profile_cpu_s *cpu;
+  irqstate_t flags;
+
+  for (cpu = g_profile; cpu < g_profile + CONFIG_SMP_NCPUS; cpu++)
+    {
+      flags = spin_lock_irqsave(&cpu->lock);
+      memset(&cpu->stats, 0, sizeof(cpu->stats));
+      memset(cpu->entries, 0, sizeof(cpu->entries));
+      spin_unlock_irqrestore(&cpu->lock, flags);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_stats
+ ****************************************************************************/
+
+int nxsched_profile_stats(int cpu, FAR struct profile_stats_s *stats)
+{
+  irqstate_t flags;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  flags  = spin_lock_irqsave(&g_profile[cpu].lock);
+  *stats = g_profile[cpu].stats;
+  spin_unlock_irqrestore(&g_profile[cpu].lock, flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_entry
+ ****************************************************************************/
+
+int nxsched_profile_entry(int cpu, int index,
+                          FAR struct profile_entry_s *entry)
+{
+  irqstate_t flags;
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS ||
+      index < 0 || index >= CONFIG_SCHED_PROFILE_NENTRIES)
+    {
+      return -EINVAL;
+    }
+
+  flags  = spin_lock_irqsave(&g_profile[cpu].lock);
+  *entry = g_profile[cpu].entries[index];
+  spin_unlock_irqrestore(&g_profile[cpu].lock, flags);
+
+  return entry->count > 0 ? OK : -ENOENT;
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_oneshot
+ *
+ * Description:
+ *   Take samples from a oneshot timer instead of from the system timer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE_ONESHOT
+void nxsched_profile_oneshot(FAR struct oneshot_lowerhalf_s *lower)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(lower != NULL && lower->ops != NULL);
+  DEBUGASSERT(lower->ops->start != NULL);
+
+  flags = enter_critical_section();
+
+  g_profile_oneshot = lower;
+  if (g_profile_running)
+    {
+      profile_oneshot_start();
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+#endif /* CONFIG_SCHED_PROFILE */
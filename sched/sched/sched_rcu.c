@@ -0,0 +1,256 @@
+/****************************************************************************
+ * sched/sched/sched_rcu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/rcu.h>
+#include <nuttx/signal.h>
+#include <nuttx/wqueue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_RCU
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The read-side counter of a thread holds the nesting depth of its
+ * sections and the phase of the grace period counter when it entered the
+ * outermost one.  A thread with a zero depth is in a quiescent state.
+ *
+ * An updater flips the phase twice and each time waits until no thread is
+ * still in a section entered in the previous phase.  Two flips are needed
+ * because a reader may have read the counter just before the first flip
+ * and stored it in its thread only after the wait.
+ */
+
+#define RCU_NEST_COUNT  UINT32_C(1)
+#define RCU_NEST_MASK   UINT32_C(0x7fffffff)
+#define RCU_PHASE       UINT32_C(0x80000000)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The grace period counter, copied by the readers */
+
+static volatile uint32_t g_rcu_gp = RCU_NEST_COUNT;
+
+/* Serializes the updaters waiting for grace periods */
+
+static mutex_t g_rcu_lock = NXMUTEX_INITIALIZER;
+
+/* The callbacks of call_rcu() waiting for the next grace period */
+
+static sq_queue_t g_rcu_pending;
+static struct work_s g_rcu_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_check_reader
+ *
+ * Description:
+ *   nxsched_foreach() callback: note if tcb is in a section entered in the
+ *   phase before the current one.
+ *
+ ****************************************************************************/
+
+static void rcu_check_reader(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  uint32_t ctr = tcb->rcu_ctr;
+
+  if ((ctr & RCU_NEST_MASK) != 0 && ((ctr ^ g_rcu_gp) & RCU_PHASE) != 0)
+    {
+      *(FAR bool *)arg = true;
+    }
+}
+
+/****************************************************************************
+ * Name: rcu_wait_readers
+ *
+ * Description:
+ *   Wait until no thread is in a section entered in the previous phase.
+ *   The readers are short, so they are polled once per tick, which also
+ *   lets a preempted reader of lower priority on this CPU run.
+ *
+ ****************************************************************************/
+
+static void rcu_wait_readers(void)
+{
+  bool busy;
+
+  for (; ; )
+    {
+      busy = false;
+      nxsched_foreach(rcu_check_reader, &busy);
+      if (!busy)
+        {
+          break;
+        }
+
+      nxsig_usleep(USEC_PER_TICK);
+    }
+}
+
+/****************************************************************************
+ * Name: rcu_worker
+ *
+ * Description:
+ *   Run the callbacks queued by call_rcu() before it after a grace period.
+ *
+ ****************************************************************************/
+
+static void rcu_worker(FAR void *arg)
+{
+  FAR struct rcu_head *head;
+  FAR sq_entry_t *node;
+  sq_queue_t batch;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  sq_move(&g_rcu_pending, &batch);
+  leave_critical_section(flags);
+
+  synchronize_rcu();
+
+  while ((node = sq_remfirst(&batch)) != NULL)
+    {
+      head = container_of(node, struct rcu_head, node);
+      head->func(head);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_read_lock
+ ****************************************************************************/
+
+void rcu_read_lock(void)
+{
+  FAR struct tcb_s *rtcb = running_task();
+  uint32_t ctr = rtcb->rcu_ctr;
+
+  /* An interrupt handler nests in the section of the thread it interrupts,
+   * which is left as it was when the handler returns.
+   */
+
+  if ((ctr & RCU_NEST_MASK) == 0)
+    {
+      /* Enter the current phase before any protected data is read */
+
+      rtcb->rcu_ctr = g_rcu_gp;
+      rcu_mb();
+    }
+  else
+    {
+      DEBUGASSERT((ctr & RCU_NEST_MASK) < RCU_NEST_MASK);
+      rtcb->rcu_ctr = ctr + RCU_NEST_COUNT;
+    }
+}
+
+/****************************************************************************
+ * Name: rcu_read_unlock
+ ****************************************************************************/
+
+void rcu_read_unlock(void)
+{
+  FAR struct tcb_s *rtcb = running_task();
+
+  DEBUGASSERT((rtcb->rcu_ctr & RCU_NEST_MASK) != 0);
+
+  /* Finish reading the protected data before leaving */
+
+  rcu_mb();
+  rtcb->rcu_ctr -= RCU_NEST_COUNT;
+}
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ ****************************************************************************/
+
+void synchronize_rcu(void)
+{
+  DEBUGASSERT(!up_interrupt_context() &&
+              (this_task()->rcu_ctr & RCU_NEST_MASK) == 0);
+
+  nxmutex_lock(&g_rcu_lock);
+
+  /* Let the update be seen before the readers are checked */
+
+  rcu_mb();
+
+  g_rcu_gp ^= RCU_PHASE;
+  rcu_mb();
+  rcu_wait_readers();
+
+  g_rcu_gp ^= RCU_PHASE;
+  rcu_mb();
+  rcu_wait_readers();
+
+  /* Let the data be freed only after the readers are done with it */
+
+  rcu_mb();
+  nxmutex_unlock(&g_rcu_lock);
+}
+
+/****************************************************************************
+ * Name: call_rcu
+ ****************************************************************************/
+
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(head != NULL && func != NULL);
+
+  head->func = func;
+
+  flags = enter_critical_section();
+  sq_addlast(&head->node, &g_rcu_pending);
+
+  /* The callbacks queued while the worker waits go to the next batch */
+
+  if (work_available(&g_rcu_work))
+    {
+      work_queue(LPWORK, &g_rcu_work, rcu_worker, NULL, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SCHED_RCU */
@@ -71,6 +71,12 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_resume_critmon(tcb);
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+  nxsched_resume_latency(tcb);
+#endif
+#ifdef CONFIG_SCHED_PMU
+  nxsched_resume_pmu(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_resume(tcb);
 #endif
@@ -147,4 +147,52 @@ uint32_t nxsched_process_roundrobin(FAR struct tcb_s *tcb, uint32_t ticks,
   return ret;
 }
 
+/****************************************************************************
+ * Name:  nxsched_nohz_cpu
+ *
+ * Description:
+ *   Check if the round robin thread running on an isolated CPU can skip its
+ *   time slice because no peer of its priority may run there.  The peers
+ *   are the threads next to it in the list of the CPU and the unassigned
+ *   threads in g_readytorun that have the CPU in their affinity.
+ *
+ * Input Parameters:
+ *   cpu - The CPU running the thread
+ *   tcb - The TCB of the currently executing task
+ *
+ * Returned Value:
+ *   True if the thread need not be time sliced.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+bool nxsched_nohz_cpu(int cpu, FAR struct tcb_s *tcb)
+{
+  FAR struct tcb_s *peer;
+
+  if (!nxsched_isolated_cpu(cpu) ||
+      tcb->flink->sched_priority >= tcb->sched_priority)
+    {
+      return false;
+    }
+
+  /* g_readytorun is prioritized, stop at the first lower priority */
+
+  for (peer = (FAR struct tcb_s *)g_readytorun.head;
+       peer != NULL && peer->sched_priority >= tcb->sched_priority;
+       peer = peer->flink)
+    {
+      if ((peer->affinity & (1 << cpu)) != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 #endif /* CONFIG_RR_INTERVAL > 0 */
@@ -71,6 +71,7 @@
  *          current scheduling policy.
  *   EPERM  The calling task does not have appropriate privileges.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  The new deadline parameters cannot be admitted.
  *
  ****************************************************************************/
 
@@ -78,6 +79,7 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
 {
   FAR struct tcb_s *rtcb;
   FAR struct tcb_s *tcb;
+  int priority;
   int ret;
 
   /* Verify that the requested priority is in the valid range */
@@ -203,9 +205,33 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
     }
 #endif
 
+  priority = param->sched_priority;
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Update parameters associated with SCHED_DEADLINE.  A deadline thread
+   * keeps the priority of all deadline threads.
+   */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      irqstate_t flags;
+
+      flags = enter_critical_section();
+      ret = nxsched_start_deadline(tcb, param);
+      leave_critical_section(flags);
+
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+
+      priority = CONFIG_SCHED_DEADLINE_PRIORITY;
+    }
+#endif
+
   /* Then perform the reprioritization */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
 
 errout_with_lock:
   sched_unlock();
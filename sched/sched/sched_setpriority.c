@@ -251,10 +251,16 @@ static void nxsched_readytorun_setpriority(FAR struct tcb_s *tcb,
 #endif
 
   /* A context switch will occur if the new priority of the ready-to-run
-   * task is (strictly) greater than the current running task
+   * task is (strictly) greater than the current running task, or if it is
+   * the same and the task is a deadline thread with an earlier deadline.
    */
 
-  if (sched_priority > rtcb->sched_priority)
+  if (sched_priority > rtcb->sched_priority
+#ifdef CONFIG_SCHED_DEADLINE
+      || (sched_priority == rtcb->sched_priority &&
+          nxsched_deadline_before(tcb, rtcb))
+#endif
+     )
     {
       /* A context switch will occur. */
 
@@ -72,6 +72,7 @@
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  The deadline thread cannot be admitted.
  *
  ****************************************************************************/
 
@@ -80,6 +81,8 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 {
   FAR struct tcb_s *tcb;
   irqstate_t flags;
+  uint16_t oldpolicy;
+  int priority;
   int ret;
 
   /* Check for supported scheduling policy */
@@ -91,16 +94,29 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
       return -EINVAL;
     }
 
-  /* Verify that the requested priority is in the valid range */
+  /* Verify that the requested priority is in the valid range.  All
+   * deadline threads run at the same priority, in deadline order.
+   */
+
+  priority = param->sched_priority;
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if (policy == SCHED_DEADLINE)
+    {
+      priority = CONFIG_SCHED_DEADLINE_PRIORITY;
+    }
+#endif
 
-  if (param->sched_priority < SCHED_PRIORITY_MIN ||
-      param->sched_priority > SCHED_PRIORITY_MAX)
+  if (priority < SCHED_PRIORITY_MIN || priority > SCHED_PRIORITY_MAX)
     {
       return -EINVAL;
     }
@@ -129,6 +145,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+  oldpolicy   = tcb->flags & TCB_FLAG_POLICY_MASK;
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -138,16 +155,26 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #ifdef CONFIG_SCHED_SPORADIC
           /* Cancel any on-going sporadic scheduling */
 
-          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC)
+          if (oldpolicy == TCB_FLAG_SCHED_SPORADIC)
             {
               DEBUGVERIFY(nxsched_stop_sporadic(tcb));
             }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+          /* Cancel any on-going deadline scheduling */
+
+          if (oldpolicy == TCB_FLAG_SCHED_DEADLINE)
+            {
+              DEBUGVERIFY(nxsched_stop_deadline(tcb));
+            }
+#endif
+
           /* Save the FIFO scheduling parameters */
 
           tcb->flags     |= TCB_FLAG_SCHED_FIFO;
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
           tcb->timeslice  = 0;
 #endif
         }
@@ -160,12 +187,21 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #ifdef CONFIG_SCHED_SPORADIC
           /* Cancel any on-going sporadic scheduling */
 
-          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC)
+          if (oldpolicy == TCB_FLAG_SCHED_SPORADIC)
             {
               DEBUGVERIFY(nxsched_stop_sporadic(tcb));
             }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+          /* Cancel any on-going deadline scheduling */
+
+          if (oldpolicy == TCB_FLAG_SCHED_DEADLINE)
+            {
+              DEBUGVERIFY(nxsched_stop_deadline(tcb));
+            }
+#endif
+
           /* Save the round robin scheduling parameters */
 
           tcb->flags     |= TCB_FLAG_SCHED_RR;
@@ -225,7 +261,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 
           /* Initialize/reset current sporadic scheduling */
 
-          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC)
+          if (oldpolicy == TCB_FLAG_SCHED_SPORADIC)
             {
               ret = nxsched_reset_sporadic(tcb);
             }
@@ -238,6 +274,15 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 
           if (ret >= 0)
             {
+#ifdef CONFIG_SCHED_DEADLINE
+              /* Cancel any on-going deadline scheduling */
+
+              if (oldpolicy == TCB_FLAG_SCHED_DEADLINE)
+                {
+                  DEBUGVERIFY(nxsched_stop_deadline(tcb));
+                }
+#endif
+
               tcb->flags            |= TCB_FLAG_SCHED_SPORADIC;
               tcb->timeslice         = budget_ticks;
 
@@ -264,18 +309,53 @@ int nxsched_set_scheduler(pid_t pid, int policy,
         }
         break;
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          /* Admit the thread with its new parameters and start its first
+           * period.
+           */
+
+          ret = nxsched_start_deadline(tcb, param);
+          if (ret < 0)
+            {
+              goto errout_with_irq;
+            }
+
+#ifdef CONFIG_SCHED_SPORADIC
+          /* Cancel any on-going sporadic scheduling */
+
+          if (oldpolicy == TCB_FLAG_SCHED_SPORADIC)
+            {
+              DEBUGVERIFY(nxsched_stop_sporadic(tcb));
+            }
+#endif
+
+          tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+        }
+        break;
+#endif
     }
 
   leave_critical_section(flags);
 
   /* Set the new priority */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
+
+  /* Keep the old policy if the new one could not be set up */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FIFO)
+    {
+      tcb->flags |= oldpolicy;
+    }
+
   leave_critical_section(flags);
   sched_unlock();
   return ret;
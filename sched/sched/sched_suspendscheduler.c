@@ -70,9 +70,15 @@ void nxsched_suspend_scheduler(FAR struct tcb_s *tcb)
 
   /* Indicate that the task has been suspended */
 
+#ifdef CONFIG_SCHED_PMU
+  nxsched_suspend_pmu(tcb);
+#endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_suspend_critmon(tcb);
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+  nxsched_suspend_latency(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_suspend(tcb);
 #endif
@@ -95,11 +95,13 @@ uint32_t g_oneshot_maxticks = UINT32_MAX;
  * Private Function Prototypes
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
                                       bool noswitches);
 #endif
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_process_scheduler(uint32_t ticks, bool noswitches);
 #endif
 static unsigned int nxsched_timer_process(unsigned int ticks,
@@ -208,7 +210,8 @@ int up_timer_tick_cancel(FAR clock_t *ticks)
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
                                       bool noswitches)
 {
@@ -217,9 +220,12 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
   uint32_t ret = 0;
 
 #if CONFIG_RR_INTERVAL > 0
-  /* Check if the currently executing task uses round robin scheduling. */
+  /* Check if the currently executing task uses round robin scheduling
+   * and has to share the CPU.
+   */
 
-  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR)
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR &&
+      !nxsched_nohz_cpu(cpu, rtcb))
     {
       /* Yes, check if the currently executing task has exceeded its
        * timeslice.
@@ -255,6 +261,17 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, charge the elapsed time to its budget */
+
+      ret = nxsched_process_deadline(rtcb, ticks, noswitches);
+    }
+#endif
+
   /* If a context switch occurred, then need to return delay remaining for
    * the new task at the head of the ready to run list.
    */
@@ -309,7 +326,8 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_process_scheduler(uint32_t ticks, bool noswitches)
 {
 #ifdef CONFIG_SMP
@@ -443,8 +461,9 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
 
   tmp = nxsched_process_scheduler(ticks, noswitches);
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
-  if (tmp > 0 && tmp < rettime)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
+  if (tmp > 0 && (rettime == 0 || tmp < rettime))
     {
       rettime = tmp;
     }
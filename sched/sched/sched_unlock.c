@@ -197,6 +197,35 @@ int sched_unlock(void)
 
               nxsched_sporadic_lowpriority(rtcb);
 
+#ifdef CONFIG_SCHED_TICKLESS
+              /* Make sure that the call to nxsched_merge_pending() did not
+               * change the currently active task.
+               */
+
+              if (rtcb == current_task(cpu))
+                {
+                  nxsched_reassess_timer();
+                }
+#endif
+            }
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+          else
+#endif
+          /* If (1) the task that was running supported deadline scheduling
+           * and (2) if its budget has already been exhausted, but (3) it
+           * could not be throttled because pre-emption was disabled, then
+           * we need to throttle it now and reassess the interval timer for
+           * its next budget.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE
+              && rtcb->timeslice < 0)
+            {
+              nxsched_deplete_deadline(rtcb);
+
 #ifdef CONFIG_SCHED_TICKLESS
               /* Make sure that the call to nxsched_merge_pending() did not
                * change the currently active task.
@@ -331,6 +360,35 @@ int sched_unlock(void)
 
               nxsched_sporadic_lowpriority(rtcb);
 
+#ifdef CONFIG_SCHED_TICKLESS
+              /* Make sure that the call to nxsched_merge_pending() did not
+               * change the currently active task.
+               */
+
+              if (rtcb == this_task())
+                {
+                  nxsched_reassess_timer();
+                }
+#endif
+            }
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+          else
+#endif
+          /* If (1) the task that was running supported deadline scheduling
+           * and (2) if its budget has already been exhausted, but (3) it
+           * could not be throttled because pre-emption was disabled, then
+           * we need to throttle it now and reassess the interval timer for
+           * its next budget.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE
+              && rtcb->timeslice < 0)
+            {
+              nxsched_deplete_deadline(rtcb);
+
 #ifdef CONFIG_SCHED_TICKLESS
               /* Make sure that the call to nxsched_merge_pending() did not
                * change the currently active task.
@@ -0,0 +1,355 @@
+/****************************************************************************
+ * sched/semaphore/lockstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/lockstat.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK
+/* Spinlocks have no room for a class pointer; bound spinlocks are found
+ * through a hash of their address instead.  Slots are never freed, so the
+ * lookup does not need a lock.
+ */
+
+struct lockstat_spin_s
+{
+  FAR volatile spinlock_t *lock;  /* Bound spinlock, NULL if free */
+  FAR struct lockstat_s *stat;    /* Class of the spinlock */
+  volatile pid_t holder;          /* Thread that took it last */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct lockstat_s g_lockstat[CONFIG_SCHED_LOCKSTAT_NCLASSES];
+
+#ifdef CONFIG_SPINLOCK
+static struct lockstat_spin_s
+  g_lockstat_spin[CONFIG_SCHED_LOCKSTAT_NSPINLOCKS];
+#endif
+
+/* Protects registration.  Only taken through the _wo_note interfaces,
+ * which are not instrumented.
+ */
+
+static spinlock_t g_lockstat_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_class
+ *
+ * Description:
+ *   Find the class called name, registering it if needed.
+ *
+ * Assumptions:
+ *   g_lockstat_lock is held.
+ *
+ ****************************************************************************/
+
+static FAR struct lockstat_s *lockstat_class(FAR const char *name)
+{
+  FAR struct lockstat_s *stat;
+
+  for (stat = g_lockstat;
+       stat < g_lockstat + CONFIG_SCHED_LOCKSTAT_NCLASSES;
+       stat++)
+    {
+      if (stat->name == NULL)
+        {
+          stat->name = name;
+          return stat;
+        }
+
+      if (strcmp(stat->name, name) == 0)
+        {
+          return stat;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lockstat_record
+ *
+ * Description:
+ *   Count one acquisition of a lock of the class on this CPU, or only the
+ *   wait for it if the acquisition was counted already.
+ *
+ ****************************************************************************/
+
+static void lockstat_record(FAR struct lockstat_s *stat, clock_t start,
+                            pid_t holder, bool acquired)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  irqstate_t flags;
+  clock_t wait;
+
+  flags = up_irq_save();
+
+  cpu = &stat->cpu[this_cpu()];
+  if (acquired)
+    {
+      cpu->acquired++;
+    }
+
+  if (start != 0)
+    {
+      wait = perf_gettime() - start;
+
+      cpu->contended++;
+      cpu->waittime += wait;
+
+      if (wait > cpu->maxwait)
+        {
+          cpu->maxwait   = wait;
+          cpu->maxholder = holder;
+        }
+    }
+
+  up_irq_restore(flags);
+}
+
+#ifdef CONFIG_SPINLOCK
+/****************************************************************************
+ * Name: lockstat_spin_find
+ ****************************************************************************/
+
+static FAR struct lockstat_spin_s *
+lockstat_spin_find(FAR volatile spinlock_t *lock, bool alloc)
+{
+  FAR struct lockstat_spin_s *entry;
+  uintptr_t index = (uintptr_t)lock / sizeof(spinlock_t);
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_LOCKSTAT_NSPINLOCKS; i++, index++)
+    {
+      entry = &g_lockstat_spin[index % CONFIG_SCHED_LOCKSTAT_NSPINLOCKS];
+      if (entry->lock == lock)
+        {
+          return entry;
+        }
+
+      if (entry->lock == NULL)
+        {
+          return alloc ? entry : NULL;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_bind_sem
+ ****************************************************************************/
+
+int lockstat_bind_sem(FAR sem_t *sem, FAR const char *name)
+{
+  FAR struct lockstat_s *stat;
+  irqstate_t flags;
+
+  DEBUGASSERT(sem != NULL && name != NULL);
+
+  flags = spin_lock_irqsave_wo_note(&g_lockstat_lock);
+
+  stat = lockstat_class(name);
+  if (stat != NULL)
+    {
+      sem->lockstat = stat;
+    }
+
+  spin_unlock_irqrestore_wo_note(&g_lockstat_lock, flags);
+  return stat != NULL ? OK : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: lockstat_bind_spin
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK
+int lockstat_bind_spin(FAR volatile spinlock_t *lock, FAR const char *name)
+{
+  FAR struct lockstat_spin_s *entry;
+  FAR struct lockstat_s *stat;
+  irqstate_t flags;
+  int ret = -ENOMEM;
+
+  DEBUGASSERT(lock != NULL && name != NULL);
+
+  flags = spin_lock_irqsave_wo_note(&g_lockstat_lock);
+
+  stat  = lockstat_class(name);
+  entry = lockstat_spin_find(lock, true);
+  if (stat != NULL && entry != NULL)
+    {
+      /* Publish the class before the lock pointer that the lock-free
+       * lookup matches on.
+       */
+
+      entry->stat   = stat;
+      entry->holder = INVALID_PROCESS_ID;
+      SP_DMB();
+      entry->lock   = lock;
+      ret           = OK;
+    }
+
+  spin_unlock_irqrestore_wo_note(&g_lockstat_lock, flags);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: lockstat_sem_contend
+ ****************************************************************************/
+
+pid_t lockstat_sem_contend(FAR sem_t *sem)
+{
+  /* Only a mutex knows its holder */
+
+  if (sem->lockstat != NULL && (sem->flags & SEM_TYPE_MUTEX) != 0)
+    {
+      return ((FAR mutex_t *)sem)->holder;
+    }
+
+  return INVALID_PROCESS_ID;
+}
+
+/****************************************************************************
+ * Name: lockstat_sem_acquired
+ ****************************************************************************/
+
+void lockstat_sem_acquired(FAR sem_t *sem, clock_t start, pid_t holder)
+{
+  if (sem->lockstat != NULL)
+    {
+      lockstat_record(sem->lockstat, start, holder, true);
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_sem_spun
+ ****************************************************************************/
+
+void lockstat_sem_spun(FAR sem_t *sem, clock_t start, pid_t holder)
+{
+  if (sem->lockstat != NULL)
+    {
+      lockstat_record(sem->lockstat, start, holder, false);
+    }
+}
+
+#ifdef CONFIG_SPINLOCK
+/****************************************************************************
+ * Name: lockstat_spin_contend
+ ****************************************************************************/
+
+pid_t lockstat_spin_contend(FAR volatile spinlock_t *lock)
+{
+  FAR struct lockstat_spin_s *entry = lockstat_spin_find(lock, false);
+
+  return entry != NULL ? entry->holder : INVALID_PROCESS_ID;
+}
+
+/****************************************************************************
+ * Name: lockstat_spin_acquired
+ ****************************************************************************/
+
+void lockstat_spin_acquired(FAR volatile spinlock_t *lock, clock_t start,
+                            pid_t holder)
+{
+  FAR struct lockstat_spin_s *entry = lockstat_spin_find(lock, false);
+
+  if (entry != NULL)
+    {
+      entry->holder = this_task()->pid;
+      lockstat_record(entry->stat, start, holder, true);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: lockstat_foreach
+ ****************************************************************************/
+
+void lockstat_foreach(lockstat_handler_t handler, FAR void *arg)
+{
+  FAR struct lockstat_s *stat;
+
+  /* Classes are never removed, so they can be walked without the lock */
+
+  for (stat = g_lockstat;
+       stat < g_lockstat + CONFIG_SCHED_LOCKSTAT_NCLASSES &&
+       stat->name != NULL;
+       stat++)
+    {
+      handler(stat, arg);
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_reset
+ ****************************************************************************/
+
+void lockstat_reset(void)
+{
+  FAR struct lockstat_s *stat;
+
+  /* Counts taken on other CPUs while clearing may survive the reset */
+
+  for (stat = g_lockstat;
+       stat < g_lockstat + CONFIG_SCHED_LOCKSTAT_NCLASSES;
+       stat++)
+    {
+      memset(stat->cpu, 0, sizeof(stat->cpu));
+    }
+}
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
@@ -32,6 +32,7 @@
 #include <nuttx/init.h>
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/lockstat.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -76,6 +77,15 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
+  /* A semaphore that is not available is seen so without any lock, which
+   * keeps the callers polling it off the critical section.
+   */
+
+  if (sem->semcount <= 0)
+    {
+      return -EAGAIN;
+    }
+
   /* The following operations must be performed with interrupts disabled
    * because sem_post() may be called from an interrupt handler.
    */
@@ -92,6 +102,10 @@ int nxsem_trywait(FAR sem_t *sem)
       nxsem_add_holder(sem);
       rtcb->waitobj = NULL;
       ret = OK;
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+      lockstat_sem_acquired(sem, 0, INVALID_PROCESS_ID);
+#endif
     }
   else
     {
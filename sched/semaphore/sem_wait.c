@@ -32,6 +32,8 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/lockstat.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -73,6 +75,10 @@ int nxsem_wait(FAR sem_t *sem)
   FAR struct tcb_s *rtcb = this_task();
   irqstate_t flags;
   bool switch_needed;
+#ifdef CONFIG_SCHED_LOCKSTAT
+  clock_t waitstart;
+  pid_t waitholder;
+#endif
   int ret;
 
   /* This API should not be called from interrupt handlers & idleloop */
@@ -99,6 +105,10 @@ int nxsem_wait(FAR sem_t *sem)
       nxsem_add_holder(sem);
       rtcb->waitobj = NULL;
       ret = OK;
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+      lockstat_sem_acquired(sem, 0, INVALID_PROCESS_ID);
+#endif
     }
 
   /* The semaphore is NOT available, We will have to block the
@@ -117,6 +127,13 @@ int nxsem_wait(FAR sem_t *sem)
 
       DEBUGASSERT(rtcb->waitobj == NULL);
 
+#ifdef CONFIG_SCHED_LOCKSTAT
+      /* Note who we are waiting for before the holder changes */
+
+      waitholder = lockstat_sem_contend(sem);
+      waitstart  = perf_gettime();
+#endif
+
       /* Handle the POSIX semaphore (but don't set the owner yet) */
 
       sem->semcount--;
@@ -208,6 +225,13 @@ int nxsem_wait(FAR sem_t *sem)
 
       ret = rtcb->errcode != OK ? -rtcb->errcode : OK;
 
+#ifdef CONFIG_SCHED_LOCKSTAT
+      if (ret == OK)
+        {
+          lockstat_sem_acquired(sem, waitstart, waitholder);
+        }
+#endif
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
       if (prioinherit != 0)
         {
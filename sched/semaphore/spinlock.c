@@ -28,11 +28,14 @@
 #include <sched.h>
 #include <assert.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/lockstat.h>
 #include <arch/irq.h>
 
-#if defined(CONFIG_TICKET_SPINLOCK) || defined(CONFIG_RW_SPINLOCK)
+#if defined(CONFIG_TICKET_SPINLOCK) || defined(CONFIG_RW_SPINLOCK) || \
+    defined(CONFIG_MCS_SPINLOCK)
 #  include <stdatomic.h>
 #endif
 
@@ -69,6 +72,11 @@
 
 void spin_lock(FAR volatile spinlock_t *lock)
 {
+#ifdef CONFIG_SCHED_LOCKSTAT
+  pid_t waitholder = INVALID_PROCESS_ID;
+  clock_t waitstart = 0;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are waiting for a spinlock */
 
@@ -82,6 +90,14 @@ void spin_lock(FAR volatile spinlock_t *lock)
   while (up_testset(lock) == SP_LOCKED)
 #endif
     {
+#ifdef CONFIG_SCHED_LOCKSTAT
+      if (waitstart == 0)
+        {
+          waitholder = lockstat_spin_contend(lock);
+          waitstart  = perf_gettime();
+        }
+#endif
+
       SP_DSB();
       SP_WFE();
     }
@@ -92,6 +108,10 @@ void spin_lock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock, NOTE_SPINLOCK_LOCKED);
 #endif
   SP_DMB();
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_spin_acquired(lock, waitstart, waitholder);
+#endif
 }
 
 /****************************************************************************
@@ -196,6 +216,10 @@ bool spin_trylock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock, NOTE_SPINLOCK_LOCKED);
 #endif
   SP_DMB();
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_spin_acquired(lock, 0, INVALID_PROCESS_ID);
+#endif
   return true;
 }
 
@@ -672,4 +696,129 @@ void write_unlock(FAR volatile rwlock_t *lock)
 }
 
 #endif /* CONFIG_RW_SPINLOCK */
+
+#ifdef CONFIG_MCS_SPINLOCK
+
+/****************************************************************************
+ * Name: mcs_lock
+ *
+ * Description:
+ *   Loop until the queued spinlock is locked.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *   node - The queue node of the caller.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+void mcs_lock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *prev;
+
+  atomic_store(&node->next, NULL);
+  atomic_store(&node->locked, 1);
+
+  /* Join the end of the queue.  The lock is ours at once if it was empty */
+
+  prev = atomic_exchange(&lock->tail, node);
+  if (prev != NULL)
+    {
+      /* Link behind the previous waiter and spin on our own node until it
+       * hands the lock over.
+       */
+
+      atomic_store(&prev->next, node);
+      while (atomic_load(&node->locked) != 0)
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: mcs_trylock
+ *
+ * Description:
+ *   Try once to lock the queued spinlock.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *   node - The queue node of the caller.
+ *
+ * Returned Value:
+ *   true if the spinlock was locked; false if it was already locked.
+ *
+ ****************************************************************************/
+
+bool mcs_trylock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *expected = NULL;
+
+  atomic_store(&node->next, NULL);
+  atomic_store(&node->locked, 0);
+
+  if (atomic_compare_exchange_strong(&lock->tail, &expected, node))
+    {
+      SP_DMB();
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: mcs_unlock
+ *
+ * Description:
+ *   Release the queued spinlock.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to unlock.
+ *   node - The queue node given to mcs_lock() or mcs_trylock().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void mcs_unlock(FAR mcs_lock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *next;
+  FAR struct mcs_node_s *expected;
+
+  SP_DMB();
+
+  next = atomic_load(&node->next);
+  if (next == NULL)
+    {
+      /* No waiter is linked.  Empty the queue, unless one is joining it */
+
+      expected = node;
+      if (atomic_compare_exchange_strong(&lock->tail, &expected, NULL))
+        {
+          return;
+        }
+
+      /* Wait for the joining waiter to link behind us */
+
+      while ((next = atomic_load(&node->next)) == NULL)
+        {
+        }
+    }
+
+  /* Hand the lock over to the next waiter */
+
+  atomic_store(&next->locked, 0);
+  SP_DSB();
+  SP_SEV();
+}
+
+#endif /* CONFIG_MCS_SPINLOCK */
 #endif /* CONFIG_SPINLOCK */
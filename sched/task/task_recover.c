@@ -92,4 +92,17 @@ void nxtask_recover(FAR struct tcb_s *tcb)
       DEBUGVERIFY(nxsched_stop_sporadic(tcb));
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Stop deadline scheduling and give back its bandwidth.  The thread
+       * may still be compared with others until it is gone, so it must no
+       * longer look like a deadline thread.
+       */
+
+      DEBUGVERIFY(nxsched_stop_deadline(tcb));
+      tcb->flags &= ~TCB_FLAG_POLICY_MASK;
+    }
+#endif
 }
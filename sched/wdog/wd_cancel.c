@@ -35,104 +35,232 @@
 #include "sched/sched.h"
 #include "wdog/wdog.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_running_elsewhere
+ *
+ * Description:
+ *   Check if the function of the watchdog is running on another CPU.  The
+ *   caller holds wd_lock().
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SCHED_TICKLESS
+static bool wd_running_elsewhere(FAR struct wdog_s *wdog)
+{
+  int me = this_cpu();
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (cpu != me && g_wdrunning[cpu].wdog == wdog &&
+          g_wdrunning[cpu].started)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: wd_cancel
+ * Name: wd_cancel_locked
  *
  * Description:
- *   This function cancels a currently running watchdog timer. Watchdog
- *   timers may be canceled from the interrupt level.
+ *   Remove an active watchdog from the list, or drop the call of its
+ *   function if it has just expired and the call has not started yet.  The
+ *   caller holds wd_lock().
  *
  * Input Parameters:
  *   wdog - ID of the watchdog to cancel.
  *
  * Returned Value:
  *   Zero (OK) is returned on success;  A negated errno value is returned to
- *   indicate the nature of any failure.
+ *   indicate the nature of any failure:  -EBUSY if the function has been
+ *   called already and may still be running, -EINVAL if the watchdog is not
+ *   active.
  *
  ****************************************************************************/
 
-int wd_cancel(FAR struct wdog_s *wdog)
+int wd_cancel_locked(FAR struct wdog_s *wdog)
 {
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
-  irqstate_t flags;
-  int ret = -EINVAL;
-
-  /* Prohibit timer interactions with the timer queue until the
-   * cancellation is complete
-   */
-
-  flags = enter_critical_section();
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
    */
 
-  if (wdog != NULL && WDOG_ISACTIVE(wdog))
+  if (wdog == NULL)
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
-       */
+      return -EINVAL;
+    }
 
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
+  if (!WDOG_ISACTIVE(wdog))
+    {
+#ifndef CONFIG_SCHED_TICKLESS
+      int cpu;
 
-      while ((curr) && (curr != wdog))
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
         {
-          prev = curr;
-          curr = curr->next;
+          if (g_wdrunning[cpu].wdog == wdog)
+            {
+              if (g_wdrunning[cpu].started)
+                {
+                  return -EBUSY;
+                }
+
+              g_wdrunning[cpu].wdog = NULL;
+              return OK;
+            }
         }
+#endif
 
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
+      return -EINVAL;
+    }
+
+  /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
+   * to do this because there are additional operations that need to be
+   * done.
+   */
+
+  prev = NULL;
+  curr = (FAR struct wdog_s *)g_wdactivelist.head;
+
+  while ((curr) && (curr != wdog))
+    {
+      prev = curr;
+      curr = curr->next;
+    }
+
+  /* Check if the watchdog was found in the list.  If not, then an OS
+   * error has occurred because the watchdog is marked active!
+   */
 
-      DEBUGASSERT(curr);
+  DEBUGASSERT(curr);
 
-      /* If there is a watchdog in the timer queue after the one that
-       * is being canceled, then it inherits the remaining ticks.
+  /* If there is a watchdog in the timer queue after the one that
+   * is being canceled, then it inherits the remaining ticks.
+   */
+
+  if (curr->next)
+    {
+      curr->next->lag += curr->lag;
+    }
+
+  /* Now, remove the watchdog from the timer queue */
+
+  if (prev)
+    {
+      /* Remove the watchdog from mid- or end-of-queue */
+
+      sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
+    }
+  else
+    {
+      /* Remove the watchdog at the head of the queue */
+
+      sq_remfirst(&g_wdactivelist);
+
+      /* Reassess the interval timer that will generate the next
+       * interval event.
        */
 
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
+      nxsched_reassess_timer();
+    }
 
-      /* Now, remove the watchdog from the timer queue */
+  /* Mark the watchdog inactive */
 
-      if (prev)
-        {
-          /* Remove the watchdog from mid- or end-of-queue */
+  wdog->func = NULL;
 
-          sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
-        {
-          /* Remove the watchdog at the head of the queue */
+  /* Return success */
 
-          sq_remfirst(&g_wdactivelist);
+  return OK;
+}
 
-          /* Reassess the interval timer that will generate the next
-           * interval event.
-           */
+/****************************************************************************
+ * Name: wd_cancel
+ *
+ * Description:
+ *   This function cancels a currently running watchdog timer. Watchdog
+ *   timers may be canceled from the interrupt level.
+ *
+ *   The function of a watchdog that has just expired is never still
+ *   running on another CPU when this returns.  The function is called in
+ *   the critical section, so it has not started yet if the caller holds
+ *   the critical section; the caller must not hold any other lock that the
+ *   function takes.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
 
-          nxsched_reassess_timer();
-        }
+int wd_cancel(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  int ret;
 
-      /* Mark the watchdog inactive */
+  /* Prohibit timer interactions with the timer queue until the
+   * cancellation is complete
+   */
 
-      wdog->func = NULL;
+  flags = wd_lock();
+  ret   = wd_cancel_locked(wdog);
 
-      /* Return success */
+#ifndef CONFIG_SCHED_TICKLESS
+  /* Wait for the function if it runs on another CPU */
 
-      ret = OK;
+  while (wd_running_elsewhere(wdog))
+    {
+      wd_unlock(flags);
+      SP_DSB();
+      flags = wd_lock();
     }
+#endif
+
+  wd_unlock(flags);
+  return ret == -EBUSY ? -EINVAL : ret;
+}
+
+/****************************************************************************
+ * Name: wd_trycancel
+ *
+ * Description:
+ *   Cancel a watchdog as wd_cancel() does, but without waiting for its
+ *   function if that has been called already.  For the callers that hold a
+ *   lock which the function takes.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   Zero (OK) if the function will not be called; -EBUSY if the function
+ *   has been called already and may still be running; -EINVAL if the
+ *   watchdog is not active.
+ *
+ ****************************************************************************/
+
+int wd_trycancel(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  int ret;
+
+  flags = wd_lock();
+  ret   = wd_cancel_locked(wdog);
+  wd_unlock(flags);
 
-  leave_critical_section(flags);
   return ret;
 }
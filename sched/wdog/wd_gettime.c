@@ -56,7 +56,7 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
       /* Traverse the watchdog list accumulating lag times until we find the
@@ -74,12 +74,12 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
           if (curr == wdog)
             {
               delay -= wd_elapse();
-              leave_critical_section(flags);
+              wd_unlock(flags);
               return delay;
             }
         }
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return 0;
 }
@@ -39,6 +39,16 @@
 
 sq_queue_t g_wdactivelist;
 
+/* Protects g_wdactivelist in the tick-based builds */
+
+#ifndef CONFIG_SCHED_TICKLESS
+spinlock_t g_wdspinlock = SP_UNLOCKED;
+
+/* The expired watchdogs per CPU */
+
+struct wd_running_s g_wdrunning[CONFIG_SMP_NCPUS];
+#endif
+
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
  */
@@ -80,18 +80,29 @@
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run. If so, remove the watchdog from the list and execute it.
  *
+ *   The watchdog functions run in the critical section.  When wd_lock()
+ *   is a spinlock, it is released while each function runs, so that it
+ *   may start or cancel watchdogs, and the watchdog is recorded in
+ *   g_wdrunning meanwhile:  wd_cancel() drops the call if it has not
+ *   started yet, or else waits for the function to return.
+ *
  * Input Parameters:
- *   None
+ *   flags - The interrupt state returned by wd_lock()
  *
  * Returned Value:
- *   None
+ *   The interrupt state returned by wd_lock() when it is taken again
  *
  ****************************************************************************/
 
-static inline void wd_expiration(void)
+static inline irqstate_t wd_expiration(irqstate_t flags)
 {
+#ifndef CONFIG_SCHED_TICKLESS
+  FAR struct wd_running_s *running = &g_wdrunning[this_cpu()];
+  irqstate_t csflags;
+#endif
   FAR struct wdog_s *wdog;
   wdentry_t func;
+  wdparm_t arg;
 
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
@@ -120,9 +131,40 @@ static inline void wd_expiration(void)
 
       /* Execute the watchdog function */
 
+      arg = wdog->arg;
       up_setpicbase(wdog->picbase);
-      CALL_FUNC(func, wdog->arg);
+#ifdef CONFIG_SCHED_TICKLESS
+      CALL_FUNC(func, arg);
+#else
+      running->wdog    = wdog;
+      running->started = false;
+      wd_unlock(flags);
+
+      /* Take the critical section in the lock order, and call the function
+       * unless the watchdog was cancelled or restarted meanwhile.
+       */
+
+      csflags = enter_critical_section();
+      flags   = wd_lock();
+
+      if (running->wdog == wdog)
+        {
+          running->started = true;
+          wd_unlock(flags);
+
+          CALL_FUNC(func, arg);
+
+          flags = wd_lock();
+        }
+
+      running->wdog = NULL;
+      wd_unlock(flags);
+      leave_critical_section(csflags);
+      flags = wd_lock();
+#endif
     }
+
+  return flags;
 }
 
 /****************************************************************************
@@ -184,14 +226,16 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Check if the watchdog has been started. If so, stop it.
    * NOTE:  There is a race condition here... the caller may receive
    * the watchdog between the time that wd_start is called and
-   * the critical section is established.
+   * the lock is taken.
    */
 
-  flags = enter_critical_section();
-  if (WDOG_ISACTIVE(wdog))
-    {
-      wd_cancel(wdog);
-    }
+  flags = wd_lock();
+
+  /* This also drops a call of the function that is still pending, -EINVAL
+   * only means that there was nothing to cancel.
+   */
+
+  wd_cancel_locked(wdog);
 
   /* Save the data in the watchdog structure */
 
@@ -336,7 +380,7 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_resume_timer();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
@@ -370,9 +414,12 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 unsigned int wd_timer(int ticks, bool noswitches)
 {
   FAR struct wdog_s *wdog;
+  irqstate_t flags;
   unsigned int ret;
   int decr;
 
+  flags = wd_lock();
+
   /* Update clock tickbase */
 
   g_wdtickbase += ticks;
@@ -398,7 +445,7 @@ unsigned int wd_timer(int ticks, bool noswitches)
 
   if (!noswitches)
     {
-      wd_expiration();
+      flags = wd_expiration(flags);
     }
 
   /* Return the delay for the next watchdog to expire */
@@ -406,6 +453,8 @@ unsigned int wd_timer(int ticks, bool noswitches)
   ret = g_wdactivelist.head ?
         MAX(((FAR struct wdog_s *)g_wdactivelist.head)->lag, 1) : 0;
 
+  wd_unlock(flags);
+
   /* Return the delay for the next watchdog to expire */
 
   return ret;
@@ -414,6 +463,10 @@ unsigned int wd_timer(int ticks, bool noswitches)
 #else
 void wd_timer(void)
 {
+  irqstate_t flags;
+
+  flags = wd_lock();
+
   /* Check if there are any active watchdogs to process */
 
   if (g_wdactivelist.head)
@@ -424,7 +477,9 @@ void wd_timer(void)
 
       /* Check if the watchdog at the head of the list is ready to run */
 
-      wd_expiration();
+      flags = wd_expiration(flags);
     }
+
+  wd_unlock(flags);
 }
 #endif /* CONFIG_SCHED_TICKLESS */
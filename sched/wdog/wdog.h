@@ -32,7 +32,9 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 
 /****************************************************************************
@@ -56,6 +58,39 @@
 #  define wd_elapse() (0)
 #endif
 
+/* The list of active watchdogs is protected by its own spinlock, so that
+ * the timer tick and the CPUs starting or cancelling watchdogs do not
+ * serialize on the critical section.  Only the watchdog functions still
+ * run in the critical section, since many of them expect to.  The tickless
+ * timer is reprogrammed along with the list, and the state of that timer
+ * is protected by the critical section, so the tickless builds still use
+ * it for the list as well.
+ */
+
+#ifdef CONFIG_SCHED_TICKLESS
+#  define wd_lock()         enter_critical_section()
+#  define wd_unlock(flags)  leave_critical_section(flags)
+#else
+#  define wd_lock()         spin_lock_irqsave(&g_wdspinlock)
+#  define wd_unlock(flags)  spin_unlock_irqrestore(&g_wdspinlock, flags)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The watchdog whose function a CPU is about to call or is calling, see
+ * wd_cancel().  The call is started only in the critical section.
+ */
+
+#ifndef CONFIG_SCHED_TICKLESS
+struct wd_running_s
+{
+  FAR struct wdog_s *wdog;        /* Expired watchdog, NULL if none */
+  bool started;                   /* Its function has been called */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -75,6 +110,16 @@ extern "C"
 
 extern sq_queue_t g_wdactivelist;
 
+/* Protects g_wdactivelist, see wd_lock() */
+
+#ifndef CONFIG_SCHED_TICKLESS
+extern spinlock_t g_wdspinlock;
+
+/* The expired watchdogs per CPU, protected by g_wdspinlock */
+
+extern struct wd_running_s g_wdrunning[CONFIG_SMP_NCPUS];
+#endif
+
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
  */
@@ -119,6 +164,50 @@ unsigned int wd_timer(int ticks, bool noswitches);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_cancel_locked
+ *
+ * Description:
+ *   Remove an active watchdog from the list, or drop the call of its
+ *   function if it has just expired and the call has not started yet.
+ *   Unlike wd_cancel(), this does not wait for a function that is running.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure:  -EBUSY if the function has been
+ *   called already and may still be running, -EINVAL if the watchdog is not
+ *   active.
+ *
+ * Assumptions:
+ *   The caller holds wd_lock().
+ *
+ ****************************************************************************/
+
+int wd_cancel_locked(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_trycancel
+ *
+ * Description:
+ *   Cancel a watchdog as wd_cancel() does, but without waiting for its
+ *   function if that has been called already.  For the callers that hold a
+ *   lock which the function takes.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   Zero (OK) if the function will not be called; -EBUSY if the function
+ *   has been called already and may still be running; -EINVAL if the
+ *   watchdog is not active.
+ *
+ ****************************************************************************/
+
+int wd_trycancel(FAR struct wdog_s *wdog);
+
 /****************************************************************************
  * Name: wd_recover
  *
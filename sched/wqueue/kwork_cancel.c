@@ -32,6 +32,7 @@
 #include <nuttx/queue.h>
 #include <nuttx/wqueue.h>
 
+#include "wdog/wdog.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -67,6 +68,8 @@
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
                         FAR struct work_s *work)
 {
+  FAR struct kworker_s *kworker;
+  irqstate_t cflags;
   irqstate_t flags;
   int ret = -ENOENT;
 
@@ -77,22 +80,15 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
    * new work is typically added to the work queue from interrupt handlers.
    */
 
-  flags = enter_critical_section();
+  cflags = work_timer_lock();
+  flags  = spin_lock_irqsave(&wqueue->lock);
   if (work->worker != NULL)
     {
       /* Remove the entry from the work queue and make sure that it is
        * marked as available (i.e., the worker field is nullified).
        */
 
-      if (WDOG_ISACTIVE(&work->u.timer))
-        {
-          wd_cancel(&work->u.timer);
-        }
-      else
-        {
-          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
-        }
-
+      work_qremove(wqueue, work);
       work->worker = NULL;
       ret = OK;
     }
@@ -102,17 +98,22 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
 
       for (wndx = 0; wndx < nthread; wndx++)
         {
-          if (wqueue->worker[wndx].work == work &&
-              wqueue->worker[wndx].pid != nxsched_gettid())
+          kworker = &wqueue->worker[wndx];
+          if (kworker->work == work && kworker->pid != nxsched_gettid())
             {
-              nxsem_wait_uninterruptible(&wqueue->worker[wndx].wait);
-              ret = OK;
-              break;
+              /* Wait for the thread to be done with the work */
+
+              kworker->nwait++;
+              spin_unlock_irqrestore(&wqueue->lock, flags);
+              nxsem_wait_uninterruptible(&kworker->wait);
+              work_timer_unlock(cflags);
+              return OK;
             }
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+  work_timer_unlock(cflags);
   return ret;
 }
 
@@ -120,6 +121,46 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qremove
+ *
+ * Description:
+ *   Stop the timer of the work or remove it from the queue.  If the
+ *   function of its expired timer has been called already, that function
+ *   may still be waiting for the lock of the queue:  It does not queue the
+ *   work if the work was cancelled, queued or given a new timer meanwhile.
+ *
+ * Assumptions:
+ *   The caller holds the lock of the work queue, and the worker of the work
+ *   is not NULL.
+ *
+ ****************************************************************************/
+
+void work_qremove(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work)
+{
+  int ret;
+
+  /* The timer is not waited for, since its function takes the lock of the
+   * queue, which the caller holds.
+   */
+
+  ret = wd_trycancel(&work->u.timer);
+  if (ret == OK)
+    {
+      return;
+    }
+
+  /* Either the work is in the queue, or the function of its timer has
+   * been called and may or may not have queued it yet.
+   */
+
+  if (ret == -EINVAL || work_isqueued(wqueue, work))
+    {
+      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+    }
+}
+
 /****************************************************************************
  * Name: work_cancel
  *
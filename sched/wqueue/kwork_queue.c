@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -39,26 +40,65 @@
 #ifdef CONFIG_SCHED_WORKQUEUE
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: queue_work
+ *
+ * Description:
+ *   Add the work to the end of the queue.  The lock of the queue must be
+ *   held.  Returns true if an idle thread is to be woken up by posting the
+ *   semaphore, once the lock is released.
+ *
  ****************************************************************************/
 
-#define queue_work(wqueue, work) \
-  do \
-    { \
-      int sem_count; \
-      dq_addlast((FAR dq_entry_t *)(work), &(wqueue).q); \
-      nxsem_get_value(&(wqueue).sem, &sem_count); \
-      if (sem_count < 0) /* There are threads waiting for sem. */ \
-        { \
-          nxsem_post(&(wqueue).sem); \
-        } \
-    } \
-  while (0)
+static inline bool queue_work(FAR struct kwork_wqueue_s *wqueue,
+                              FAR struct work_s *work)
+{
+  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+
+  if (wqueue->nwait > 0)
+    {
+      wqueue->nwait--;
+      return true;
+    }
+
+  return false;
+}
 
 /****************************************************************************
- * Private Functions
+ * Name: work_timer_expiry
+ *
+ * Description:
+ *   Queue the work whose timer has expired.  The work may have been
+ *   cancelled, queued or given a new timer while this was waiting for the
+ *   lock, see work_qremove().
+ *
  ****************************************************************************/
 
+static void work_timer_expiry(FAR struct kwork_wqueue_s *wqueue,
+                              FAR struct work_s *work)
+{
+  irqstate_t flags;
+  bool wake = false;
+
+  flags = spin_lock_irqsave(&wqueue->lock);
+
+  if (work->worker != NULL && !WDOG_ISACTIVE(&work->u.timer) &&
+      !work_isqueued(wqueue, work))
+    {
+      wake = queue_work(wqueue, work);
+    }
+
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+
+  if (wake)
+    {
+      nxsem_post(&wqueue->sem);
+    }
+}
+
 /****************************************************************************
  * Name: hp_work_timer_expiry
  ****************************************************************************/
@@ -66,9 +106,8 @@
 #ifdef CONFIG_SCHED_HPWORK
 static void hp_work_timer_expiry(wdparm_t arg)
 {
-  irqstate_t flags = enter_critical_section();
-  queue_work(g_hpwork, arg);
-  leave_critical_section(flags);
+  work_timer_expiry((FAR struct kwork_wqueue_s *)&g_hpwork,
+                    (FAR struct work_s *)arg);
 }
 #endif
 
@@ -79,9 +118,8 @@ static void hp_work_timer_expiry(wdparm_t arg)
 #ifdef CONFIG_SCHED_LPWORK
 static void lp_work_timer_expiry(wdparm_t arg)
 {
-  irqstate_t flags = enter_critical_section();
-  queue_work(g_lpwork, arg);
-  leave_critical_section(flags);
+  work_timer_expiry((FAR struct kwork_wqueue_s *)&g_lpwork,
+                    (FAR struct work_s *)arg);
 }
 #endif
 
@@ -122,20 +160,71 @@ static void lp_work_timer_expiry(wdparm_t arg)
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
+  FAR struct kwork_wqueue_s *wqueue;
+  wdentry_t expiry;
+  irqstate_t cflags;
   irqstate_t flags;
-  int ret = OK;
+  bool wake = false;
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork;
+      expiry = hp_work_timer_expiry;
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      wqueue = (FAR struct kwork_wqueue_s *)&g_lpwork;
+      expiry = lp_work_timer_expiry;
+    }
+  else
+#endif
+    {
+      return -EINVAL;
+    }
 
   /* Interrupts are disabled so that this logic can be called from with
-   * task logic or from interrupt handling logic.
+   * task logic or from interrupt handling logic.  Work that is to be
+   * performed immediately and is not queued yet only needs the lock of
+   * the work queue.
    */
 
-  flags = enter_critical_section();
+  if (!delay)
+    {
+      flags = spin_lock_irqsave(&wqueue->lock);
+      if (work->worker == NULL)
+        {
+          work->worker = worker;   /* Work callback. non-NULL means queued */
+          work->arg    = arg;      /* Callback argument */
+          wake         = queue_work(wqueue, work);
+          spin_unlock_irqrestore(&wqueue->lock, flags);
+
+          if (wake)
+            {
+              nxsem_post(&wqueue->sem);
+            }
+
+          return OK;
+        }
+
+      spin_unlock_irqrestore(&wqueue->lock, flags);
+    }
+
+  /* Otherwise the work may have to be removed from the timer and work
+   * queue, or a timer started.
+   */
+
+  cflags = work_timer_lock();
+  flags  = spin_lock_irqsave(&wqueue->lock);
 
   /* Remove the entry from the timer and work queue. */
 
   if (work->worker != NULL)
     {
-      work_cancel(qid, work);
+      work_qremove(wqueue, work);
     }
 
   /* Initialize the work structure. */
@@ -145,47 +234,24 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
   /* Queue the new work */
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
+  if (!delay)
     {
-      /* Queue high priority work */
-
-      if (!delay)
-        {
-          queue_work(g_hpwork, work);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, hp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
+      wake = queue_work(wqueue, work);
     }
   else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
     {
-      /* Queue low priority work */
-
-      if (!delay)
-        {
-          queue_work(g_lpwork, work);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, lp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
+      wd_start(&work->u.timer, delay, expiry, (wdparm_t)work);
     }
-  else
-#endif
+
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+
+  if (wake)
     {
-      ret = -EINVAL;
+      nxsem_post(&wqueue->sem);
     }
 
-  leave_critical_section(flags);
-
-  return ret;
+  work_timer_unlock(cflags);
+  return OK;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -82,6 +82,7 @@ struct hp_wqueue_s g_hpwork =
 {
   {NULL, NULL},
   SEM_INITIALIZER(0),
+  SP_UNLOCKED,
 };
 
 #endif /* CONFIG_SCHED_HPWORK */
@@ -93,6 +94,7 @@ struct lp_wqueue_s g_lpwork =
 {
   {NULL, NULL},
   SEM_INITIALIZER(0),
+  SP_UNLOCKED,
 };
 
 #endif /* CONFIG_SCHED_LPWORK */
@@ -131,7 +133,7 @@ static int work_thread(int argc, FAR char *argv[])
   worker_t worker;
   irqstate_t flags;
   FAR void *arg;
-  int semcount;
+  int nwait;
 
   /* Get the handle from argv */
 
@@ -140,15 +142,16 @@ static int work_thread(int argc, FAR char *argv[])
   kworker = (FAR struct kworker_s *)
             ((uintptr_t)strtoul(argv[2], NULL, 0));
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave(&wqueue->lock);
 
   /* Loop forever */
 
   for (; ; )
     {
-      /* And check each entry in the work queue.  Since we have disabled
-       * interrupts we know:  (1) we will not be suspended unless we do
-       * so ourselves, and (2) there will be no changes to the work queue
+      /* And check each entry in the work queue.  Since we hold the lock of
+       * the work queue with interrupts disabled we know:  (1) we will not
+       * be suspended unless we do so ourselves, and (2) there will be no
+       * changes to the work queue
        */
 
       /* Remove the ready-to-execute work from the list */
@@ -182,9 +185,9 @@ static int work_thread(int argc, FAR char *argv[])
            * performed... we don't have any idea how long this will take!
            */
 
-          leave_critical_section(flags);
+          spin_unlock_irqrestore(&wqueue->lock, flags);
           CALL_WORKER(worker, arg);
-          flags = enter_critical_section();
+          flags = spin_lock_irqsave(&wqueue->lock);
 
           /* Mark the thread un-busy */
 
@@ -192,22 +195,33 @@ static int work_thread(int argc, FAR char *argv[])
 
           /* Check if someone is waiting, if so, wakeup it */
 
-          nxsem_get_value(&kworker->wait, &semcount);
-          while (semcount++ < 0)
+          nwait = kworker->nwait;
+          if (nwait > 0)
             {
-              nxsem_post(&kworker->wait);
+              kworker->nwait = 0;
+              spin_unlock_irqrestore(&wqueue->lock, flags);
+
+              while (nwait-- > 0)
+                {
+                  nxsem_post(&kworker->wait);
+                }
+
+              flags = spin_lock_irqsave(&wqueue->lock);
             }
         }
 
-      /* Then process queued work.  work_process will not return until: (1)
-       * there is no further work in the work queue, and (2) semaphore is
-       * posted.
+      /* Then wait for more work.  Counting this thread as idle in the same
+       * locked section as the check of the queue guarantees that the next
+       * work_queue() posts the semaphore.
        */
 
+      wqueue->nwait++;
+      spin_unlock_irqrestore(&wqueue->lock, flags);
       nxsem_wait_uninterruptible(&wqueue->sem);
+      flags = spin_lock_irqsave(&wqueue->lock);
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore(&wqueue->lock, flags);
 
   return OK; /* To keep some compilers happy */
 }
@@ -31,7 +31,10 @@
 #include <stdbool.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -44,6 +47,20 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* The functions of the expired watchdogs queue the delayed work with the
+ * lock of the work queue.  In the tickless builds they run with the lock
+ * of the watchdog list, the critical section, which then has to be taken
+ * before the lock of the work queue.  Otherwise that lock is enough.
+ */
+
+#ifdef CONFIG_SCHED_TICKLESS
+#  define work_timer_lock()        enter_critical_section()
+#  define work_timer_unlock(flags) leave_critical_section(flags)
+#else
+#  define work_timer_lock()        ((irqstate_t)0)
+#  define work_timer_unlock(flags) UNUSED(flags)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -55,14 +72,20 @@ struct kworker_s
   pid_t             pid;       /* The task ID of the worker thread */
   FAR struct work_s *work;     /* The work structure */
   sem_t             wait;      /* Sync waiting for worker done */
+  int16_t           nwait;     /* The number of threads waiting for done */
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.  The
+ * queue, the count of idle threads and the state of the workers are
+ * protected by the spinlock.
+ */
 
 struct kwork_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  sem_t             sem;       /* Posted to wake up an idle thread */
+  spinlock_t        lock;      /* Protects the work queue */
+  int16_t           nwait;     /* The number of idle threads */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -74,7 +97,9 @@ struct kwork_wqueue_s
 struct hp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  sem_t             sem;       /* Posted to wake up an idle thread */
+  spinlock_t        lock;      /* Protects the work queue */
+  int16_t           nwait;     /* The number of idle threads */
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -90,7 +115,9 @@ struct hp_wqueue_s
 struct lp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
-  sem_t             sem;       /* The counting semaphore of the wqueue */
+  sem_t             sem;       /* Posted to wake up an idle thread */
+  spinlock_t        lock;      /* Protects the work queue */
+  int16_t           nwait;     /* The number of idle threads */
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -114,6 +141,35 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_isqueued
+ *
+ * Description:
+ *   Check if the work is in the queue.  The caller holds the lock of the
+ *   work queue.
+ *
+ ****************************************************************************/
+
+static inline bool work_isqueued(FAR struct kwork_wqueue_s *wqueue,
+                                 FAR struct work_s *work)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&wqueue->q); entry != NULL; entry = dq_next(entry))
+    {
+      if (entry == (FAR dq_entry_t *)work)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -168,5 +224,23 @@ int work_start_lowpri(void);
 void work_initialize_notifier(void);
 #endif
 
+/****************************************************************************
+ * Name: work_qremove
+ *
+ * Description:
+ *   Stop the timer of the work or remove it from the queue.  If the
+ *   function of its expired timer has been called already, that function
+ *   may still be waiting for the lock of the queue:  It does not queue the
+ *   work if the work was cancelled, queued or given a new timer meanwhile.
+ *
+ * Assumptions:
+ *   The caller holds the lock of the work queue, and the worker of the work
+ *   is not NULL.
+ *
+ ****************************************************************************/
+
+void work_qremove(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work);
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
 #endif /* __SCHED_WQUEUE_WQUEUE_H */
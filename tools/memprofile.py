@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+# tools/memprofile.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+
+import argparse
+import bisect
+import re
+import sys
+
+
+def parse_args():
+
+    parser = argparse.ArgumentParser(
+        """
+        memprofile.py [-e ELFFILE] [-s KEY] [-n COUNT] [FILE]\n\
+        This file reports the output of /proc/memprofile (CONFIG_MM_PROFILE):
+        the call sites that allocate most, and the allocation rate and live
+        bytes over time.\n
+        Frames that the target already printed as symbol+offset
+        (CONFIG_ALLSYMS) are used as is; plain addresses are looked up in
+        the ELF file given with -e.
+        """
+    )
+
+    parser.add_argument(
+        "filename",
+        nargs="?",
+        help="saved output of /proc/memprofile, standard input by default",
+    )
+    parser.add_argument(
+        "-e",
+        "--elf",
+        action="store",
+        help="nuttx ELF file used to symbolize plain addresses",
+    )
+    parser.add_argument(
+        "-s",
+        "--sort",
+        choices=["allocs", "bytes", "live"],
+        default="live",
+        help="order of the call sites, live bytes by default",
+    )
+    parser.add_argument(
+        "-n",
+        "--count",
+        type=int,
+        default=20,
+        help="number of call sites reported, 0 for all",
+    )
+    parser.add_argument(
+        "--no-history",
+        action="store_true",
+        help="do not report the allocation rate over time",
+    )
+
+    return parser.parse_args()
+
+
+class Symbols(object):
+    def __init__(self, elffile):
+        self.addrs = []
+        self.names = []
+        self.sizes = []
+
+        if elffile is None:
+            return
+
+        try:
+            from elftools.elf.elffile import ELFFile
+            from elftools.elf.sections import SymbolTableSection
+        except ModuleNotFoundError:
+            print("Please execute the following command to install dependencies:")
+            print("pip install pyelftools")
+            sys.exit(1)
+
+        symbols = []
+        with open(elffile, "rb") as file:
+            elf = ELFFile(file)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                if section.name != ".symtab":
+                    continue
+                for symbol in section.iter_symbols():
+                    if symbol["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    if symbol["st_shndx"] == "SHN_UNDEF":
+                        continue
+                    symbols.append(
+                        (symbol["st_value"] & ~0x01, symbol["st_size"], symbol.name)
+                    )
+
+        for addr, size, name in sorted(symbols):
+            self.addrs.append(addr)
+            self.sizes.append(size)
+            self.names.append(name)
+
+    def lookup(self, addr):
+        index = bisect.bisect_right(self.addrs, addr) - 1
+        if index < 0:
+            return None
+        if self.sizes[index] and addr >= self.addrs[index] + self.sizes[index]:
+            return None
+        return self.names[index]
+
+
+def frame_name(token, symbols):
+
+    # "name+0x12/0x40" when the target resolved the symbol
+
+    match = re.match(r"^(.+)\+0x[0-9a-fA-F]+/0x[0-9a-fA-F]+$", token)
+    if match:
+        return match.group(1)
+
+    try:
+        addr = int(token, 16)
+    except ValueError:
+        return token
+
+    # Every frame of an allocation backtrace is a return address, which may
+    # already be the first instruction of the next function.
+
+    name = symbols.lookup(addr - 1)
+    if name is None:
+        return "0x%x" % addr
+    return name
+
+
+def parse_memprofile(lines, symbols):
+
+    totals = {}
+    history = []
+    sites = []
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+
+        if fields[0] == "#":
+            # "# time T allocs A frees F live L dropped D"
+
+            if len(fields) > 2 and fields[1] == "time":
+                keys = fields[1::2]
+                values = fields[2::2]
+                totals = dict(zip(keys, [int(value) for value in values]))
+            continue
+
+        if fields[0] == "history" and len(fields) == 5:
+            history.append([int(field) for field in fields[1:]])
+        elif fields[0] == "site" and len(fields) >= 5:
+            frames = [frame_name(token, symbols) for token in fields[5:]]
+            sites.append(
+                {
+                    "allocs": int(fields[1]),
+                    "frees": int(fields[2]),
+                    "bytes": int(fields[3]),
+                    "live": int(fields[4]),
+                    "frames": frames,
+                }
+            )
+
+    return totals, history, sites
+
+
+def report_totals(output, totals):
+
+    if not totals:
+        return
+
+    output.write(
+        "At %d ms: %d allocations, %d frees, %d bytes live"
+        % (
+            totals.get("time", 0),
+            totals.get("allocs", 0),
+            totals.get("frees", 0),
+            totals.get("live", 0),
+        )
+    )
+    if totals.get("dropped", 0):
+        output.write(", %d not attributed to a site" % totals["dropped"])
+    output.write("\n\n")
+
+
+def report_history(output, history):
+
+    if len(history) < 2:
+        return
+
+    # The rates are taken between consecutive samples.  An idle heap is not
+    # sampled, so the intervals may differ.
+
+    output.write(
+        "%10s %12s %12s %12s\n" % ("TIME(ms)", "ALLOCS/s", "FREES/s", "LIVE")
+    )
+    for prev, curr in zip(history, history[1:]):
+        elapsed = curr[0] - prev[0]
+        if elapsed <= 0:
+            continue
+        output.write(
+            "%10d %12.1f %12.1f %12d\n"
+            % (
+                curr[0],
+                (curr[1] - prev[1]) * 1000.0 / elapsed,
+                (curr[2] - prev[2]) * 1000.0 / elapsed,
+                curr[3],
+            )
+        )
+    output.write("\n")
+
+
+def report_sites(output, sites, key, count):
+
+    sites = sorted(sites, key=lambda site: site[key], reverse=True)
+    if count > 0:
+        sites = sites[:count]
+
+    output.write(
+        "%10s %10s %12s %12s  %s\n" % ("ALLOCS", "FREES", "BYTES", "LIVE", "CALL SITE")
+    )
+    for site in sites:
+        frames = site["frames"]
+        output.write(
+            "%10d %10d %12d %12d  %s\n"
+            % (
+                site["allocs"],
+                site["frees"],
+                site["bytes"],
+                site["live"],
+                frames[0] if frames else "(unknown)",
+            )
+        )
+        for frame in frames[1:]:
+            output.write("%47s  %s\n" % ("", frame))
+
+
+def main():
+
+    args = parse_args()
+    symbols = Symbols(args.elf)
+
+    if args.filename:
+        with open(args.filename, mode="r") as fl:
+            totals, history, sites = parse_memprofile(fl, symbols)
+    else:
+        totals, history, sites = parse_memprofile(sys.stdin, symbols)
+
+    report_totals(sys.stdout, totals)
+    if not args.no_history:
+        report_history(sys.stdout, history)
+    report_sites(sys.stdout, sites, args.sort, args.count)
+
+
+if __name__ == "__main__":
+    main()
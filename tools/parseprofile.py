@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+# tools/parseprofile.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+
+import argparse
+import bisect
+import re
+import sys
+
+
+def parse_args():
+
+    parser = argparse.ArgumentParser(
+        """
+        parseprofile.py [-e ELFFILE] [-o OUTPUT] [FILE]\n\
+        This file converts the output of /proc/profile (CONFIG_SCHED_PROFILE)
+        into folded stacks, one "frame;frame;... count" line per stack,
+        outermost frame first.  The result can be fed to flamegraph.pl or
+        any other tool that reads folded stacks.\n
+        Frames that the target already printed as symbol+offset
+        (CONFIG_ALLSYMS) are used as is; plain addresses are looked up in
+        the ELF file given with -e.
+        """
+    )
+
+    parser.add_argument(
+        "filename",
+        nargs="?",
+        help="saved output of /proc/profile, standard input by default",
+    )
+    parser.add_argument(
+        "-e",
+        "--elf",
+        action="store",
+        help="nuttx ELF file used to symbolize plain addresses",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        action="store",
+        help="output file, standard output by default",
+    )
+    parser.add_argument(
+        "--merge-cpus",
+        action="store_true",
+        help="do not start the stacks with the CPU they were sampled on",
+    )
+    parser.add_argument(
+        "--merge-threads",
+        action="store_true",
+        help="do not start the stacks with the thread they were sampled in",
+    )
+
+    return parser.parse_args()
+
+
+class Symbols(object):
+    def __init__(self, elffile):
+        self.addrs = []
+        self.names = []
+        self.sizes = []
+
+        if elffile is None:
+            return
+
+        try:
+            from elftools.elf.elffile import ELFFile
+            from elftools.elf.sections import SymbolTableSection
+        except ModuleNotFoundError:
+            print("Please execute the following command to install dependencies:")
+            print("pip install pyelftools")
+            sys.exit(1)
+
+        symbols = []
+        with open(elffile, "rb") as file:
+            elf = ELFFile(file)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                if section.name != ".symtab":
+                    continue
+                for symbol in section.iter_symbols():
+                    if symbol["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    if symbol["st_shndx"] == "SHN_UNDEF":
+                        continue
+                    symbols.append(
+                        (symbol["st_value"] & ~0x01, symbol["st_size"], symbol.name)
+                    )
+
+        for addr, size, name in sorted(symbols):
+            self.addrs.append(addr)
+            self.sizes.append(size)
+            self.names.append(name)
+
+    def lookup(self, addr):
+        index = bisect.bisect_right(self.addrs, addr) - 1
+        if index < 0:
+            return None
+        if self.sizes[index] and addr >= self.addrs[index] + self.sizes[index]:
+            return None
+        return self.names[index]
+
+
+def frame_name(token, symbols, caller):
+
+    # "name+0x12/0x40" when the target resolved the symbol
+
+    match = re.match(r"^(.+)\+0x[0-9a-fA-F]+/0x[0-9a-fA-F]+$", token)
+    if match:
+        return match.group(1)
+
+    try:
+        addr = int(token, 16)
+    except ValueError:
+        return token
+
+    # A caller is known by its return address, which may already be the
+    # first instruction of the next function.
+
+    name = symbols.lookup(addr - 1 if caller else addr)
+    if name is None:
+        return "0x%x" % addr
+    return name
+
+
+def parse_profile(lines, symbols, merge_cpus, merge_threads):
+
+    stacks = {}
+    for line in lines:
+        line = line.strip()
+        if not line or line.startswith("#"):
+            continue
+
+        fields = line.split()
+        if len(fields) < 4:
+            continue
+
+        cpu, count, pid = fields[0], int(fields[1]), fields[2]
+        frames = [
+            frame_name(token, symbols, index > 0)
+            for index, token in enumerate(fields[3:])
+        ]
+
+        frames.reverse()
+        if not merge_threads:
+            frames.insert(0, "pid " + pid)
+        if not merge_cpus:
+            frames.insert(0, "cpu" + cpu)
+
+        key = ";".join(frames)
+        stacks[key] = stacks.get(key, 0) + count
+
+    return stacks
+
+
+def main():
+
+    args = parse_args()
+    symbols = Symbols(args.elf)
+
+    if args.filename:
+        with open(args.filename, mode="r") as fl:
+            stacks = parse_profile(fl, symbols, args.merge_cpus, args.merge_threads)
+    else:
+        stacks = parse_profile(sys.stdin, symbols, args.merge_cpus, args.merge_threads)
+
+    output = open(args.output, mode="w") if args.output else sys.stdout
+    for key in sorted(stacks):
+        output.write("%s %d\n" % (key, stacks[key]))
+    if output is not sys.stdout:
+        output.close()
+
+
+if __name__ == "__main__":
+    main()